@@ -0,0 +1,92 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <array>
+
+#include "Types.hpp"
+#include "Audio/AudioConstants.hpp"
+#include "Audio/BlipBuffer.hpp"
+#include "Audio/Channels.hpp"
+#include "Core/Scheduler.hpp"
+#include "Core/SaveState.hpp"
+
+namespace GBcc
+{
+    // Nothing runs per cycle. The channels are caught up to the current
+    // cycle only when a sound register is touched, at the end of a frame,
+    // or when samples are read, and their level changes go into band-limited
+    // step buffers.
+    class APU
+    {
+        private:
+        Scheduler& m_Scheduler;
+        const u32 m_SampleRate;
+
+        u64 m_Time;
+        u64 m_FrameStart;
+        u64 m_NextSequencerClock;
+        u8 m_SequencerStep = 0U;
+
+        BlipBuffer m_Left;
+        BlipBuffer m_Right;
+
+        SquareChannel m_Square1;
+        SquareChannel m_Square2;
+        WaveChannel m_Wave;
+        NoiseChannel m_Noise;
+        std::array<ChannelOutput, GB_AUDIO_CHANNEL_COUNT> m_Outputs;
+
+        std::array<u8, GB_APU_REGS_SIZE> m_Registers;
+        bool m_Powered = true;
+
+        void Sync();
+        void RunChannels(const u64 from, const u64 to);
+        void ClockSequencer();
+        void UpdateLevels(const u64 time);
+        void UpdateMixer(const u64 time);
+        void EndBufferFrame();
+
+        void WriteSquare(SquareChannel& channel, const u8 index, const u8 data);
+        void WriteWave(const u8 index, const u8 data);
+        void WriteNoise(const u8 index, const u8 data);
+        void PowerOff();
+
+        public:
+        APU(Scheduler& scheduler, const u32 sampleRate = GB_AUDIO_DEFAULT_SAMPLE_RATE);
+        ~APU() = default;
+
+        u8 ReadRegister(const u16 address);
+        void WriteRegister(const u16 address, const u8 data);
+
+        void EndFrame();
+
+        // Off by default, when no sample buffers are allocated and nothing
+        // is synthesized. The registers and channels run either way.
+        void SetOutputEnabled(const bool enable);
+        size_t SamplesAvailable() const;
+        // Interleaved stereo, returns the number of sample pairs written
+        size_t ReadSamples(i16* out, const size_t count);
+
+        // Samples already synthesized are host-side output and not part of
+        // the state, loading continues the stream from the restored levels
+        void SaveState(StateWriter& writer) const;
+        void LoadState(StateReader& reader);
+        // Checks the ranges LoadState relies on without touching an APU
+        static bool ValidateState(StateReader& reader);
+    };
+}
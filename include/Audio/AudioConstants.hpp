@@ -0,0 +1,86 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <array>
+
+#include "Types.hpp"
+
+namespace GBcc
+{
+    constexpr u32 GB_CPU_CLOCK_HZ               = 4194304U;
+    constexpr u32 GB_AUDIO_DEFAULT_SAMPLE_RATE  = 48000U;
+
+    constexpr u16 GB_APU_REGS_BEGIN     = 0xFF10U;
+    constexpr u16 GB_APU_REGS_END       = 0xFF3FU;
+    constexpr u16 GB_WAVE_RAM_BEGIN     = 0xFF30U;
+    constexpr size_t GB_APU_REGS_SIZE   = GB_APU_REGS_END - GB_APU_REGS_BEGIN + 1U;
+    constexpr size_t GB_WAVE_RAM_SIZE   = 16U;
+
+    constexpr u16 GB_REG_NR10   = 0xFF10U;
+    constexpr u16 GB_REG_NR11   = 0xFF11U;
+    constexpr u16 GB_REG_NR12   = 0xFF12U;
+    constexpr u16 GB_REG_NR13   = 0xFF13U;
+    constexpr u16 GB_REG_NR14   = 0xFF14U;
+    constexpr u16 GB_REG_NR21   = 0xFF16U;
+    constexpr u16 GB_REG_NR22   = 0xFF17U;
+    constexpr u16 GB_REG_NR23   = 0xFF18U;
+    constexpr u16 GB_REG_NR24   = 0xFF19U;
+    constexpr u16 GB_REG_NR30   = 0xFF1AU;
+    constexpr u16 GB_REG_NR31   = 0xFF1BU;
+    constexpr u16 GB_REG_NR32   = 0xFF1CU;
+    constexpr u16 GB_REG_NR33   = 0xFF1DU;
+    constexpr u16 GB_REG_NR34   = 0xFF1EU;
+    constexpr u16 GB_REG_NR41   = 0xFF20U;
+    constexpr u16 GB_REG_NR42   = 0xFF21U;
+    constexpr u16 GB_REG_NR43   = 0xFF22U;
+    constexpr u16 GB_REG_NR44   = 0xFF23U;
+    constexpr u16 GB_REG_NR50   = 0xFF24U;
+    constexpr u16 GB_REG_NR51   = 0xFF25U;
+    constexpr u16 GB_REG_NR52   = 0xFF26U;
+
+    constexpr u8 GB_NRX4_TRIGGER        = 0b1000'0000U;
+    constexpr u8 GB_NRX4_LENGTH_ENABLE  = 0b0100'0000U;
+    constexpr u8 GB_NR30_DAC_ENABLE     = 0b1000'0000U;
+    constexpr u8 GB_NR52_POWER          = 0b1000'0000U;
+
+    // Bits that read back as 1, indexed from NR10
+    constexpr std::array<u8, 0x20U> GB_APU_READ_MASKS = {
+        0x80U, 0x3FU, 0x00U, 0xFFU, 0xBFU,
+        0xFFU, 0x3FU, 0x00U, 0xFFU, 0xBFU,
+        0x7FU, 0xFFU, 0x9FU, 0xFFU, 0xBFU,
+        0xFFU, 0xFFU, 0x00U, 0x00U, 0xBFU,
+        0x00U, 0x00U, 0x70U,
+        0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU
+    };
+
+    // Length/sweep/envelope clock, 512 Hz
+    constexpr u64 GB_FRAME_SEQUENCER_PERIOD = 8192ULL;
+
+    constexpr u16 GB_SQUARE_LENGTH_MAX  = 64U;
+    constexpr u16 GB_WAVE_LENGTH_MAX    = 256U;
+    constexpr u16 GB_FREQUENCY_MAX      = 2047U;
+
+    // One bit per duty step, 12.5%, 25%, 50% and 75%
+    constexpr std::array<u8, 4U> GB_DUTY_PATTERNS = { 0b0000'0001U, 0b1000'0001U, 0b1000'0111U, 0b0111'1110U };
+    constexpr std::array<u8, 8U> GB_NOISE_DIVISORS = { 8U, 16U, 32U, 48U, 64U, 80U, 96U, 112U };
+
+    constexpr size_t GB_AUDIO_CHANNEL_COUNT = 4U;
+
+    // Four channels at level 15 and master volume 8 on one side
+    constexpr i32 GB_AUDIO_MAX_AMPLITUDE = 4 * 15 * 8;
+}
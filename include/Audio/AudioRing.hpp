@@ -0,0 +1,101 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+
+#include "Types.hpp"
+
+namespace GBcc
+{
+    // Wait-free single-producer/single-consumer ring of interleaved stereo
+    // frames. Neither side ever blocks: a full ring takes fewer frames and an
+    // empty one returns fewer, the caller decides what to do with the rest.
+    template <size_t FRAMES>
+    class AudioRing
+    {
+        static_assert((FRAMES & (FRAMES - 1U)) == 0U, "AudioRing size must be a power of two");
+
+        private:
+        std::array<i16, FRAMES * 2U> m_Samples;
+
+        alignas(64) std::atomic<size_t> m_Head = 0;
+        alignas(64) std::atomic<size_t> m_Tail = 0;
+
+        static void Copy(const i16* from, i16* to, const size_t frames);
+
+        public:
+        size_t Write(const i16* frames, const size_t count);
+        size_t Read(i16* frames, const size_t count);
+
+        size_t Size() const;
+        static constexpr size_t Capacity();
+    };
+
+    template <size_t FRAMES>
+    void AudioRing<FRAMES>::Copy(const i16* from, i16* to, const size_t frames)
+    {
+        std::copy(from, from + frames * 2U, to);
+    }
+
+    template <size_t FRAMES>
+    size_t AudioRing<FRAMES>::Write(const i16* frames, const size_t count)
+    {
+        const size_t head = m_Head.load(std::memory_order_relaxed);
+        const size_t free = FRAMES - (head - m_Tail.load(std::memory_order_acquire));
+        const size_t written = std::min(count, free);
+
+        // At most two runs, up to the end of the array and from its start
+        const size_t start = head & (FRAMES - 1U);
+        const size_t first = std::min(written, FRAMES - start);
+        Copy(frames, m_Samples.data() + start * 2U, first);
+        Copy(frames + first * 2U, m_Samples.data(), written - first);
+
+        m_Head.store(head + written, std::memory_order_release);
+        return written;
+    }
+
+    template <size_t FRAMES>
+    size_t AudioRing<FRAMES>::Read(i16* frames, const size_t count)
+    {
+        const size_t tail = m_Tail.load(std::memory_order_relaxed);
+        const size_t available = m_Head.load(std::memory_order_acquire) - tail;
+        const size_t read = std::min(count, available);
+
+        const size_t start = tail & (FRAMES - 1U);
+        const size_t first = std::min(read, FRAMES - start);
+        Copy(m_Samples.data() + start * 2U, frames, first);
+        Copy(m_Samples.data(), frames + first * 2U, read - first);
+
+        m_Tail.store(tail + read, std::memory_order_release);
+        return read;
+    }
+
+    template <size_t FRAMES>
+    size_t AudioRing<FRAMES>::Size() const
+    {
+        return m_Head.load(std::memory_order_acquire) - m_Tail.load(std::memory_order_acquire);
+    }
+
+    template <size_t FRAMES>
+    constexpr size_t AudioRing<FRAMES>::Capacity()
+    {
+        return FRAMES;
+    }
+}
@@ -0,0 +1,85 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+
+#include "Types.hpp"
+#include "Audio/APU.hpp"
+#include "Audio/AudioRing.hpp"
+#include "Audio/RateController.hpp"
+#include "Audio/Resampler.hpp"
+
+namespace GBcc
+{
+    // Hands APU output from the emulation thread to a host audio callback.
+    // Produce() never blocks, Consume() is safe to call from the callback
+    // thread and pads underruns with the last frame played. The rate
+    // controller and the emulation speed both steer the resampler.
+    class AudioStream
+    {
+        public:
+        static constexpr size_t RING_FRAMES = 8192U;
+        static constexpr size_t CHUNK_FRAMES = 1024U;
+        static constexpr double MIN_SPEED = 0.25;
+        static constexpr double MAX_SPEED = 16.0;
+        static constexpr double MAX_RATE_DEVIATION = 0.005;
+        // Fill the rate controller steers towards, and audio sync waits for
+        static constexpr double TARGET_FILL = 0.5;
+        // Enough for a chunk stretched at the lowest speed while the rate
+        // controller asks for the most extra output, rounded up, plus the
+        // frames the taps can add
+        static constexpr size_t RESAMPLED_FRAMES = 
+            static_cast<size_t>(CHUNK_FRAMES / MIN_SPEED * (1.0 + MAX_RATE_DEVIATION)) + 1U + 4U;
+
+        private:
+
+        AudioRing<RING_FRAMES> m_Ring;
+        RateController m_RateController;
+        Resampler m_Resampler;
+        double m_Speed = 1.0;
+
+        std::array<i16, CHUNK_FRAMES * 2U> m_ProduceChunk;
+        std::array<i16, RESAMPLED_FRAMES * 2U> m_ResampledChunk;
+        std::array<i16, 2U> m_LastFrame = { 0, 0 };
+
+        std::atomic<u64> m_Underruns = 0;
+        u64 m_DroppedFrames = 0ULL;
+
+        public:
+        AudioStream();
+        ~AudioStream() = default;
+
+        // Emulation thread
+        void Produce(APU& apu);
+        void SetSpeed(const double speed);
+        u64 GetDroppedFrames() const;
+        // Blocks until the host has played the ring down to the target fill,
+        // which paces emulation by the audio clock. False if the host did
+        // not get there within the timeout.
+        bool WaitForSpace(const std::chrono::milliseconds timeout) const;
+
+        // Host audio thread
+        void Consume(i16* out, const size_t frames);
+        u64 GetUnderruns() const;
+
+        size_t GetFill() const;
+        double GetRatio() const;
+    };
+}
@@ -0,0 +1,99 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <array>
+#include <vector>
+
+#include "Types.hpp"
+
+namespace GBcc
+{
+    // Band-limited step synthesis. Amplitude changes are added as deltas at
+    // clock timestamps, each spread over a few output samples by a windowed
+    // sinc picked by the sub-sample phase. Reading integrates the deltas
+    // and removes the DC offset, so the cost scales with the number of
+    // changes rather than the clock rate.
+    class BlipBuffer
+    {
+        public:
+        static constexpr size_t PHASE_BITS  = 5U;
+        static constexpr size_t PHASES      = 1U << PHASE_BITS;
+        static constexpr size_t TAPS        = 16U;
+
+        using Kernel = std::array<std::array<float, TAPS>, PHASES>;
+
+        private:
+        static constexpr u32 FRACTION_BITS = 32U;
+
+        static const Kernel& GetKernel();
+
+        std::vector<float> m_Buffer;
+        size_t m_Capacity;
+
+        double m_ClockRate;
+        double m_SampleRate;
+
+        // Output samples per clock and the start of the current frame, both
+        // 32.32 fixed point
+        u64 m_SamplesPerClock;
+        u64 m_FrameOffset = 0ULL;
+
+        float m_Gain = 1.0f;
+        float m_Integrator = 0.0f;
+        float m_DCLevel = 0.0f;
+        float m_HighPassFactor;
+
+        void Consume(i16* out, const size_t count, const size_t stride);
+
+        public:
+        BlipBuffer(const u32 clockRate, const u32 sampleRate, const size_t capacity);
+        ~BlipBuffer() = default;
+
+        // Drops anything buffered. With no capacity nothing is allocated,
+        // deltas are ignored and no samples become available.
+        void SetCapacity(const size_t capacity);
+        void SetGain(const float gain);
+
+        inline void AddDelta(const u64 time, const float delta);
+        void EndFrame(const u64 duration);
+
+        size_t SamplesAvailable() const;
+        size_t ReadSamples(i16* out, size_t count, const size_t stride = 1U);
+        void RemoveSamples(const size_t count);
+        void Clear();
+    };
+
+    inline void BlipBuffer::AddDelta(const u64 time, const float delta)
+    {
+        const u64 position = m_FrameOffset + time * m_SamplesPerClock;
+        const size_t index = position >> FRACTION_BITS;
+
+        if (index + TAPS > m_Buffer.size()) [[unlikely]]
+        {
+            return;
+        }
+
+        const auto& taps = GetKernel()[(position >> (FRACTION_BITS - PHASE_BITS)) & (PHASES - 1U)];
+        float* const out = m_Buffer.data() + index;
+
+        for (size_t i = 0; i < TAPS; i++)
+        {
+            out[i] += taps[i] * delta;
+        }
+    }
+}
@@ -0,0 +1,181 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <array>
+
+#include "Types.hpp"
+#include "Audio/AudioConstants.hpp"
+#include "Audio/BlipBuffer.hpp"
+#include "Core/SaveState.hpp"
+
+namespace GBcc
+{
+    // Routes one channel's level changes into the stereo step buffers. The
+    // scales fold in NR50 volume and NR51 panning.
+    struct ChannelOutput
+    {
+        BlipBuffer* left = nullptr;
+        BlipBuffer* right = nullptr;
+        const u64* frameStart = nullptr;
+
+        i32 leftScale = 0;
+        i32 rightScale = 0;
+        i32 level = 0;
+
+        inline void Update(const u64 time, const i32 newLevel);
+        void SetScales(const u64 time, const i32 newLeftScale, const i32 newRightScale);
+    };
+
+    inline void ChannelOutput::Update(const u64 time, const i32 newLevel)
+    {
+        if (newLevel == level)
+        {
+            return;
+        }
+
+        const i32 delta = newLevel - level;
+        const u64 frameTime = time - *frameStart;
+        level = newLevel;
+
+        if (leftScale)
+        {
+            left->AddDelta(frameTime, static_cast<float>(delta * leftScale));
+        }
+        if (rightScale)
+        {
+            right->AddDelta(frameTime, static_cast<float>(delta * rightScale));
+        }
+    }
+
+    struct Envelope
+    {
+        u8 volume = 0U;
+        u8 period = 0U;
+        u8 timer = 0U;
+        bool increase = false;
+
+        void Trigger(const u8 nrx2);
+        void Clock();
+
+        void SaveState(StateWriter& writer) const;
+        void LoadState(StateReader& reader);
+    };
+
+    struct LengthCounter
+    {
+        u16 counter = 0U;
+        bool enabled = false;
+
+        void Load(const u16 maximum, const u8 value);
+        void Trigger(const u16 maximum);
+        // True when the counter runs out
+        bool Clock();
+
+        void SaveState(StateWriter& writer) const;
+        void LoadState(StateReader& reader);
+    };
+
+    // Channels keep the cycles left until their next waveform step in
+    // timer. Run() advances them over a span of cycles and reports every
+    // level change at its exact cycle.
+    struct SquareChannel
+    {
+        bool enabled = false;
+        bool dacEnabled = false;
+
+        u8 duty = 0U;
+        u8 dutyStep = 0U;
+        u16 frequency = 0U;
+        u64 timer = 0ULL;
+
+        Envelope envelope;
+        LengthCounter length;
+
+        bool hasSweep = false;
+        bool sweepEnabled = false;
+        bool sweepNegate = false;
+        u8 sweepPeriod = 0U;
+        u8 sweepShift = 0U;
+        u8 sweepTimer = 0U;
+        u16 shadowFrequency = 0U;
+
+        u64 GetPeriod() const;
+        i32 GetLevel() const;
+
+        void Run(ChannelOutput& output, const u64 from, const u64 to);
+        void Trigger();
+        void ClockSweep();
+        u16 CalculateSweep();
+
+        void SaveState(StateWriter& writer) const;
+        void LoadState(StateReader& reader);
+        // False when a loaded field would index or shift out of range
+        bool IsValid() const;
+    };
+
+    struct WaveChannel
+    {
+        bool enabled = false;
+        bool dacEnabled = false;
+
+        u8 volumeCode = 0U;
+        u8 position = 0U;
+        u16 frequency = 0U;
+        u64 timer = 0ULL;
+
+        LengthCounter length;
+        const u8* waveRam = nullptr;
+
+        u64 GetPeriod() const;
+        i32 GetLevel() const;
+
+        void Run(ChannelOutput& output, const u64 from, const u64 to);
+        void Trigger();
+
+        void SaveState(StateWriter& writer) const;
+        void LoadState(StateReader& reader);
+        // False when a loaded field would index or shift out of range
+        bool IsValid() const;
+    };
+
+    struct NoiseChannel
+    {
+        bool enabled = false;
+        bool dacEnabled = false;
+
+        u8 divisorCode = 0U;
+        u8 clockShift = 0U;
+        bool narrow = false;
+        u16 lfsr = 0x7FFFU;
+        u64 timer = 0ULL;
+
+        Envelope envelope;
+        LengthCounter length;
+
+        u64 GetPeriod() const;
+        i32 GetLevel() const;
+
+        void Run(ChannelOutput& output, const u64 from, const u64 to);
+        void Trigger();
+
+        void SaveState(StateWriter& writer) const;
+        void LoadState(StateReader& reader);
+        // False when a loaded field would index or shift out of range
+        bool IsValid() const;
+    };
+}
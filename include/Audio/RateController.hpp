@@ -0,0 +1,42 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include "Types.hpp"
+
+namespace GBcc
+{
+    // Dynamic rate control: the producer's output rate is scaled by a small
+    // ratio around 1 that pulls the buffer fill towards its target, so a
+    // host clock slightly off from ours neither underruns nor piles up
+    // latency.
+    class RateController
+    {
+        private:
+        double m_MaxDeviation;
+        double m_TargetFill;
+        double m_SmoothedFill;
+        double m_Ratio = 1.0;
+
+        public:
+        RateController(const double maxDeviation = 0.005, const double targetFill = 0.5);
+        ~RateController() = default;
+
+        double Update(const size_t fill, const size_t capacity);
+        double GetRatio() const;
+    };
+}
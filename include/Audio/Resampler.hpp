@@ -0,0 +1,69 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <vector>
+
+#include "Types.hpp"
+
+namespace GBcc
+{
+    enum class ResamplerPath : u8
+    {
+        SCALAR  = 0,
+        SSE     = 1,
+        AVX     = 2
+    };
+
+    // Cubic Hermite resampler for interleaved stereo, processed in blocks
+    // with an arbitrary fractional ratio. The widest SIMD path the CPU
+    // supports is picked at construction.
+    class Resampler
+    {
+        private:
+        static constexpr u32 FRACTION_BITS = 32U;
+        // Taps before and after the interpolated position
+        static constexpr size_t HISTORY_FRAMES = 3U;
+
+        std::vector<float> m_Input;
+        size_t m_InputFrames = HISTORY_FRAMES;
+
+        // Input frames per output frame and the read position, 32.32 fixed
+        // point relative to the second frame of m_Input
+        u64 m_Step = 1ULL << FRACTION_BITS;
+        u64 m_Position = 0ULL;
+
+        ResamplerPath m_Path;
+
+        void ConvertInput(const i16* in, const size_t frames);
+        size_t RunScalar(i16* out, const size_t maxFrames);
+        size_t RunSSE(i16* out, const size_t maxFrames);
+        size_t RunAVX(i16* out, const size_t maxFrames);
+
+        public:
+        Resampler(const size_t maxInputFrames);
+        ~Resampler() = default;
+
+        void SetRatio(const double inputPerOutput);
+        void SetPath(const ResamplerPath path);
+        ResamplerPath GetPath() const;
+        static ResamplerPath GetBestPath();
+
+        // Consumes all input, out must hold in / ratio + 2 frames
+        size_t Process(const i16* in, const size_t inFrames, i16* out, const size_t maxOutFrames);
+    };
+}
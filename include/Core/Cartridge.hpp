@@ -0,0 +1,57 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <array>
+#include <memory>
+#include <string>
+
+#include "Types.hpp"
+#include "Core/MemoryConstants.hpp"
+
+namespace GBcc
+{
+    // A ROM image, never written after it is built. Machines running the
+    // same game hold the same image instead of a copy each.
+    class Cartridge
+    {
+        private:
+        std::array<u8, GB_ROM_SIZE> m_Rom;
+        u64 m_Hash;
+
+        public:
+        // Zero filled
+        Cartridge();
+        ~Cartridge() = default;
+
+        // Returns nullptr for an empty image or one larger than 32K
+        static std::shared_ptr<const Cartridge> FromBytes(const u8* const data, const size_t size);
+        // Returns nullptr if the file cannot be read, larger files are cut
+        // to their first 32K
+        static std::shared_ptr<const Cartridge> FromFile(const std::string& path);
+        // One empty image for every machine without a game
+        static const std::shared_ptr<const Cartridge>& Empty();
+
+        inline const u8* GetData() const;
+        u64 GetHash() const;
+    };
+
+    inline const u8* Cartridge::GetData() const
+    {
+        return m_Rom.data();
+    }
+}
@@ -0,0 +1,33 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include "Types.hpp"
+
+namespace GBcc
+{
+    constexpr u8 GB_INTERRUPT_VBLANK    = 0b0000'0001U;
+    constexpr u8 GB_INTERRUPT_STAT      = 0b0000'0010U;
+    constexpr u8 GB_INTERRUPT_TIMER     = 0b0000'0100U;
+    constexpr u8 GB_INTERRUPT_SERIAL    = 0b0000'1000U;
+    constexpr u8 GB_INTERRUPT_JOYPAD    = 0b0001'0000U;
+    constexpr u8 GB_INTERRUPT_MASK      = 0b0001'1111U;
+
+    constexpr u16 GB_INTERRUPT_VECTOR_BASE      = 0x0040U;
+    constexpr u16 GB_INTERRUPT_VECTOR_STRIDE    = 0x0008U;
+    constexpr u64 GB_INTERRUPT_DISPATCH_CYCLES  = 20ULL;
+}
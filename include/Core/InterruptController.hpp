@@ -0,0 +1,82 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include "Types.hpp"
+#include "Core/InterruptConstants.hpp"
+#include "Core/SaveState.hpp"
+
+namespace GBcc
+{
+    // IF, IE and IME. Devices raise their line through Request(). The CPU
+    // only looks further when NeedsService() is set, which is kept up to
+    // date on every change instead of reading IE and IF per instruction.
+    class InterruptController
+    {
+        private:
+        u8 m_IF = 0x01U;
+        u8 m_IE = 0x00U;
+        u8 m_Pending = 0x00U;
+
+        bool m_IME = false;
+        u8 m_EnableDelay = 0U;
+        bool m_Halted = false;
+
+        bool m_NeedsService = false;
+
+        void UpdateCache();
+
+        public:
+        InterruptController() = default;
+        ~InterruptController() = default;
+
+        u8 ReadFlags() const;
+        void WriteFlags(const u8 data);
+
+        u8 ReadEnable() const;
+        void WriteEnable(const u8 data);
+
+        void Request(const u8 interrupt);
+
+        void EnableMaster(const bool delayed);
+        void DisableMaster();
+        bool MasterEnabled() const;
+        void StepEnableDelay();
+
+        void Halt();
+        void Wake();
+        bool IsHalted() const;
+
+        u16 Acknowledge();
+
+        void SaveState(StateWriter& writer) const;
+        void LoadState(StateReader& reader);
+
+        inline bool NeedsService() const;
+        inline u8 GetPending() const;
+    };
+
+    inline bool InterruptController::NeedsService() const
+    {
+        return m_NeedsService;
+    }
+
+    inline u8 InterruptController::GetPending() const
+    {
+        return m_Pending;
+    }
+}
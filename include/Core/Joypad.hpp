@@ -0,0 +1,53 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include "Types.hpp"
+#include "Core/JoypadConstants.hpp"
+#include "Core/InterruptController.hpp"
+#include "Core/SaveState.hpp"
+
+namespace GBcc
+{
+    // P1 register. The host sets the pressed buttons once per frame, the
+    // game reads them back through the group it has selected.
+    class Joypad
+    {
+        private:
+        InterruptController& m_Interrupts;
+
+        // Both groups selected after the boot ROM, P1 reads 0xCF
+        u8 m_Select = 0x00U;
+        u8 m_Pressed = 0x00U;
+
+        u8 GetLines() const;
+        void UpdateLines(const u8 previousLines);
+
+        public:
+        Joypad(InterruptController& interrupts);
+        ~Joypad() = default;
+
+        u8 ReadRegister() const;
+        void WriteRegister(const u8 data);
+
+        void SetButtons(const u8 pressed);
+        u8 GetButtons() const;
+
+        void SaveState(StateWriter& writer) const;
+        void LoadState(StateReader& reader);
+    };
+}
@@ -0,0 +1,45 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include "Types.hpp"
+
+namespace GBcc
+{
+    constexpr u16 GB_REG_P1 = 0xFF00U;
+
+    // Writing a 0 to a select bit connects that group to the low nibble
+    constexpr u8 GB_P1_SELECT_DPAD      = 0b0001'0000U;
+    constexpr u8 GB_P1_SELECT_BUTTONS   = 0b0010'0000U;
+    constexpr u8 GB_P1_SELECT_MASK      = 0b0011'0000U;
+    constexpr u8 GB_P1_LINES_MASK       = 0b0000'1111U;
+    constexpr u8 GB_P1_UNUSED           = 0b1100'0000U;
+
+    // One bit per button, set while pressed. The d-pad is the low nibble
+    // and the buttons the high one, in the order of the P1 lines.
+    enum JoypadButton : u8
+    {
+        JOYPAD_RIGHT    = 0b0000'0001U,
+        JOYPAD_LEFT     = 0b0000'0010U,
+        JOYPAD_UP       = 0b0000'0100U,
+        JOYPAD_DOWN     = 0b0000'1000U,
+        JOYPAD_A        = 0b0001'0000U,
+        JOYPAD_B        = 0b0010'0000U,
+        JOYPAD_SELECT   = 0b0100'0000U,
+        JOYPAD_START    = 0b1000'0000U
+    };
+}
@@ -0,0 +1,124 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "Core/System.hpp"
+#include "Types.hpp"
+
+namespace GBcc
+{
+    enum class LockstepPath : u8
+    {
+        BASELINE    = 0,
+        AVX2        = 1,
+        AVX512      = 2
+    };
+
+    struct LockstepStats
+    {
+        // Instructions run as one loop over every lane, run for a group of
+        // lanes sharing an opcode, and handed to a lane's own Sharp
+        u64 uniform = 0ULL;
+        u64 grouped = 0ULL;
+        u64 fallback = 0ULL;
+    };
+
+    // Experimental. Runs many copies of one ROM in lockstep, with the CPU
+    // registers of all lanes kept in structure-of-arrays form. Each step
+    // groups the lanes by the opcode at their PC. When every lane has the
+    // same register-only instruction it runs as one loop over all lanes,
+    // compiled for the widest vector unit the CPU has. Otherwise each group
+    // runs on its own. Anything touching more than registers, ROM, WRAM and
+    // HRAM, as well as interrupts and scheduled events, goes to the lane's
+    // own System.
+    class Lockstep
+    {
+        private:
+        // Register rows in opcode operand order, F takes the (HL) slot
+        static constexpr size_t REG_B = 0U;
+        static constexpr size_t REG_C = 1U;
+        static constexpr size_t REG_D = 2U;
+        static constexpr size_t REG_E = 3U;
+        static constexpr size_t REG_H = 4U;
+        static constexpr size_t REG_L = 5U;
+        static constexpr size_t REG_F = 6U;
+        static constexpr size_t REG_A = 7U;
+
+        std::vector<std::unique_ptr<System>> m_Lanes;
+
+        // Rows are padded to whole cache lines
+        size_t m_Stride;
+        std::vector<u8> m_Registers;
+        std::vector<u16> m_SP;
+        std::vector<u16> m_PC;
+        std::vector<u64> m_Cycles;
+
+        // Every lane holds the same Cartridge, writes only reach WRAM/HRAM
+        const u8* m_pRom;
+        std::vector<u8*> m_WorkRam;
+        std::vector<u8*> m_HighRam;
+
+        std::vector<u32> m_Active;
+        std::vector<u32> m_Fallback;
+        std::array<std::vector<u32>, 256U> m_Groups;
+        std::vector<u8> m_UsedOpcodes;
+
+        LockstepPath m_Path;
+        LockstepStats m_Stats;
+
+        inline u8* Row(const size_t reg);
+        void LoadLane(const u32 lane);
+        void StoreLane(const u32 lane);
+
+        const u8* Readable(const u32 lane, const u16 address) const;
+        u8* Writable(const u32 lane, const u16 address) const;
+
+        void Step();
+        template <typename Lanes>
+        void RunRegisterOp(const u8 opcode, const Lanes& lanes);
+        bool RunMemoryOp(const u8 opcode, const u32 lane);
+        void RunUniform(const u8 opcode);
+        void RunUniformAVX2(const u8 opcode);
+        void RunUniformAVX512(const u8 opcode);
+
+        public:
+        Lockstep(const size_t laneCount);
+        ~Lockstep() = default;
+
+        // Every lane runs one shared copy of the image, see System::LoadRom()
+        bool LoadRom(const u8* const data, const size_t size);
+
+        size_t GetLaneCount() const;
+        System& GetLane(const size_t lane);
+
+        // Same result on every lane as System::RunFrame()
+        void RunFrame();
+
+        void SetPath(const LockstepPath path);
+        LockstepPath GetPath() const;
+        static LockstepPath GetBestPath();
+
+        // Whether every lane runs the opcode in its own loop, without Sharp
+        static bool IsRegisterOpcode(const u8 opcode);
+
+        const LockstepStats& GetStats() const;
+    };
+}
@@ -16,35 +16,79 @@
 * along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include <array>
+#include <memory>
+#include <span>
+#include <string>
 
 #include "Types.hpp"
 #include "MemoryConstants.hpp"
+#include "Core/PPU/PPU.hpp"
+#include "Core/InterruptController.hpp"
+#include "Core/Timer.hpp"
+#include "Core/Joypad.hpp"
+#include "Audio/APU.hpp"
+#include "Core/SaveState.hpp"
+#include "Core/Cartridge.hpp"
 
 namespace GBcc {
     class Memory
     {
         private:
-        std::array<u8, GB_BOOTROM_SIZE> m_BootRom;
-        std::array<u8, 32U * 1024U> m_Rom;
+        // Shared with every machine running the same game
+        std::shared_ptr<const Cartridge> m_pCartridge;
+        const u8* m_pRom;
 
         std::array<u8, 8U * 1024U> m_WorkRam;
         std::array<u8, 127U> m_HighRam;
 
-        std::array<u8, 8U * 1024U> m_VideoRam; // Temporary
         std::array<u8, 128U> m_IO_Ram; // Temporary
 
         bool m_BootRomEnable = true;
 
         std::array<u8, 2U> m_SerialRegs;
+        // Bytes sent over serial are kept here, or printed to stdout when
+        // capture is off
+        bool m_CaptureSerial = true;
+        std::string m_SerialOutput;
+
+        PPU* const m_pPPU;
+        Timer* const m_pTimer;
+        APU* const m_pAPU;
+        InterruptController* const m_pInterrupts;
+        Joypad* const m_pJoypad;
+
+        void TransferOAM(const u8 sourcePage);
 
         public:
-        Memory();
+        Memory(PPU* const pPPU, Timer* const pTimer, APU* const pAPU, InterruptController* const pInterrupts, Joypad* const pJoypad);
         ~Memory() = default;
 
+        // Fails on an unreadable file, an empty image or one larger than 32K
+        bool LoadRom(const std::string& path);
+        bool LoadRom(const u8* const data, const size_t size);
+        void LoadCartridge(const std::shared_ptr<const Cartridge>& pCartridge);
+        const std::shared_ptr<const Cartridge>& GetCartridge() const;
+        u64 GetRomHash() const;
+
+        // A view of WRAM or HRAM, empty unless the range lies inside one
+        std::span<const u8> GetView(const u16 address, const u16 size) const;
+
+        // Direct access for Lockstep, which reads the ROM from the Cartridge
+        u8* GetWorkRam();
+        u8* GetHighRam();
+
+        void SetSerialCapture(const bool capture);
+        const std::string& GetSerialOutput() const;
+        void ClearSerialOutput();
+
         void WriteWord(const u16 address, const u8 data);
         void WriteDoubleWord(const u16 address, const u16 data);
 
         u8 ReadWord(const u16 address);
         u16 ReadDoubleWord(const u16 address);
+
+        // RAM and IO only, the cartridge is a plain 32K ROM with no mapper
+        void SaveState(StateWriter& writer) const;
+        void LoadState(StateReader& reader);
     };
 }
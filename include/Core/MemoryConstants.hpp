@@ -20,7 +20,19 @@
 
 namespace GBcc
 {
-    constexpr size_t GB_BOOTROM_SIZE        = 256ULL;
-    constexpr size_t GB_BOOTROM_END         = GB_BOOTROM_SIZE - 1U;
+    constexpr size_t GB_ROM_SIZE            = 32ULL * 1024ULL;
     constexpr u16    GB_CART_SPACE_END      = 0x7FFFULL;
+
+    constexpr const char* GB_DEFAULT_ROM_PATH   = "../roms/cpu_instrs/individual/10-bit ops.gb";
+
+    constexpr u16    GB_INTERRUPT_FLAG_REGISTER     = 0xFF0FU;
+    constexpr u16    GB_INTERRUPT_ENABLE_REGISTER   = 0xFFFFU;
+
+    constexpr u16    GB_VRAM_BEGIN          = 0x8000U;
+    constexpr u16    GB_VRAM_END            = 0x9FFFU;
+    constexpr u16    GB_OAM_BEGIN           = 0xFE00U;
+    constexpr u16    GB_OAM_END             = 0xFE9FU;
+    constexpr u16    GB_PPU_REGS_BEGIN      = 0xFF40U;
+    constexpr u16    GB_PPU_REGS_END        = 0xFF4BU;
+    constexpr u16    GB_OAM_DMA_REGISTER    = 0xFF46U;
 }
\ No newline at end of file
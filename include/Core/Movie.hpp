@@ -0,0 +1,71 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <string>
+#include <vector>
+
+#include "Types.hpp"
+
+namespace GBcc
+{
+    constexpr u32 GB_MOVIE_MAGIC    = 0x4D434247U; // "GBCM"
+    constexpr u16 GB_MOVIE_VERSION  = 1U;
+
+    // Joypad input per frame, starting either at power-on or from an
+    // embedded save state, tied to the ROM it was recorded with. On disk
+    // the inputs are stored as runs, a button byte and a u16 length.
+    class Movie
+    {
+        private:
+        u64 m_RomHash = 0ULL;
+        std::vector<u8> m_StartState;
+        std::vector<u8> m_Inputs;
+
+        public:
+        Movie() = default;
+        ~Movie() = default;
+
+        // An empty state starts at power-on
+        void Begin(const u64 romHash, const u8* state, const size_t stateSize);
+        inline void RecordFrame(const u8 buttons);
+
+        inline size_t GetFrameCount() const;
+        inline u8 GetInput(const size_t frame) const;
+        u64 GetRomHash() const;
+        bool StartsAtPowerOn() const;
+        const std::vector<u8>& GetStartState() const;
+
+        bool Save(const std::string& path) const;
+        bool Load(const std::string& path);
+    };
+
+    inline void Movie::RecordFrame(const u8 buttons)
+    {
+        m_Inputs.push_back(buttons);
+    }
+
+    inline size_t Movie::GetFrameCount() const
+    {
+        return m_Inputs.size();
+    }
+
+    inline u8 Movie::GetInput(const size_t frame) const
+    {
+        return m_Inputs[frame];
+    }
+}
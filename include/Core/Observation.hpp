@@ -0,0 +1,66 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <span>
+
+#include "Types.hpp"
+#include "Core/PPU/PPU.hpp"
+
+namespace GBcc
+{
+    enum class ObservationFormat : u8
+    {
+        NONE            = 0,
+        // 160x144, one byte per pixel, white is 255
+        GRAYSCALE       = 1,
+        // 80x72, each pixel the rounded mean of a 2x2 block of the above
+        GRAYSCALE_HALF  = 2
+    };
+
+    enum class ObservationPath : u8
+    {
+        SCALAR  = 0,
+        SSE2    = 1,
+        AVX2    = 2
+    };
+
+    // Turns the shade framebuffer into what an agent is trained on, in a
+    // single pass over the frame. All paths give identical bytes.
+    class ObservationEncoder
+    {
+        private:
+        ObservationPath m_Path;
+
+        void EncodeScalar(const ObservationFormat format, const u8* const frame, u8* const out);
+        void EncodeSSE2(const ObservationFormat format, const u8* const frame, u8* const out);
+        void EncodeAVX2(const ObservationFormat format, const u8* const frame, u8* const out);
+
+        public:
+        ObservationEncoder();
+        ~ObservationEncoder() = default;
+
+        static size_t GetSize(const ObservationFormat format);
+
+        void SetPath(const ObservationPath path);
+        ObservationPath GetPath() const;
+        static ObservationPath GetBestPath();
+
+        // Returns false if out is smaller than GetSize(format)
+        bool Encode(const ObservationFormat format, const PPU::Framebuffer& frame, std::span<u8> out);
+    };
+}
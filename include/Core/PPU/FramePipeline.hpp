@@ -0,0 +1,82 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <array>
+#include <thread>
+
+#include "Types.hpp"
+#include "SPSCQueue.hpp"
+#include "Core/PPU/PPUConstants.hpp"
+#include "Core/PPU/SpriteIndex.hpp"
+#include "Core/PPU/RasterLog.hpp"
+#include "Core/PPU/Renderer.hpp"
+
+namespace GBcc
+{
+    // Everything the renderer reads for a span of a frame. A frame is usually a
+    // single snapshot, more only if the raster log filled up along the way.
+    struct FrameSnapshot
+    {
+        std::array<u8, GB_VRAM_SIZE> videoRam;
+        std::array<u8, GB_OAM_SIZE> oam;
+        SpriteIndex spriteIndex;
+        RasterLog rasterLog;
+
+        u32 endCycle;
+        bool endOfFrame;
+        bool stop;
+    };
+
+    // Renders frame N on a worker thread while the CPU thread emulates frame
+    // N + 1. Snapshots go in and finished frames come back over two bounded
+    // lock-free queues.
+    class FramePipeline
+    {
+        private:
+        static constexpr size_t SNAPSHOT_SLOTS = 3U;
+
+        // One more frame slot than snapshot slots, so the worker can always
+        // finish the snapshots queued behind a producer that is waiting for
+        // room (the producer drains frames before it waits).
+        static constexpr size_t FRAME_SLOTS = SNAPSHOT_SLOTS + 1U;
+
+        SPSCQueue<FrameSnapshot, SNAPSHOT_SLOTS> m_Snapshots;
+        SPSCQueue<Renderer::Framebuffer, FRAME_SLOTS> m_Frames;
+
+        Renderer m_Renderer;
+        Renderer::Framebuffer m_WorkFramebuffer;
+
+        std::thread m_Worker;
+
+        void WorkerLoop();
+
+        public:
+        FramePipeline(const RasterRegisters& registers);
+        ~FramePipeline();
+
+        FramePipeline(FramePipeline const&) = delete;
+        void operator=(FramePipeline const&) = delete;
+
+        FrameSnapshot* BeginSubmit(Renderer::Framebuffer& output);
+        void Submit();
+
+        void CollectFrames(Renderer::Framebuffer& output);
+
+        const RasterRegisters& Stop(Renderer::Framebuffer& output);
+    };
+}
@@ -0,0 +1,116 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <array>
+#include <memory>
+
+#include "Types.hpp"
+#include "Core/PPU/PPUConstants.hpp"
+#include "Core/PPU/SpriteIndex.hpp"
+#include "Core/PPU/RasterLog.hpp"
+#include "Core/PPU/Renderer.hpp"
+#include "Core/Scheduler.hpp"
+#include "Core/InterruptController.hpp"
+#include "Core/SaveState.hpp"
+
+namespace GBcc
+{
+    class FramePipeline;
+
+    class PPU
+    {
+        public:
+        using Framebuffer = Renderer::Framebuffer;
+
+        private:
+        std::array<u8, GB_VRAM_SIZE> m_VideoRam;
+        std::array<u8, GB_OAM_SIZE> m_OAM;
+
+        SpriteIndex m_SpriteIndex;
+
+        Scheduler& m_Scheduler;
+        InterruptController& m_Interrupts;
+        u64 m_FrameStart = 0ULL;
+
+        u8 m_LY = 0x00U;
+        PPUMode m_Mode = PPU_MODE_OAM_SCAN;
+        bool m_StatLine = false;
+
+        // Live values seen by the CPU. The renderer holds the values it has
+        // replayed up to, writes in between are kept in the log, tagged with
+        // their cycle within the frame.
+        RasterRegisters m_Registers = { 0x91U, 0x00U, 0x00U, 0xFCU, 0xFFU, 0xFFU, 0x00U, 0x00U };
+        RasterLog m_RasterLog;
+
+        Renderer m_Renderer;
+        std::unique_ptr<FramePipeline> m_pPipeline;
+
+        u8 m_STAT = 0x80U;
+        u8 m_LYC  = 0x00U;
+        u8 m_DMA  = 0xFFU;
+
+        Framebuffer m_Framebuffer;
+
+        // Set when VRAM, OAM or a raster register changes value. A frame with
+        // no such change renders exactly like the previous one and is skipped.
+        bool m_InputsChanged = true;
+        bool m_FrameChanged = true;
+        u64 m_FrameHash = 0ULL;
+
+        u32 GetFrameCycle() const;
+        bool LCDEnabled() const;
+
+        void WriteLCDC(const u8 data);
+        void UpdateStatLine();
+
+        void WriteRasterRegister(const RasterRegister reg, const u8 data);
+        void FlushRasterLog(const u32 endCycle, const bool endOfFrame);
+        // Renders what is left of the frame, if anything changed since the last
+        void RenderFrame();
+
+        public:
+        PPU(Scheduler& scheduler, InterruptController& interrupts);
+        ~PPU();
+
+        u8 ReadVideoRam(const u16 address) const;
+        void WriteVideoRam(const u16 address, const u8 data);
+
+        u8 ReadOAM(const u16 address) const;
+        void WriteOAM(const u16 address, const u8 data);
+        void TransferOAM(const std::array<u8, GB_OAM_SIZE>& data);
+
+        u8 ReadRegister(const u16 address) const;
+        void WriteRegister(const u16 address, const u8 data);
+
+        void HandleModeEvent(const u64 timestamp);
+        void EndFrame();
+        u64 GetFrameStart() const;
+
+        void SetPipelined(const bool enable);
+
+        // With pipelined rendering a state is only valid between frames, and
+        // loading one restarts the render worker
+        void SaveState(StateWriter& writer) const;
+        void LoadState(StateReader& reader);
+        // Checks the ranges LoadState relies on without touching a PPU
+        static bool ValidateState(StateReader& reader);
+
+        const Framebuffer& GetFramebuffer() const;
+        bool FrameChanged() const;
+    };
+}
@@ -0,0 +1,100 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include "Types.hpp"
+
+namespace GBcc
+{
+    constexpr size_t GB_VRAM_SIZE               = 8U * 1024U;
+    constexpr size_t GB_OAM_SIZE                = 160U;
+    constexpr size_t GB_OAM_ENTRY_SIZE          = 4U;
+    constexpr size_t GB_OAM_ENTRY_COUNT         = GB_OAM_SIZE / GB_OAM_ENTRY_SIZE;
+    constexpr size_t GB_MAX_SPRITES_PER_LINE    = 10U;
+
+    constexpr u8 GB_OAM_Y_OFFSET        = 0U;
+    constexpr u8 GB_OAM_X_OFFSET        = 1U;
+    constexpr u8 GB_OAM_TILE_OFFSET     = 2U;
+    constexpr u8 GB_OAM_FLAGS_OFFSET    = 3U;
+
+    constexpr u8 GB_SPRITE_SCREEN_Y_OFFSET  = 16U;
+    constexpr u8 GB_SPRITE_SCREEN_X_OFFSET  = 8U;
+    constexpr u8 GB_SPRITE_HEIGHT_NORMAL    = 8U;
+    constexpr u8 GB_SPRITE_HEIGHT_TALL      = 16U;
+    constexpr u8 GB_WINDOW_X_OFFSET         = 7U;
+
+    constexpr u32 GB_CYCLES_PER_LINE        = 456U;
+    constexpr u32 GB_LINES_PER_FRAME        = 154U;
+    constexpr u32 GB_CYCLES_PER_FRAME       = GB_CYCLES_PER_LINE * GB_LINES_PER_FRAME;
+    constexpr u32 GB_OAM_SCAN_CYCLES        = 80U;
+    constexpr u32 GB_TRANSFER_CYCLES        = 172U;
+    constexpr u32 GB_HBLANK_CYCLES          = GB_CYCLES_PER_LINE - GB_OAM_SCAN_CYCLES - GB_TRANSFER_CYCLES;
+    constexpr u8  GB_VBLANK_FIRST_LINE      = 144U;
+
+    enum PPUMode : u8
+    {
+        PPU_MODE_HBLANK     = 0U,
+        PPU_MODE_VBLANK     = 1U,
+        PPU_MODE_OAM_SCAN   = 2U,
+        PPU_MODE_TRANSFER   = 3U
+    };
+
+    constexpr size_t GB_RASTER_LOG_CAPACITY = 512U;
+
+    constexpr u8 GB_TILE_SIZE           = 16U;
+    constexpr u8 GB_TILE_MAP_WIDTH      = 32U;
+
+    constexpr u16 GB_TILE_DATA_UNSIGNED_BASE    = 0x0000U;
+    constexpr u16 GB_TILE_DATA_SIGNED_BASE      = 0x1000U;
+    constexpr u16 GB_TILE_MAP_LOW_BASE          = 0x1800U;
+    constexpr u16 GB_TILE_MAP_HIGH_BASE         = 0x1C00U;
+
+    constexpr u8 GB_LCDC_BG_ENABLE      = 0b0000'0001U;
+    constexpr u8 GB_LCDC_OBJ_ENABLE     = 0b0000'0010U;
+    constexpr u8 GB_LCDC_OBJ_SIZE       = 0b0000'0100U;
+    constexpr u8 GB_LCDC_BG_MAP         = 0b0000'1000U;
+    constexpr u8 GB_LCDC_TILE_DATA      = 0b0001'0000U;
+    constexpr u8 GB_LCDC_WINDOW_ENABLE  = 0b0010'0000U;
+    constexpr u8 GB_LCDC_WINDOW_MAP     = 0b0100'0000U;
+    constexpr u8 GB_LCDC_LCD_ENABLE     = 0b1000'0000U;
+
+    constexpr u8 GB_STAT_MODE_MASK          = 0b0000'0011U;
+    constexpr u8 GB_STAT_COINCIDENCE        = 0b0000'0100U;
+    constexpr u8 GB_STAT_HBLANK_INTERRUPT   = 0b0000'1000U;
+    constexpr u8 GB_STAT_VBLANK_INTERRUPT   = 0b0001'0000U;
+    constexpr u8 GB_STAT_OAM_INTERRUPT      = 0b0010'0000U;
+    constexpr u8 GB_STAT_LYC_INTERRUPT      = 0b0100'0000U;
+    constexpr u8 GB_STAT_WRITABLE           = 0b0111'1000U;
+
+    constexpr u8 GB_OBJ_FLAG_PALETTE    = 0b0001'0000U;
+    constexpr u8 GB_OBJ_FLAG_X_FLIP     = 0b0010'0000U;
+    constexpr u8 GB_OBJ_FLAG_Y_FLIP     = 0b0100'0000U;
+    constexpr u8 GB_OBJ_FLAG_PRIORITY   = 0b1000'0000U;
+
+    constexpr u16 GB_REG_LCDC   = 0xFF40U;
+    constexpr u16 GB_REG_STAT   = 0xFF41U;
+    constexpr u16 GB_REG_SCY    = 0xFF42U;
+    constexpr u16 GB_REG_SCX    = 0xFF43U;
+    constexpr u16 GB_REG_LY     = 0xFF44U;
+    constexpr u16 GB_REG_LYC    = 0xFF45U;
+    constexpr u16 GB_REG_DMA    = 0xFF46U;
+    constexpr u16 GB_REG_BGP    = 0xFF47U;
+    constexpr u16 GB_REG_OBP0   = 0xFF48U;
+    constexpr u16 GB_REG_OBP1   = 0xFF49U;
+    constexpr u16 GB_REG_WY     = 0xFF4AU;
+    constexpr u16 GB_REG_WX     = 0xFF4BU;
+}
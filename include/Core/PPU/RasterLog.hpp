@@ -0,0 +1,96 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <array>
+
+#include "Types.hpp"
+#include "Core/PPU/PPUConstants.hpp"
+
+namespace GBcc
+{
+    // Registers the renderer samples per line. Writes to these are logged
+    // instead of forcing the PPU to render up to the write.
+    enum RasterRegister : u8
+    {
+        RASTER_LCDC = 0,
+        RASTER_SCY  = 1,
+        RASTER_SCX  = 2,
+        RASTER_BGP  = 3,
+        RASTER_OBP0 = 4,
+        RASTER_OBP1 = 5,
+        RASTER_WY   = 6,
+        RASTER_WX   = 7,
+        RASTER_REGISTER_COUNT
+    };
+
+    using RasterRegisters = std::array<u8, RASTER_REGISTER_COUNT>;
+
+    class RasterLog
+    {
+        public:
+        struct Entry
+        {
+            u32 cycle;
+            u8 reg;
+            u8 value;
+        };
+
+        // Cycles past this do not fit in a packed entry
+        static constexpr u32 CYCLE_LIMIT = 1U << 21U;
+
+        private:
+        // Packed as cycle << 11 | register << 8 | value, half the size of
+        // an Entry
+        std::array<u32, GB_RASTER_LOG_CAPACITY> m_Entries;
+        size_t m_Count = 0;
+
+        public:
+        inline bool IsFull() const;
+        inline size_t Size() const;
+        inline Entry operator[](const size_t index) const;
+
+        inline void Record(const u32 cycle, const RasterRegister reg, const u8 value);
+        inline void Clear();
+    };
+
+    inline bool RasterLog::IsFull() const
+    {
+        return m_Count == m_Entries.size();
+    }
+
+    inline size_t RasterLog::Size() const
+    {
+        return m_Count;
+    }
+
+    inline RasterLog::Entry RasterLog::operator[](const size_t index) const
+    {
+        const u32 packed = m_Entries[index];
+        return { packed >> 11U, static_cast<u8>((packed >> 8U) & 0x07U), static_cast<u8>(packed & 0xFFU) };
+    }
+
+    inline void RasterLog::Record(const u32 cycle, const RasterRegister reg, const u8 value)
+    {
+        m_Entries[m_Count++] = (cycle << 11U) | (static_cast<u32>(reg) << 8U) | value;
+    }
+
+    inline void RasterLog::Clear()
+    {
+        m_Count = 0;
+    }
+}
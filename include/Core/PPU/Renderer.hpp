@@ -0,0 +1,86 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <array>
+
+#include "Types.hpp"
+#include "Core/PPU/PPUConstants.hpp"
+#include "Core/PPU/SpriteIndex.hpp"
+#include "Core/PPU/RasterLog.hpp"
+#include "Core/SaveState.hpp"
+#include "Video/VideoConstants.hpp"
+
+namespace GBcc
+{
+    // Draws scanlines from VRAM, OAM and a raster log. It does not care whether
+    // those are the live PPU arrays or a copy handed to another thread.
+    class Renderer
+    {
+        public:
+        // One shade (0-3) per pixel, after palette lookup
+        using Framebuffer = std::array<
+            u8, 
+            VideoConstants::GAMEBOY_SCREEN_WIDTH * VideoConstants::GAMEBOY_SCREEN_HEIGHT
+        >;
+
+        struct Source
+        {
+            const u8* videoRam;
+            const u8* oam;
+            SpriteIndex* spriteIndex;
+            const RasterLog* rasterLog;
+        };
+
+        private:
+        Source m_Source = {};
+        Framebuffer* m_pTarget = nullptr;
+
+        RasterRegisters m_Registers;
+        size_t m_LogCursor = 0;
+
+        u8 m_NextLine = 0U;
+        u8 m_WindowLine = 0U;
+
+        void ApplyRasterLog(const u32 untilCycle);
+
+        void RenderScanline(const u8 line);
+        void RenderBackground(const u8 line, u8* const lineShades, u8* const lineColors);
+        void RenderSprites(const u8 line, u8* const lineShades, const u8* const lineColors);
+
+        u8 GetTilePixel(const u16 tileAddress, const u8 row, const u8 column) const;
+
+        public:
+        Renderer(const RasterRegisters& registers);
+        ~Renderer() = default;
+
+        void SetSource(const Source& source);
+        void SetTarget(Framebuffer* const pTarget);
+
+        void RenderLinesUntil(const u32 cycle);
+        void ConsumeRasterLog();
+        void BeginFrame();
+
+        const RasterRegisters& GetRegisters() const;
+        void SetRegisters(const RasterRegisters& registers);
+
+        // Only valid between raster log flushes, when the log cursor is 0
+        void SaveState(StateWriter& writer) const;
+        void LoadState(StateReader& reader);
+        static bool ValidateState(StateReader& reader);
+    };
+}
@@ -0,0 +1,69 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <array>
+
+#include "Types.hpp"
+#include "Core/PPU/PPUConstants.hpp"
+#include "Video/VideoConstants.hpp"
+
+namespace GBcc
+{
+    // Buckets the 40 OAM entries by the scanlines they cover so the renderer
+    // never has to scan OAM per line. Only Y and X affect the buckets, so the
+    // index keeps its own copy of those and rebuilds lazily after they change.
+    class SpriteIndex
+    {
+        public:
+        struct Line
+        {
+            std::array<u8, GB_MAX_SPRITES_PER_LINE> entries;
+            u8 count;
+        };
+
+        private:
+        std::array<u8, GB_OAM_ENTRY_COUNT> m_SpriteY;
+        std::array<u8, GB_OAM_ENTRY_COUNT> m_SpriteX;
+        std::array<Line, VideoConstants::GAMEBOY_SCREEN_HEIGHT> m_Lines;
+
+        u8 m_SpriteHeight = GB_SPRITE_HEIGHT_NORMAL;
+        bool m_Dirty = true;
+
+        void Rebuild();
+
+        public:
+        SpriteIndex();
+        ~SpriteIndex() = default;
+
+        void OnOamWrite(const u8 offset, const u8 data);
+        void OnOamTransfer(const std::array<u8, GB_OAM_SIZE>& oam);
+        void SetSpriteHeight(const u8 height);
+
+        inline const Line& GetLine(const u8 line);
+    };
+
+    inline const SpriteIndex::Line& SpriteIndex::GetLine(const u8 line)
+    {
+        if (m_Dirty) [[unlikely]]
+        {
+            Rebuild();
+        }
+
+        return m_Lines[line];
+    }
+}
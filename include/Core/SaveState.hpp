@@ -0,0 +1,155 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <cstring>
+#include <type_traits>
+
+#include "Types.hpp"
+
+namespace GBcc
+{
+    constexpr u32 GB_SAVE_STATE_MAGIC   = 0x53434247U; // "GBCS"
+    constexpr u16 GB_SAVE_STATE_VERSION = 2U;
+
+    // Sequential writer over a caller-owned buffer. Fields are written one
+    // by one, never as whole structs, so padding never reaches the blob and
+    // equal machines give equal bytes. With no buffer it only counts.
+    class StateWriter
+    {
+        private:
+        u8* const m_pBuffer;
+        const size_t m_Capacity;
+        size_t m_Offset = 0;
+
+        public:
+        StateWriter(u8* const pBuffer, const size_t capacity);
+
+        template <typename T>
+        inline void Write(const T value);
+        inline void WriteBytes(const void* data, const size_t size);
+        inline void WriteZeros(const size_t size);
+
+        inline size_t Size() const;
+        inline bool Overflowed() const;
+    };
+
+    class StateReader
+    {
+        private:
+        const u8* const m_pBuffer;
+        const size_t m_Size;
+        size_t m_Offset = 0;
+
+        public:
+        StateReader(const u8* const pBuffer, const size_t size);
+
+        template <typename T>
+        inline T Read();
+        inline void ReadBytes(void* data, const size_t size);
+        inline void Skip(const size_t size);
+
+        inline size_t Position() const;
+        inline bool Overflowed() const;
+    };
+
+    inline StateWriter::StateWriter(u8* const pBuffer, const size_t capacity) : 
+        m_pBuffer(pBuffer), 
+        m_Capacity(capacity) {}
+
+    template <typename T>
+    inline void StateWriter::Write(const T value)
+    {
+        static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>, "Write fields, not structs");
+        WriteBytes(&value, sizeof(T));
+    }
+
+    inline void StateWriter::WriteBytes(const void* data, const size_t size)
+    {
+        if (m_Offset + size <= m_Capacity)
+        {
+            std::memcpy(m_pBuffer + m_Offset, data, size);
+        }
+
+        m_Offset += size;
+    }
+
+    inline void StateWriter::WriteZeros(const size_t size)
+    {
+        if (m_Offset + size <= m_Capacity)
+        {
+            std::memset(m_pBuffer + m_Offset, 0, size);
+        }
+
+        m_Offset += size;
+    }
+
+    inline size_t StateWriter::Size() const
+    {
+        return m_Offset;
+    }
+
+    inline bool StateWriter::Overflowed() const
+    {
+        return m_Offset > m_Capacity;
+    }
+
+    inline StateReader::StateReader(const u8* const pBuffer, const size_t size) : 
+        m_pBuffer(pBuffer), 
+        m_Size(size) {}
+
+    template <typename T>
+    inline T StateReader::Read()
+    {
+        static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>, "Read fields, not structs");
+
+        // Any byte other than 0 or 1 in a bool is undefined behaviour
+        if constexpr (std::is_same_v<T, bool>)
+        {
+            return Read<u8>() != 0U;
+        }
+
+        T value{};
+        ReadBytes(&value, sizeof(T));
+        return value;
+    }
+
+    inline void StateReader::ReadBytes(void* data, const size_t size)
+    {
+        if (m_Offset + size <= m_Size)
+        {
+            std::memcpy(data, m_pBuffer + m_Offset, size);
+        }
+
+        m_Offset += size;
+    }
+
+    inline void StateReader::Skip(const size_t size)
+    {
+        m_Offset += size;
+    }
+
+    inline size_t StateReader::Position() const
+    {
+        return m_Offset;
+    }
+
+    inline bool StateReader::Overflowed() const
+    {
+        return m_Offset > m_Size;
+    }
+}
@@ -0,0 +1,92 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <array>
+
+#include "Types.hpp"
+#include "Core/SaveState.hpp"
+
+namespace GBcc
+{
+    enum class SchedulerEvent : u8
+    {
+        FRAME_END       = 0,
+        PPU_MODE        = 1,
+        TIMER_OVERFLOW  = 2,
+        EVENT_COUNT
+    };
+
+    // Min-heap of cycle timestamps, at most one pending entry per event type.
+    // The CPU runs until NextDeadline() and only then are events dispatched.
+    class Scheduler
+    {
+        private:
+        static constexpr size_t EVENT_COUNT = static_cast<size_t>(SchedulerEvent::EVENT_COUNT);
+        static constexpr u8 NOT_SCHEDULED = 0xFFU;
+
+        struct Event
+        {
+            u64 timestamp;
+            SchedulerEvent type;
+        };
+
+        const u64& m_Clock;
+
+        std::array<Event, EVENT_COUNT> m_Heap;
+        std::array<u8, EVENT_COUNT> m_HeapPosition;
+        size_t m_Size = 0;
+
+        u64 m_NextDeadline = UINT64_MAX;
+
+        void Place(const size_t position, const Event& event);
+        void SiftUp(size_t position);
+        void SiftDown(size_t position);
+        void RemoveAt(const size_t position);
+
+        // Parses a saved heap, false unless Schedule() could have built it
+        static bool ReadState(StateReader& reader, std::array<Event, EVENT_COUNT>& heap, size_t& size);
+
+        public:
+        Scheduler(const u64& clock);
+        ~Scheduler() = default;
+
+        inline u64 Now() const;
+        inline const u64& NextDeadline() const;
+
+        void Schedule(const SchedulerEvent type, const u64 timestamp);
+        void Deschedule(const SchedulerEvent type);
+        bool IsScheduled(const SchedulerEvent type) const;
+
+        bool PopDue(SchedulerEvent& type, u64& timestamp);
+
+        void SaveState(StateWriter& writer) const;
+        // Returns false and keeps the current events if the state is invalid
+        bool LoadState(StateReader& reader);
+        static bool ValidateState(StateReader& reader);
+    };
+
+    inline u64 Scheduler::Now() const
+    {
+        return m_Clock;
+    }
+
+    inline const u64& Scheduler::NextDeadline() const
+    {
+        return m_NextDeadline;
+    }
+}
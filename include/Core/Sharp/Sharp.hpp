@@ -20,9 +20,13 @@
 #include "Types.hpp"
 #include "Core/Sharp/SharpRegister.hpp"
 #include "Core/Sharp/SharpConstants.hpp"
+#include "Core/Sharp/SharpALU.hpp"
+#include "Core/SaveState.hpp"
 
 #include <iostream>
 #include <fstream>
+#include <memory>
+#include <string>
 
 namespace GBcc
 {
@@ -42,6 +46,17 @@ namespace GBcc
     };
     
     class Memory;
+    class InterruptController;
+
+    // Plain copy of the CPU state, for code that runs instructions outside
+    // of Sharp
+    struct SharpRegisterFile
+    {
+        u8 a, f, b, c, d, e, h, l;
+        u16 sp;
+        u16 pc;
+        u64 cycles;
+    };
 
     class Sharp
     {
@@ -75,10 +90,16 @@ namespace GBcc
         } m_Operand;
 
         Memory* const m_pMemBus;
+        InterruptController* const m_pInterrupts;
 
         u64 m_CyclesTaken = 0ULL;
+        // Not part of the state, only for throughput reports
+        u64 m_InstructionCount = 0ULL;
+        const u64* m_pIdleDeadline = nullptr;
 
-        std::ofstream m_ExecLog;
+        // Only allocated while logging, a stream is larger than the registers
+        std::unique_ptr<std::ofstream> m_pExecLog;
+        bool m_LogExecution = false;
 
         void FetchWord();
         void FetchDoubleWord();
@@ -156,6 +177,8 @@ namespace GBcc
         u8 SetBit(const u8 index, const u8 value);
 
         void ExecuteOpcode(const u8 opcode);
+        bool ServiceInterrupts();
+        void IdleUntilDeadline();
 
         void DecodeBlock0(const u8 opcode);
         void DecodeBlock1(const u8 opcode);
@@ -178,13 +201,22 @@ namespace GBcc
         void DumpRegs();
         
         public:
-        Sharp(Memory* const pMemBus);
-        ~Sharp()
-        {
-            m_ExecLog.close();
-        }
+        Sharp(Memory* const pMemBus, InterruptController* const pInterrupts);
+        ~Sharp() = default;
 
         u64 Step();
+
+        const u64& GetCyclesTaken() const;
+        u64 GetInstructionCount() const;
+        void SetIdleDeadline(const u64* pDeadline);
+        // An empty path closes the log
+        void SetExecLog(const std::string& path);
+
+        SharpRegisterFile GetRegisterFile() const;
+        void SetRegisterFile(const SharpRegisterFile& registers);
+
+        void SaveState(StateWriter& writer) const;
+        void LoadState(StateReader& reader);
     };
 
     template <typename T>
@@ -229,19 +261,12 @@ namespace GBcc
     {
         if (conditionCode < 0) return true;
 
-        switch (conditionCode)
+        if (conditionCode > GB_CPU_MAX_COND_CODE)
         {
-            case GB_CPU_CONDITION_NZ:
-                return !FlagIsSet(SharpFlags::ZERO);
-            case GB_CPU_CONDITION_Z:
-                return FlagIsSet(SharpFlags::ZERO);
-            case GB_CPU_CONDITION_NC:
-                return !FlagIsSet(SharpFlags::CARRY);
-            case GB_CPU_CONDITION_C:
-                return FlagIsSet(SharpFlags::CARRY);
-            default:
-                std::cerr << "Invalid condition code, cannot evaluate instruction condtion! Got: " << (i16) conditionCode << std::endl;
-                exit(1);
+            std::cerr << "Invalid condition code, cannot evaluate instruction condtion! Got: " << (i16) conditionCode << std::endl;
+            exit(1);
         }
+
+        return SharpALU::Condition(m_F.GetValue(), conditionCode);
     }
 };
\ No newline at end of file
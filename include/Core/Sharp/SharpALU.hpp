@@ -0,0 +1,166 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include "Types.hpp"
+#include "Core/Sharp/SharpConstants.hpp"
+
+namespace GBcc
+{
+    // Results and flags of the register ALU on a plain F byte. Sharp and
+    // Lockstep both run their instructions through these. Like the hardware
+    // instructions, they leave the low nibble of F alone.
+    namespace SharpALU
+    {
+        constexpr u8 FLAG_ZERO      = 0x80U;
+        constexpr u8 FLAG_NOT_ADD   = 0x40U;
+        constexpr u8 FLAG_HALF      = 0x20U;
+        constexpr u8 FLAG_CARRY     = 0x10U;
+
+        inline u8 Carry(const u8 f)
+        {
+            return (f & FLAG_CARRY) ? 1U : 0U;
+        }
+
+        inline u8 ZeroFlag(const u8 result)
+        {
+            return result ? 0x00U : FLAG_ZERO;
+        }
+
+        inline bool Condition(const u8 f, const i8 code)
+        {
+            switch (code)
+            {
+                case GB_CPU_CONDITION_NZ: return !(f & FLAG_ZERO);
+                case GB_CPU_CONDITION_Z: return f & FLAG_ZERO;
+                case GB_CPU_CONDITION_NC: return !(f & FLAG_CARRY);
+                default: return f & FLAG_CARRY;
+            }
+        }
+
+        inline u8 Add(const u8 lhs, const u8 rhs, const u8 carry, u8& f)
+        {
+            const u16 result = lhs + rhs + carry;
+            const bool half = ((lhs & 0x0FU) + (rhs & 0x0FU) + carry) & 0x10U;
+            f = (f & 0x0FU) | ZeroFlag(result & 0xFFU) | (half ? FLAG_HALF : 0x00U) | ((result & 0x100U) ? FLAG_CARRY : 0x00U);
+            return static_cast<u8>(result);
+        }
+
+        inline u8 Subtract(const u8 lhs, const u8 rhs, const u8 carry, u8& f)
+        {
+            const u8 result = lhs - static_cast<u8>(rhs + carry);
+            const bool half = (lhs & 0x0FU) < (rhs & 0x0FU) || (carry && (lhs & 0x0FU) == (rhs & 0x0FU));
+            const bool borrow = lhs < rhs || (carry && lhs == rhs);
+            f = (f & 0x0FU) | ZeroFlag(result) | FLAG_NOT_ADD | (half ? FLAG_HALF : 0x00U) | (borrow ? FLAG_CARRY : 0x00U);
+            return result;
+        }
+
+        inline u8 And(const u8 lhs, const u8 rhs, u8& f)
+        {
+            const u8 result = lhs & rhs;
+            f = (f & 0x0FU) | ZeroFlag(result) | FLAG_HALF;
+            return result;
+        }
+
+        inline u8 Xor(const u8 lhs, const u8 rhs, u8& f)
+        {
+            const u8 result = lhs ^ rhs;
+            f = (f & 0x0FU) | ZeroFlag(result);
+            return result;
+        }
+
+        inline u8 Or(const u8 lhs, const u8 rhs, u8& f)
+        {
+            const u8 result = lhs | rhs;
+            f = (f & 0x0FU) | ZeroFlag(result);
+            return result;
+        }
+
+        // The eight ALU A, r operations in opcode order
+        inline void Accumulate(const u8 operation, u8& a, u8& f, const u8 value)
+        {
+            switch (operation)
+            {
+                case GB_INSTR_ADD_OPCODE: a = Add(a, value, 0U, f); return;
+                case GB_INSTR_ADC_OPCODE: a = Add(a, value, Carry(f), f); return;
+                case GB_INSTR_SUB_OPCODE: a = Subtract(a, value, 0U, f); return;
+                case GB_INSTR_SBC_OPCODE: a = Subtract(a, value, Carry(f), f); return;
+                case GB_INSTR_AND_OPCODE: a = And(a, value, f); return;
+                case GB_INSTR_XOR_OPCODE: a = Xor(a, value, f); return;
+                case GB_INSTR_OR_OPCODE: a = Or(a, value, f); return;
+                default: Subtract(a, value, 0U, f); return;
+            }
+        }
+
+        // INC and DEC r keep the carry
+        inline u8 Increment(const u8 value, u8& f)
+        {
+            const u8 result = value + 1U;
+            f = (f & (0x0FU | FLAG_CARRY)) | ZeroFlag(result) | ((value & 0x0FU) == 0x0FU ? FLAG_HALF : 0x00U);
+            return result;
+        }
+
+        inline u8 Decrement(const u8 value, u8& f)
+        {
+            const u8 result = value - 1U;
+            f = (f & (0x0FU | FLAG_CARRY)) | ZeroFlag(result) | FLAG_NOT_ADD | ((value & 0x0FU) == 0x00U ? FLAG_HALF : 0x00U);
+            return result;
+        }
+
+        // ADD HL, rr keeps the zero flag
+        inline u16 AddDouble(const u16 lhs, const u16 rhs, u8& f)
+        {
+            const u32 result = lhs + rhs;
+            const bool half = ((lhs & 0x0FFFU) + (rhs & 0x0FFFU)) & 0x1000U;
+            f = (f & (0x0FU | FLAG_ZERO)) | (half ? FLAG_HALF : 0x00U) | ((result & 0x10000U) ? FLAG_CARRY : 0x00U);
+            return static_cast<u16>(result);
+        }
+
+        // The CB rotates. RLCA, RRCA, RLA and RRA clear the zero flag after.
+        inline u8 RotateLeft(const u8 value, const bool circular, u8& f)
+        {
+            const u8 out = value >> 7U;
+            const u8 result = static_cast<u8>(value << 1U) | (circular ? out : Carry(f));
+            f = (f & 0x0FU) | ZeroFlag(result) | (out ? FLAG_CARRY : 0x00U);
+            return result;
+        }
+
+        inline u8 RotateRight(const u8 value, const bool circular, u8& f)
+        {
+            const u8 out = value & 1U;
+            const u8 result = (value >> 1U) | static_cast<u8>((circular ? out : Carry(f)) << 7U);
+            f = (f & 0x0FU) | ZeroFlag(result) | (out ? FLAG_CARRY : 0x00U);
+            return result;
+        }
+
+        inline u8 Complement(const u8 value, u8& f)
+        {
+            f |= FLAG_NOT_ADD | FLAG_HALF;
+            return ~value;
+        }
+
+        inline void SetCarry(u8& f)
+        {
+            f = (f & (0x0FU | FLAG_ZERO)) | FLAG_CARRY;
+        }
+
+        inline void ComplementCarry(u8& f)
+        {
+            f = (f & (0x0FU | FLAG_ZERO | FLAG_CARRY)) ^ FLAG_CARRY;
+        }
+    }
+}
@@ -15,8 +15,11 @@
 * You should have received a copy of the GNU General Public License
 * along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
+#pragma once
 #include "Types.hpp"
 
+#include <array>
+
 namespace GBcc
 {
     constexpr u8 GB_INSTR_BLOCK_MASK    = 0b11'00'00'00U;
@@ -98,4 +101,33 @@ namespace GBcc
     constexpr u16 GB_MMIO_BASE_ADDRESS = 0xFF00U;
 
     constexpr u8 GB_INSTR_BLOCK_STR_IMM_PTR = 1U;
+
+    // T-cycles per opcode. Branches list their not-taken cost, FlowControl adds
+    // the remainder when the branch is taken (RET and RETI included).
+    constexpr std::array<u8, 256U> GB_INSTR_CYCLES = {
+    //   x0  x1  x2  x3  x4  x5  x6  x7  x8  x9  xA  xB  xC  xD  xE  xF
+         4, 12,  8,  8,  4,  4,  8,  4, 20,  8,  8,  8,  4,  4,  8,  4, // 0x
+         4, 12,  8,  8,  4,  4,  8,  4,  8,  8,  8,  8,  4,  4,  8,  4, // 1x
+         8, 12,  8,  8,  4,  4,  8,  4,  8,  8,  8,  8,  4,  4,  8,  4, // 2x
+         8, 12,  8,  8, 12, 12, 12,  4,  8,  8,  8,  8,  4,  4,  8,  4, // 3x
+         4,  4,  4,  4,  4,  4,  8,  4,  4,  4,  4,  4,  4,  4,  8,  4, // 4x
+         4,  4,  4,  4,  4,  4,  8,  4,  4,  4,  4,  4,  4,  4,  8,  4, // 5x
+         4,  4,  4,  4,  4,  4,  8,  4,  4,  4,  4,  4,  4,  4,  8,  4, // 6x
+         8,  8,  8,  8,  8,  8,  4,  8,  4,  4,  4,  4,  4,  4,  8,  4, // 7x
+         4,  4,  4,  4,  4,  4,  8,  4,  4,  4,  4,  4,  4,  4,  8,  4, // 8x
+         4,  4,  4,  4,  4,  4,  8,  4,  4,  4,  4,  4,  4,  4,  8,  4, // 9x
+         4,  4,  4,  4,  4,  4,  8,  4,  4,  4,  4,  4,  4,  4,  8,  4, // Ax
+         4,  4,  4,  4,  4,  4,  8,  4,  4,  4,  4,  4,  4,  4,  8,  4, // Bx
+         8, 12, 12, 12, 12, 16,  8, 16,  8,  4, 12,  0, 12, 12,  8, 16, // Cx
+         8, 12, 12,  4, 12, 16,  8, 16,  8,  4, 12,  4, 12,  4,  8, 16, // Dx
+        12, 12,  8,  4,  4, 16,  8, 16, 16,  4, 16,  4,  4,  4,  8, 16, // Ex
+        12, 12,  8,  4,  4, 16,  8, 16, 12,  8, 16,  4,  4,  4,  8, 16  // Fx
+    };
+
+    constexpr std::array<u8, 8U> GB_INSTR_CB_CYCLES = {
+    //   B   C   D   E   H   L (HL)  A
+         8,  8,  8,  8,  8,  8, 16,  8
+    };
+
+    constexpr u8 GB_INSTR_CB_BIT_HL_CYCLES = 12U;
 }
\ No newline at end of file
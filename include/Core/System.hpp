@@ -16,20 +16,164 @@
 * along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 #pragma once
+#include <span>
+#include <string>
 
 #include "Core/Sharp/Sharp.hpp"
 #include "Core/Memory.hpp"
+#include "Core/PPU/PPU.hpp"
+#include "Core/Scheduler.hpp"
+#include "Core/InterruptController.hpp"
+#include "Core/Timer.hpp"
+#include "Core/Joypad.hpp"
+#include "Core/Movie.hpp"
+#include "Core/MemoryConstants.hpp"
+#include "Audio/APU.hpp"
+#include "Core/SaveState.hpp"
+#include "Core/Observation.hpp"
 
 namespace GBcc
 {
+    class System;
+
+    // Called once per environment step, after its frames have run
+    using RewardFunction = float (*)(const System& system, void* pUser);
+
+    // Spans point into the machine, or into the caller's observation buffer,
+    // and stay valid until the next step
+    struct EnvStep
+    {
+        std::span<const u8> framebuffer;
+        // Empty unless an observation format is set
+        std::span<const u8> observation;
+        std::span<const u8> workRam;
+        std::span<const u8> highRam;
+        float reward = 0.0f;
+    };
+
+    // All mutable state of a machine lives inside the System object, so one
+    // allocation holds a whole machine. Per machine that is 16K of WRAM and
+    // VRAM, the 22.5K framebuffer and about 5K of registers and render
+    // caches. The ROM is shared, see Cartridge.
+    //
+    // The target is 44K rather than 40K because the framebuffer keeps a
+    // byte per pixel. Nothing else is allocated unless asked for: audio
+    // output (APU::SetOutputEnabled, 96K of sample buffers at 48 kHz), the
+    // pipelined renderer, an exec log, or serial output while captured.
+    constexpr size_t GB_SYSTEM_SIZE_TARGET = 44U * 1024U;
+
     class System
     {
         Sharp m_CPU;
+        Scheduler m_Scheduler;
+        InterruptController m_Interrupts;
+        Joypad m_Joypad;
+        Timer m_Timer;
+        APU m_APU;
         Memory m_Memory; 
+        PPU m_PPU;
+
+        bool m_FrameDone = false;
+        size_t m_StateSize = 0;
+
+        Movie* m_pRecording = nullptr;
+        const Movie* m_pReplay = nullptr;
+        size_t m_ReplayFrame = 0;
+
+        ObservationEncoder m_ObservationEncoder;
+        ObservationFormat m_ObservationFormat = ObservationFormat::NONE;
+        std::span<u8> m_Observation;
+        RewardFunction m_pReward = nullptr;
+        void* m_pRewardUser = nullptr;
+
+        void WriteState(StateWriter& writer) const;
+        // Walks a whole state checking every field LoadState cannot take as is
+        bool ValidateState(StateReader& reader) const;
+
+        void RunUntilNextEvent();
+
         public:
+        // Starts with an empty cartridge, see LoadRom()
         System();
         ~System() = default;
 
+        // Call before running. Fails on an unreadable file, an empty image or
+        // one larger than 32K.
+        bool LoadRom(const std::string& path);
+        bool LoadRom(const u8* const data, const size_t size);
+        // Runs an image other machines may be running too, nothing is copied
+        void LoadCartridge(const std::shared_ptr<const Cartridge>& pCartridge);
+        const std::shared_ptr<const Cartridge>& GetCartridge() const;
+
         void Step();
+        void RunFrame();
+        // Stops at the first instruction boundary at or past the given cycle
+        // count, returns the cycles actually run
+        u64 RunCycles(const u64 cycles);
+        // Writes a register trace before every instruction, an empty path
+        // turns it off
+        void SetExecLog(const std::string& path);
+        void SetPipelinedRendering(const bool enable);
+
+        const PPU::Framebuffer& GetFramebuffer() const;
+        bool FrameChanged() const;
+        u64 GetCyclesTaken() const;
+        u64 GetInstructionCount() const;
+        APU& GetAPU();
+        u64 GetRomHash() const;
+
+        // Serial output is kept in memory unless capture is turned off, then
+        // it goes to stdout
+        void SetSerialCapture(const bool capture);
+        const std::string& GetSerialOutput() const;
+        void ClearSerialOutput();
+
+        // Buttons held from the next frame on, see JoypadButton
+        void SetJoypad(const u8 buttons);
+
+        // Input is taken once per frame, at the start of RunFrame(). A movie
+        // recorded on a machine that has not run yet starts at power-on,
+        // otherwise from a state of this one.
+        void StartRecording(Movie& movie);
+        void StopRecording();
+        // Fails if the movie is for another ROM, or starts at power-on and
+        // this machine has already run
+        bool StartReplay(const Movie& movie);
+        bool ReplayFinished() const;
+
+        // Environment interface for agents. Observations go to caller memory
+        // of at least ObservationEncoder::GetSize(format) bytes, false if
+        // the buffer is smaller. A step allocates nothing and copies nothing
+        // but the observation.
+        bool SetObservation(const ObservationFormat format, std::span<u8> buffer);
+        void SetObservationPath(const ObservationPath path);
+        void SetRewardFunction(const RewardFunction pReward, void* pUser);
+        // Holds the buttons for the given number of frames
+        EnvStep StepEnvironment(const u8 buttons, const u32 frames);
+        // A view of WRAM or HRAM, empty unless the range lies inside one
+        std::span<const u8> GetMemoryView(const u16 address, const u16 size) const;
+
+        // For Lockstep, which runs the instructions of many machines itself
+        // and only hands the rest back. RunFrame() is BeginFrame(), then
+        // Step() until FrameDone(). While nothing is due and no interrupt
+        // needs service, an instruction that only touches registers, ROM,
+        // WRAM and HRAM can be run outside on a copy of the registers.
+        void BeginFrame();
+        bool FrameDone() const;
+        void DispatchEvents();
+        u64 GetNextEventCycle() const;
+        bool InterruptPending() const;
+        SharpRegisterFile GetRegisterFile() const;
+        void SetRegisterFile(const SharpRegisterFile& registers);
+        Memory& GetMemory();
+
+        // States have a fixed size and layout for a given version. Both calls
+        // work on caller memory and do not allocate.
+        size_t GetStateSize() const;
+        // Returns the bytes written, 0 if the buffer is too small
+        size_t SaveState(u8* const buffer, const size_t size) const;
+        // Returns false and leaves the machine untouched if the blob is not a
+        // state of this version
+        bool LoadState(const u8* const buffer, const size_t size);
     };
 };
\ No newline at end of file
@@ -0,0 +1,68 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include "Types.hpp"
+#include "Core/TimerConstants.hpp"
+#include "Core/Scheduler.hpp"
+#include "Core/InterruptController.hpp"
+#include "Core/SaveState.hpp"
+
+namespace GBcc
+{
+    // DIV is the top byte of a 16 bit counter running at the CPU clock, and
+    // TIMA counts falling edges of one of its bits. Nothing ticks: both are
+    // derived from the clock when touched, and only the next overflow is
+    // scheduled.
+    class Timer
+    {
+        private:
+        Scheduler& m_Scheduler;
+        InterruptController& m_Interrupts;
+
+        // Counter value is clock + offset, unwrapped so edges can be counted
+        // by division
+        u64 m_CounterOffset = GB_TIMER_COUNTER_AFTER_BOOT;
+        u64 m_LastSync = 0ULL;
+
+        u8 m_TIMA = 0x00U;
+        u8 m_TMA  = 0x00U;
+        u8 m_TAC  = GB_TAC_UNUSED;
+
+        u64 GetCounter() const;
+        bool Enabled() const;
+        u8 GetClockBit() const;
+        bool GetTimerSignal() const;
+
+        void Sync();
+        void Increment(u64 edges);
+        void ScheduleOverflow();
+
+        public:
+        Timer(Scheduler& scheduler, InterruptController& interrupts);
+        ~Timer() = default;
+
+        u8 ReadRegister(const u16 address);
+        void WriteRegister(const u16 address, const u8 data);
+
+        void HandleOverflowEvent();
+
+        // The pending overflow lives in the scheduler and is restored with it
+        void SaveState(StateWriter& writer) const;
+        void LoadState(StateReader& reader);
+    };
+}
@@ -0,0 +1,41 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include "Types.hpp"
+
+namespace GBcc
+{
+    constexpr u16 GB_TIMER_REGS_BEGIN   = 0xFF04U;
+    constexpr u16 GB_TIMER_REGS_END     = 0xFF07U;
+
+    constexpr u16 GB_REG_DIV    = 0xFF04U;
+    constexpr u16 GB_REG_TIMA   = 0xFF05U;
+    constexpr u16 GB_REG_TMA    = 0xFF06U;
+    constexpr u16 GB_REG_TAC    = 0xFF07U;
+
+    constexpr u8 GB_TAC_ENABLE      = 0b0000'0100U;
+    constexpr u8 GB_TAC_CLOCK_MASK  = 0b0000'0011U;
+    constexpr u8 GB_TAC_UNUSED      = 0b1111'1000U;
+
+    // Bit of the internal counter whose falling edge clocks TIMA, by TAC
+    // clock select: 4096, 262144, 65536 and 16384 Hz
+    constexpr u8 GB_TIMER_CLOCK_BITS[4] = { 9U, 3U, 5U, 7U };
+
+    // Internal counter right after the boot ROM, DIV reads 0xAB
+    constexpr u16 GB_TIMER_COUNTER_AFTER_BOOT = 0xABCCU;
+}
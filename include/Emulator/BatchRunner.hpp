@@ -0,0 +1,69 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Emulator/ThreadPool.hpp"
+#include "Core/Cartridge.hpp"
+#include "Types.hpp"
+
+namespace GBcc
+{
+    struct BatchJob
+    {
+        std::string romPath;
+        // Optional, replayed from its first frame
+        std::string moviePath;
+        // Zero runs for as long as the movie
+        u64 frames = 0ULL;
+    };
+
+    struct BatchResult
+    {
+        bool ok = false;
+        std::string error;
+        u64 frames = 0ULL;
+        u64 cycles = 0ULL;
+        // Hash of the final save state, equal results mean equal machines
+        u64 stateHash = 0ULL;
+        std::string serialOutput;
+        double seconds = 0.0;
+    };
+
+    // Runs independent headless machines on a thread pool, no window or
+    // audio involved
+    class BatchRunner
+    {
+        private:
+        ThreadPool m_Pool;
+
+        public:
+        // Zero threads uses every hardware thread
+        BatchRunner(const size_t threads = 0U);
+        ~BatchRunner() = default;
+
+        size_t GetThreadCount() const;
+
+        // Results are in the order of the jobs. Each ROM is read once and
+        // shared by all jobs running it.
+        std::vector<BatchResult> Run(const std::vector<BatchJob>& jobs);
+        static BatchResult RunJob(const BatchJob& job, const std::shared_ptr<const Cartridge>& pCartridge);
+    };
+}
@@ -0,0 +1,49 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <vector>
+
+#include "Core/System.hpp"
+#include "Types.hpp"
+
+namespace GBcc
+{
+    struct BenchmarkReport
+    {
+        u64 frames = 0ULL;
+        u64 cycles = 0ULL;
+        u64 instructions = 0ULL;
+        double seconds = 0.0;
+        // Host time per emulated frame, sorted ascending
+        std::vector<u64> frameNs;
+
+        double GetFramesPerSecond() const;
+        double GetInstructionsPerSecond() const;
+        double GetMeanFrameNs() const;
+        // Nearest rank, percentile in [0, 100]
+        u64 GetFrameNsPercentile(const double percentile) const;
+    };
+
+    // Runs whole frames back to back with no window, audio or pacing, so
+    // the only thing measured is the emulator itself
+    class BenchmarkRunner
+    {
+        public:
+        static BenchmarkReport Run(System& system, const u64 frames);
+    };
+}
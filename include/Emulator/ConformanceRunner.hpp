@@ -0,0 +1,58 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <string>
+
+#include "Core/System.hpp"
+#include "Types.hpp"
+
+namespace GBcc
+{
+    // 60 emulated seconds, more than any single blargg or mooneye ROM needs
+    constexpr u64 GB_CONFORMANCE_CYCLE_BUDGET = 60ULL * 4'194'304ULL;
+
+    enum class ConformanceResult : u8
+    {
+        PASSED  = 0,
+        FAILED  = 1,
+        // Neither signature within the budget
+        TIMEOUT = 2,
+        // The ROM could not be read
+        ERROR   = 3
+    };
+
+    struct ConformanceReport
+    {
+        ConformanceResult result = ConformanceResult::ERROR;
+        u64 cycles = 0ULL;
+        std::string serialOutput;
+    };
+
+    // Runs a test ROM headless until it reports a result. blargg ROMs print
+    // "Passed" or "Failed" over serial. mooneye ROMs load the Fibonacci
+    // numbers 3, 5, 8, 13, 21, 34 into B-L on success, 0x42 into each on
+    // failure, hit LD B,B and spin. Newer builds also send those six bytes
+    // over serial.
+    class ConformanceRunner
+    {
+        public:
+        static ConformanceReport Run(const std::string& romPath, const u64 cycleBudget = GB_CONFORMANCE_CYCLE_BUDGET);
+        static ConformanceReport Run(System& system, const u64 cycleBudget = GB_CONFORMANCE_CYCLE_BUDGET);
+        static const char* GetResultName(const ConformanceResult result);
+    };
+}
@@ -18,26 +18,100 @@
 #pragma once
 #include "Core/System.hpp"
 #include "Video/Video.hpp"
+#include "Emulator/FramePacer.hpp"
+#include "Emulator/RewindBuffer.hpp"
+#include "Audio/AudioStream.hpp"
 #include "Types.hpp"
 
 #include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace GBcc {
+    struct EmulatorStats
+    {
+        double framesPerSecond = 0.0;
+        double cpuMHz = 0.0;
+        double speed = 0.0;
+        // Time spent on run-ahead per presented frame
+        double runAheadMs = 0.0;
+    };
+
     class Emulator
     {
         private:
         Video& m_Video;
         System m_System;
         
-        std::chrono::steady_clock m_Timer;
-        std::chrono::time_point<std::chrono::steady_clock> m_StartFrame;
+        FramePacer m_FramePacer;
+        SyncMode m_SyncMode = SyncMode::VSYNC;
+
+        AudioStream m_AudioStream;
+        bool m_AudioEnabled = false;
+
+        std::unique_ptr<RewindBuffer> m_pRewind;
+        std::vector<u8> m_StateBuffer;
+
+        // Speculative frames run on a second, headless instance so the real
+        // one's timeline and audio are never touched
+        std::unique_ptr<System> m_pRunAhead;
+        u32 m_RunAheadFrames = 0U;
+
+        Movie m_Movie;
+        std::string m_MoviePath;
 
-        void LimitFramerate(const float fps);
+        double m_SpeedMultiplier = 1.0;
+        bool m_Uncapped = false;
+
+        using Clock = std::chrono::steady_clock;
+
+        Clock::time_point m_NextPresent;
+
+        EmulatorStats m_Stats;
+        Clock::time_point m_StatsWindowStart;
+        u64 m_StatsWindowFrames = 0ULL;
+        u64 m_StatsWindowCycles = 0ULL;
+        u64 m_StatsWindowPresents = 0ULL;
+        Clock::duration m_StatsWindowRunAhead = Clock::duration::zero();
+
+        bool IsFastForwarding() const;
+        void UpdatePacing();
+        void WaitForNextFrame();
+        void UpdateStats();
+        u8 ReadButtons() const;
+        bool StepFrame();
+        const PPU::Framebuffer& RunAhead();
 
         public:
         Emulator();
         ~Emulator();
+
+        // Fails if the file cannot be read or is not a ROM
+        bool LoadRom(const std::string& path);
         
         void Run();
+        void SetPipelinedRendering(const bool enable);
+        void SetSkipUnchangedFrames(const bool skip);
+        void SetSyncMode(const SyncMode mode);
+        void SetSpeedMultiplier(const double multiplier);
+        void SetUncapped(const bool uncapped);
+        // Records a state per frame, holding Backspace plays them back in
+        // reverse. Zero seconds turns it off.
+        void SetRewindSeconds(const double seconds);
+        // Shows the frame this many frames ahead of the emulated one, which
+        // hides as many frames of a game's input lag
+        void SetRunAheadFrames(const u32 frames);
+        // Records the input of every frame, the movie is written to the path
+        // when Run() returns. Rewinding is off while recording.
+        void StartRecording(const std::string& path);
+        void SetExecLog(const std::string& path);
+
+        const EmulatorStats& GetStats() const;
+
+        // The host audio callback drains this with AudioStream::Consume().
+        // SyncMode::AUDIO turns audio on and paces frames by that callback.
+        void SetAudioEnabled(const bool enable);
+        AudioStream& GetAudioStream();
     };
 }
\ No newline at end of file
@@ -0,0 +1,56 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include "Types.hpp"
+
+namespace GBcc
+{
+    enum class SyncMode : u8
+    {
+        VSYNC = 0,
+        TIMER = 1,
+        AUDIO = 2
+    };
+
+    // Paces frames against absolute deadlines on the monotonic clock. Most
+    // of the wait is slept away, only the last moment is spun for accuracy.
+    // Deadlines are derived from the frame count since the last resync, so
+    // rounding and oversleeping never accumulate.
+    class FramePacer
+    {
+        private:
+        double m_FramePeriodNs;
+        u64 m_SpinNs;
+
+        u64 m_Origin = 0ULL;
+        u64 m_FramesSinceOrigin = 0ULL;
+
+        static u64 Now();
+        static void SleepUntil(const u64 deadline);
+
+        public:
+        FramePacer(const double framesPerSecond);
+        ~FramePacer() = default;
+
+        void SetFrameRate(const double framesPerSecond);
+        void SetSpinThreshold(const u64 nanoseconds);
+
+        void Resync();
+        void WaitForNextFrame();
+    };
+}
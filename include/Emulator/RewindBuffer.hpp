@@ -0,0 +1,81 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <vector>
+
+#include "Types.hpp"
+
+namespace GBcc
+{
+    // History of fixed-size save states for rewinding. Every Nth state is
+    // stored whole as a keyframe, the rest as the XOR against the state
+    // before it. Both are run-length coded, so the bytes a frame leaves
+    // untouched cost next to nothing.
+    //
+    // Records live in one preallocated byte ring. When it is full the oldest
+    // keyframe is dropped together with the deltas that depend on it.
+    class RewindBuffer
+    {
+        private:
+        struct Snapshot
+        {
+            size_t offset;
+            size_t size;
+            bool keyframe;
+        };
+
+        const size_t m_StateSize;
+        const u32 m_KeyframeInterval;
+
+        std::vector<u8> m_Data;
+        size_t m_WriteOffset = 0;
+
+        std::vector<Snapshot> m_Snapshots;
+        size_t m_First = 0;
+        size_t m_Count = 0;
+        size_t m_Used = 0;
+        u32 m_SinceKeyframe = 0U;
+
+        // The newest state whole, which deltas are taken against and undone
+        // from
+        std::vector<u8> m_Current;
+        std::vector<u8> m_Encoded;
+
+        Snapshot& GetSnapshot(const size_t index);
+        size_t Encode(const u8* state, const bool keyframe);
+        void Decode(const Snapshot& snapshot, u8* target) const;
+
+        bool Reserve(const size_t size, size_t& offset);
+        bool DropOldestGroup();
+        void StepBack();
+
+        public:
+        // The keyframe interval is capped at half of maxSnapshots, so there is
+        // always an older group to drop before the descriptors run out
+        RewindBuffer(const size_t stateSize, const size_t memoryCap, const size_t maxSnapshots, const u32 keyframeInterval = 60U);
+        ~RewindBuffer() = default;
+
+        void Push(const u8* state);
+        // Removes the newest state and writes it to state
+        bool Pop(u8* state);
+        void Clear();
+
+        size_t Size() const;
+        size_t MemoryUsed() const;
+    };
+}
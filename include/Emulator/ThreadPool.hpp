@@ -0,0 +1,80 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Types.hpp"
+
+namespace GBcc
+{
+    // Work-stealing parallel for. Every worker starts with its own block of
+    // tasks and takes them from the back, a worker that runs dry steals from
+    // the front of the others, so a few slow tasks do not leave cores idle.
+    //
+    // The workers are started once and sleep between calls, woken by a new
+    // epoch.
+    class ThreadPool
+    {
+        private:
+        struct Queue
+        {
+            std::mutex mutex;
+            std::deque<size_t> tasks;
+        };
+
+        const size_t m_ThreadCount;
+        std::vector<std::unique_ptr<Queue>> m_Queues;
+        std::vector<std::thread> m_Threads;
+
+        // The current call, guarded by m_Mutex
+        std::mutex m_Mutex;
+        std::condition_variable m_Start;
+        std::condition_variable m_Done;
+        u64 m_Epoch = 0ULL;
+        const std::function<void(const size_t)>* m_pTask = nullptr;
+        size_t m_Workers = 0;
+        size_t m_Running = 0;
+        bool m_Stop = false;
+
+        bool Pop(const size_t worker, size_t& task);
+        bool Steal(const size_t worker, size_t& task);
+        void Work(const size_t worker, const std::function<void(const size_t)>& task);
+        void WorkerLoop(const size_t worker);
+
+        public:
+        // Zero threads uses every hardware thread
+        ThreadPool(const size_t threads = 0U);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        size_t GetThreadCount() const;
+
+        // Calls task(i) for every i below count, the calling thread is one
+        // of the workers. Returns once all of them are done. Not to be called
+        // from more than one thread at a time.
+        void ParallelFor(const size_t count, const std::function<void(const size_t)>& task);
+    };
+}
@@ -0,0 +1,122 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <array>
+#include <atomic>
+
+#include "Types.hpp"
+
+namespace GBcc
+{
+    // Bounded single-producer/single-consumer queue. Slots are filled and read
+    // in place, so nothing is copied or allocated after construction.
+    template <typename T, size_t N>
+    class SPSCQueue
+    {
+        private:
+        std::array<T, N> m_Slots;
+
+        alignas(64) std::atomic<size_t> m_Head = 0;
+        alignas(64) std::atomic<size_t> m_Tail = 0;
+
+        public:
+        T* TryBeginPush();
+        T* BeginPush();
+        void EndPush();
+
+        T* TryFront();
+        T* Front();
+        void Pop();
+
+        bool Empty() const;
+    };
+
+    template <typename T, size_t N>
+    T* SPSCQueue<T, N>::TryBeginPush()
+    {
+        const size_t head = m_Head.load(std::memory_order_relaxed);
+        if (head - m_Tail.load(std::memory_order_acquire) == N)
+        {
+            return nullptr;
+        }
+
+        return &m_Slots[head % N];
+    }
+
+    template <typename T, size_t N>
+    T* SPSCQueue<T, N>::BeginPush()
+    {
+        const size_t head = m_Head.load(std::memory_order_relaxed);
+        size_t tail = m_Tail.load(std::memory_order_acquire);
+
+        while (head - tail == N)
+        {
+            m_Tail.wait(tail, std::memory_order_acquire);
+            tail = m_Tail.load(std::memory_order_acquire);
+        }
+
+        return &m_Slots[head % N];
+    }
+
+    template <typename T, size_t N>
+    void SPSCQueue<T, N>::EndPush()
+    {
+        m_Head.fetch_add(1, std::memory_order_release);
+        m_Head.notify_one();
+    }
+
+    template <typename T, size_t N>
+    T* SPSCQueue<T, N>::TryFront()
+    {
+        const size_t tail = m_Tail.load(std::memory_order_relaxed);
+        if (m_Head.load(std::memory_order_acquire) == tail)
+        {
+            return nullptr;
+        }
+
+        return &m_Slots[tail % N];
+    }
+
+    template <typename T, size_t N>
+    T* SPSCQueue<T, N>::Front()
+    {
+        const size_t tail = m_Tail.load(std::memory_order_relaxed);
+        size_t head = m_Head.load(std::memory_order_acquire);
+
+        while (head == tail)
+        {
+            m_Head.wait(head, std::memory_order_acquire);
+            head = m_Head.load(std::memory_order_acquire);
+        }
+
+        return &m_Slots[tail % N];
+    }
+
+    template <typename T, size_t N>
+    void SPSCQueue<T, N>::Pop()
+    {
+        m_Tail.fetch_add(1, std::memory_order_release);
+        m_Tail.notify_one();
+    }
+
+    template <typename T, size_t N>
+    bool SPSCQueue<T, N>::Empty() const
+    {
+        return m_Head.load(std::memory_order_acquire) == m_Tail.load(std::memory_order_acquire);
+    }
+}
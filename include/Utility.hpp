@@ -15,10 +15,13 @@
 * You should have received a copy of the GNU General Public License
 * along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
-
+#pragma once
 #include <cstddef>
+#include <cstring>
 #include <bit>
 
+#include "Types.hpp"
+
 namespace GBcc
 {
     template <typename T>
@@ -27,4 +30,27 @@ namespace GBcc
         size_t shiftAmount = std::countr_zero(bitmask);
         return (value & bitmask) >> shiftAmount;
     }
+
+    // FNV-1a over 64-bit words. Only meant to tell buffers apart, not to be a
+    // well distributed hash.
+    inline u64 HashBytes(const u8* const data, const size_t size)
+    {
+        constexpr u64 fnvPrime = 0x0000'0100'0000'01B3ULL;
+        u64 hash = 0xCBF2'9CE4'8422'2325ULL;
+        size_t i = 0;
+
+        for (; i + sizeof(u64) <= size; i += sizeof(u64))
+        {
+            u64 word;
+            std::memcpy(&word, data + i, sizeof(u64));
+            hash = (hash ^ word) * fnvPrime;
+        }
+
+        for (; i < size; i++)
+        {
+            hash = (hash ^ data[i]) * fnvPrime;
+        }
+
+        return hash;
+    }
 }
\ No newline at end of file
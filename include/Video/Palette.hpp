@@ -0,0 +1,47 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <array>
+#include <span>
+
+#include "Types.hpp"
+
+namespace GBcc
+{
+    // Maps DMG shades (0-3, 0 lightest) to RGB for the texture upload
+    class Palette
+    {
+        public:
+        using Color = std::array<u8, 3U>;
+        // Ordered darkest first
+        using Colors = std::array<Color, 4U>;
+
+        private:
+        Colors m_Colors;
+
+        public:
+        Palette();
+        explicit Palette(const Colors& colors);
+        ~Palette() = default;
+
+        const Color& GetColor(const u8 shade) const;
+
+        // Returns false if rgb is smaller than three bytes per shade
+        bool Convert(std::span<const u8> shades, std::span<u8> rgb) const;
+    };
+}
@@ -50,11 +50,18 @@ namespace GBcc {
 
         GLuint m_ShaderProgram;
 
+        bool m_SkipUnchangedFrames = false;
+
         public:
         static Video& GetInstance();
         void UpdateTexture(const Framebuffer& pixels);
-        void Draw();
+        bool Draw(const bool frameChanged = true);
         bool ShouldClose();
+        bool IsKeyPressed(const int key);
+
+        void SetSkipUnchangedFrames(const bool skip);
+        void SetVSync(const bool enable);
+        void SetTitle(const std::string& title);
 
         private:
         Video();
@@ -0,0 +1,85 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+* C interface to the emulation core. Every call works on one instance and
+* the library keeps no global state, so any number of instances can live
+* in one process. An instance must not be used by two threads at once.
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define GBCC_SCREEN_WIDTH   160
+#define GBCC_SCREEN_HEIGHT  144
+
+/* Button bits for gbcc_set_input() */
+#define GBCC_BUTTON_RIGHT   0x01
+#define GBCC_BUTTON_LEFT    0x02
+#define GBCC_BUTTON_UP      0x04
+#define GBCC_BUTTON_DOWN    0x08
+#define GBCC_BUTTON_A       0x10
+#define GBCC_BUTTON_B       0x20
+#define GBCC_BUTTON_SELECT  0x40
+#define GBCC_BUTTON_START   0x80
+
+typedef struct gbcc_instance gbcc_instance;
+
+/* Returns NULL if out of memory */
+gbcc_instance* gbcc_create(void);
+void gbcc_destroy(gbcc_instance* instance);
+
+/* Copies the image, call before running. Returns 0 on success, -1 on an
+   empty image or one larger than 32K. */
+int gbcc_load_rom(gbcc_instance* instance, const uint8_t* data, size_t size);
+
+/* Runs the ROM already loaded into source without a copy of its own, so
+   many instances of one game cost no extra ROM memory */
+void gbcc_share_rom(gbcc_instance* instance, const gbcc_instance* source);
+
+/* Runs to the first instruction boundary at or past the given number of
+   cycles and returns the cycles actually run */
+uint64_t gbcc_run_cycles(gbcc_instance* instance, uint64_t cycles);
+void gbcc_run_frames(gbcc_instance* instance, uint32_t frames);
+uint64_t gbcc_get_cycles(const gbcc_instance* instance);
+
+/* GBCC_SCREEN_WIDTH * GBCC_SCREEN_HEIGHT shades from 0 (lightest) to 3,
+   row major. Valid until the instance is destroyed. */
+const uint8_t* gbcc_get_framebuffer(const gbcc_instance* instance);
+
+/* Buttons held from the next frame on, an OR of GBCC_BUTTON_* */
+void gbcc_set_input(gbcc_instance* instance, uint8_t buttons);
+
+/* Bytes the game sent over the serial port since the last clear */
+const char* gbcc_get_serial_output(const gbcc_instance* instance, size_t* size);
+void gbcc_clear_serial_output(gbcc_instance* instance);
+
+/* States are the same size for every instance of one build */
+size_t gbcc_get_state_size(const gbcc_instance* instance);
+/* Returns the bytes written, 0 if the buffer is too small */
+size_t gbcc_save_state(const gbcc_instance* instance, void* buffer, size_t size);
+/* Returns 0 on success, -1 if the data is not a state of this build */
+int gbcc_load_state(gbcc_instance* instance, const void* buffer, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
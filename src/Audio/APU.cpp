@@ -0,0 +1,451 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Audio/APU.hpp"
+
+#include <algorithm>
+
+namespace GBcc
+{
+    // Samples kept for a reader that falls behind, a quarter second
+    constexpr size_t GB_AUDIO_BUFFER_DIVISOR = 4U;
+
+    APU::APU(Scheduler& scheduler, const u32 sampleRate) : 
+        m_Scheduler(scheduler),
+        m_SampleRate(sampleRate),
+        m_Left(GB_CPU_CLOCK_HZ, sampleRate, 0U),
+        m_Right(GB_CPU_CLOCK_HZ, sampleRate, 0U)
+    {
+        m_Time = m_Scheduler.Now();
+        m_FrameStart = m_Time;
+        m_NextSequencerClock = (m_Time / GB_FRAME_SEQUENCER_PERIOD + 1U) * GB_FRAME_SEQUENCER_PERIOD;
+
+        const float gain = 32767.0f / GB_AUDIO_MAX_AMPLITUDE;
+        m_Left.SetGain(gain);
+        m_Right.SetGain(gain);
+
+        std::fill(m_Registers.begin(), m_Registers.end(), 0x00U);
+        m_Square1.hasSweep = true;
+        m_Wave.waveRam = m_Registers.data() + (GB_WAVE_RAM_BEGIN - GB_APU_REGS_BEGIN);
+
+        for (auto& output : m_Outputs)
+        {
+            output.left = &m_Left;
+            output.right = &m_Right;
+            output.frameStart = &m_FrameStart;
+        }
+
+        // State left behind by the boot ROM
+        WriteRegister(GB_REG_NR50, 0x77U);
+        WriteRegister(GB_REG_NR51, 0xF3U);
+        WriteRegister(GB_REG_NR12, 0xF3U);
+        WriteRegister(GB_REG_NR11, 0x80U);
+    }
+
+    void APU::Sync()
+    {
+        const u64 now = m_Scheduler.Now();
+
+        while (m_NextSequencerClock <= now)
+        {
+            RunChannels(m_Time, m_NextSequencerClock);
+            m_Time = m_NextSequencerClock;
+            ClockSequencer();
+            m_NextSequencerClock += GB_FRAME_SEQUENCER_PERIOD;
+        }
+
+        RunChannels(m_Time, now);
+        m_Time = now;
+    }
+
+    void APU::RunChannels(const u64 from, const u64 to)
+    {
+        if (from >= to)
+        {
+            return;
+        }
+
+        m_Square1.Run(m_Outputs[0], from, to);
+        m_Square2.Run(m_Outputs[1], from, to);
+        m_Wave.Run(m_Outputs[2], from, to);
+        m_Noise.Run(m_Outputs[3], from, to);
+    }
+
+    void APU::ClockSequencer()
+    {
+        if (!m_Powered)
+        {
+            return;
+        }
+
+        // Length on even steps, sweep on 2 and 6, envelope on 7
+        if ((m_SequencerStep & 1U) == 0U)
+        {
+            m_Square1.enabled &= !m_Square1.length.Clock();
+            m_Square2.enabled &= !m_Square2.length.Clock();
+            m_Wave.enabled &= !m_Wave.length.Clock();
+            m_Noise.enabled &= !m_Noise.length.Clock();
+        }
+
+        if (m_SequencerStep == 2U || m_SequencerStep == 6U)
+        {
+            m_Square1.ClockSweep();
+        }
+
+        if (m_SequencerStep == 7U)
+        {
+            m_Square1.envelope.Clock();
+            m_Square2.envelope.Clock();
+            m_Noise.envelope.Clock();
+        }
+
+        m_SequencerStep = (m_SequencerStep + 1U) & 7U;
+        UpdateLevels(m_Time);
+    }
+
+    void APU::UpdateLevels(const u64 time)
+    {
+        m_Outputs[0].Update(time, m_Square1.GetLevel());
+        m_Outputs[1].Update(time, m_Square2.GetLevel());
+        m_Outputs[2].Update(time, m_Wave.GetLevel());
+        m_Outputs[3].Update(time, m_Noise.GetLevel());
+    }
+
+    void APU::UpdateMixer(const u64 time)
+    {
+        const u8 nr50 = m_Registers[GB_REG_NR50 - GB_APU_REGS_BEGIN];
+        const u8 nr51 = m_Registers[GB_REG_NR51 - GB_APU_REGS_BEGIN];
+        const i32 rightVolume = (nr50 & 0x07U) + 1;
+        const i32 leftVolume = ((nr50 >> 4U) & 0x07U) + 1;
+
+        for (size_t channel = 0; channel < GB_AUDIO_CHANNEL_COUNT; channel++)
+        {
+            m_Outputs[channel].SetScales(
+                time,
+                (nr51 >> (channel + 4U)) & 1U ? leftVolume : 0,
+                (nr51 >> channel) & 1U ? rightVolume : 0
+            );
+        }
+    }
+
+    void APU::WriteSquare(SquareChannel& channel, const u8 index, const u8 data)
+    {
+        switch (index)
+        {
+            case 0:
+                channel.sweepPeriod = (data >> 4U) & 0x07U;
+                channel.sweepNegate = data & 0b0000'1000U;
+                channel.sweepShift = data & 0x07U;
+                break;
+            case 1:
+                channel.duty = data >> 6U;
+                channel.length.Load(GB_SQUARE_LENGTH_MAX, data & 0x3FU);
+                break;
+            case 2:
+                channel.dacEnabled = data & 0xF8U;
+                channel.enabled &= channel.dacEnabled;
+                break;
+            case 3:
+                channel.frequency = (channel.frequency & 0x0700U) | data;
+                break;
+            case 4:
+                channel.frequency = (channel.frequency & 0x00FFU) | ((data & 0x07U) << 8U);
+                channel.length.enabled = data & GB_NRX4_LENGTH_ENABLE;
+
+                if (data & GB_NRX4_TRIGGER)
+                {
+                    channel.Trigger();
+                    channel.envelope.Trigger(m_Registers[(&channel == &m_Square1 ? GB_REG_NR12 : GB_REG_NR22) - GB_APU_REGS_BEGIN]);
+                }
+                break;
+        }
+    }
+
+    void APU::WriteWave(const u8 index, const u8 data)
+    {
+        switch (index)
+        {
+            case 0:
+                m_Wave.dacEnabled = data & GB_NR30_DAC_ENABLE;
+                m_Wave.enabled &= m_Wave.dacEnabled;
+                break;
+            case 1:
+                m_Wave.length.Load(GB_WAVE_LENGTH_MAX, data);
+                break;
+            case 2:
+                m_Wave.volumeCode = (data >> 5U) & 0x03U;
+                break;
+            case 3:
+                m_Wave.frequency = (m_Wave.frequency & 0x0700U) | data;
+                break;
+            case 4:
+                m_Wave.frequency = (m_Wave.frequency & 0x00FFU) | ((data & 0x07U) << 8U);
+                m_Wave.length.enabled = data & GB_NRX4_LENGTH_ENABLE;
+
+                if (data & GB_NRX4_TRIGGER)
+                {
+                    m_Wave.Trigger();
+                }
+                break;
+        }
+    }
+
+    void APU::WriteNoise(const u8 index, const u8 data)
+    {
+        switch (index)
+        {
+            case 1:
+                m_Noise.length.Load(GB_SQUARE_LENGTH_MAX, data & 0x3FU);
+                break;
+            case 2:
+                m_Noise.dacEnabled = data & 0xF8U;
+                m_Noise.enabled &= m_Noise.dacEnabled;
+                break;
+            case 3:
+                m_Noise.clockShift = data >> 4U;
+                m_Noise.narrow = data & 0b0000'1000U;
+                m_Noise.divisorCode = data & 0x07U;
+                break;
+            case 4:
+                m_Noise.length.enabled = data & GB_NRX4_LENGTH_ENABLE;
+
+                if (data & GB_NRX4_TRIGGER)
+                {
+                    m_Noise.Trigger();
+                    m_Noise.envelope.Trigger(m_Registers[GB_REG_NR42 - GB_APU_REGS_BEGIN]);
+                }
+                break;
+        }
+    }
+
+    void APU::PowerOff()
+    {
+        std::fill(m_Registers.begin(), m_Registers.begin() + (GB_REG_NR52 - GB_APU_REGS_BEGIN), 0x00U);
+
+        for (u16 address = GB_REG_NR10; address < GB_REG_NR52; address++)
+        {
+            const u8 index = (address - GB_REG_NR10) % 5U;
+
+            switch ((address - GB_REG_NR10) / 5U)
+            {
+                case 0:
+                    WriteSquare(m_Square1, index, 0x00U);
+                    break;
+                case 1:
+                    WriteSquare(m_Square2, index, 0x00U);
+                    break;
+                case 2:
+                    WriteWave(index, 0x00U);
+                    break;
+                case 3:
+                    WriteNoise(index, 0x00U);
+                    break;
+            }
+        }
+    }
+
+    u8 APU::ReadRegister(const u16 address)
+    {
+        const size_t offset = address - GB_APU_REGS_BEGIN;
+
+        if (address >= GB_WAVE_RAM_BEGIN)
+        {
+            return m_Registers[offset];
+        }
+
+        if (address == GB_REG_NR52)
+        {
+            // Channel status bits change with length counters and sweep
+            Sync();
+
+            return GB_APU_READ_MASKS[offset] | 
+                (m_Powered ? GB_NR52_POWER : 0x00U) | 
+                (m_Square1.enabled ? 0x01U : 0x00U) | 
+                (m_Square2.enabled ? 0x02U : 0x00U) | 
+                (m_Wave.enabled ? 0x04U : 0x00U) | 
+                (m_Noise.enabled ? 0x08U : 0x00U);
+        }
+
+        return m_Registers[offset] | GB_APU_READ_MASKS[offset];
+    }
+
+    void APU::WriteRegister(const u16 address, const u8 data)
+    {
+        const size_t offset = address - GB_APU_REGS_BEGIN;
+
+        if (!m_Powered && address < GB_WAVE_RAM_BEGIN && address != GB_REG_NR52)
+        {
+            return;
+        }
+
+        Sync();
+        m_Registers[offset] = data;
+
+        const u8 index = offset % 5U;
+
+        if (address <= GB_REG_NR14)
+        {
+            WriteSquare(m_Square1, index, data);
+        }
+        else if (address <= GB_REG_NR24)
+        {
+            WriteSquare(m_Square2, index, data);
+        }
+        else if (address <= GB_REG_NR34)
+        {
+            WriteWave(index, data);
+        }
+        else if (address <= GB_REG_NR44)
+        {
+            WriteNoise(index, data);
+        }
+        else if (address == GB_REG_NR50 || address == GB_REG_NR51)
+        {
+            UpdateMixer(m_Time);
+        }
+        else if (address == GB_REG_NR52)
+        {
+            const bool power = data & GB_NR52_POWER;
+
+            if (m_Powered && !power)
+            {
+                PowerOff();
+                UpdateMixer(m_Time);
+            }
+            else if (!m_Powered && power)
+            {
+                m_SequencerStep = 0U;
+            }
+
+            m_Powered = power;
+        }
+
+        UpdateLevels(m_Time);
+    }
+
+    void APU::EndBufferFrame()
+    {
+        Sync();
+
+        const u64 duration = m_Time - m_FrameStart;
+        m_Left.EndFrame(duration);
+        m_Right.EndFrame(duration);
+        m_FrameStart = m_Time;
+    }
+
+    void APU::EndFrame()
+    {
+        EndBufferFrame();
+    }
+
+    void APU::SetOutputEnabled(const bool enable)
+    {
+        // Whatever the channels did before is lost, the stream starts here
+        EndBufferFrame();
+
+        const size_t capacity = enable ? m_SampleRate / GB_AUDIO_BUFFER_DIVISOR : 0U;
+        m_Left.SetCapacity(capacity);
+        m_Right.SetCapacity(capacity);
+    }
+
+    size_t APU::SamplesAvailable() const
+    {
+        return m_Left.SamplesAvailable();
+    }
+
+    size_t APU::ReadSamples(i16* out, const size_t count)
+    {
+        EndBufferFrame();
+
+        const size_t read = m_Left.ReadSamples(out, count, 2U);
+        m_Right.ReadSamples(out + 1U, read, 2U);
+        return read;
+    }
+
+    void APU::SaveState(StateWriter& writer) const
+    {
+        writer.Write(m_Time);
+        writer.Write(m_NextSequencerClock);
+        writer.Write(m_SequencerStep);
+        writer.Write(m_Powered);
+        writer.WriteBytes(m_Registers.data(), m_Registers.size());
+
+        m_Square1.SaveState(writer);
+        m_Square2.SaveState(writer);
+        m_Wave.SaveState(writer);
+        m_Noise.SaveState(writer);
+
+        for (const auto& output : m_Outputs)
+        {
+            writer.Write(output.leftScale);
+            writer.Write(output.rightScale);
+            writer.Write(output.level);
+        }
+    }
+
+    void APU::LoadState(StateReader& reader)
+    {
+        // Close the buffer frame where the channels last ran. Not Sync(), the
+        // clock may already be the restored one.
+        const u64 duration = m_Time - m_FrameStart;
+        m_Left.EndFrame(duration);
+        m_Right.EndFrame(duration);
+
+        m_Time = reader.Read<u64>();
+        m_FrameStart = m_Time;
+        m_NextSequencerClock = reader.Read<u64>();
+        m_SequencerStep = reader.Read<u8>();
+        m_Powered = reader.Read<bool>();
+        reader.ReadBytes(m_Registers.data(), m_Registers.size());
+
+        m_Square1.LoadState(reader);
+        m_Square2.LoadState(reader);
+        m_Wave.LoadState(reader);
+        m_Noise.LoadState(reader);
+
+        // Moving to the restored levels through the outputs keeps the step
+        // buffers consistent with them
+        for (auto& output : m_Outputs)
+        {
+            const i32 leftScale = reader.Read<i32>();
+            const i32 rightScale = reader.Read<i32>();
+            const i32 level = reader.Read<i32>();
+
+            output.SetScales(m_Time, leftScale, rightScale);
+            output.Update(m_Time, level);
+        }
+    }
+
+    bool APU::ValidateState(StateReader& reader)
+    {
+        // Time, sequencer clock and step, power and the registers
+        reader.Skip(2U * sizeof(u64) + sizeof(u8) + sizeof(bool) + GB_APU_REGS_SIZE);
+
+        SquareChannel square1;
+        SquareChannel square2;
+        WaveChannel wave;
+        NoiseChannel noise;
+        square1.LoadState(reader);
+        square2.LoadState(reader);
+        wave.LoadState(reader);
+        noise.LoadState(reader);
+
+        reader.Skip(GB_AUDIO_CHANNEL_COUNT * 3U * sizeof(i32));
+        return !reader.Overflowed() && square1.IsValid() && square2.IsValid() && wave.IsValid() && noise.IsValid();
+    }
+}
@@ -0,0 +1,111 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Audio/AudioStream.hpp"
+
+#include <algorithm>
+#include <thread>
+
+namespace GBcc
+{
+    AudioStream::AudioStream() : 
+        m_RateController(MAX_RATE_DEVIATION, TARGET_FILL), 
+        m_Resampler(CHUNK_FRAMES) {}
+
+    void AudioStream::Produce(APU& apu)
+    {
+        size_t read;
+
+        do
+        {
+            read = apu.ReadSamples(m_ProduceChunk.data(), CHUNK_FRAMES);
+            const size_t resampled = m_Resampler.Process(m_ProduceChunk.data(), read, m_ResampledChunk.data(), RESAMPLED_FRAMES);
+            m_DroppedFrames += resampled - m_Ring.Write(m_ResampledChunk.data(), resampled);
+        }
+        while (read == CHUNK_FRAMES);
+
+        // Running fast plays the same audio pitched up rather than piling it
+        // up in the ring
+        m_Resampler.SetRatio(m_Speed / m_RateController.Update(m_Ring.Size(), m_Ring.Capacity()));
+    }
+
+    void AudioStream::SetSpeed(const double speed)
+    {
+        m_Speed = std::clamp(speed, MIN_SPEED, MAX_SPEED);
+    }
+
+    u64 AudioStream::GetDroppedFrames() const
+    {
+        return m_DroppedFrames;
+    }
+
+    bool AudioStream::WaitForSpace(const std::chrono::milliseconds timeout) const
+    {
+        constexpr size_t target = static_cast<size_t>(RING_FRAMES * TARGET_FILL);
+        // A frame is about 800 samples at 48 kHz, well over this
+        constexpr auto poll = std::chrono::microseconds(500);
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+        while (m_Ring.Size() > target)
+        {
+            if (std::chrono::steady_clock::now() >= deadline)
+            {
+                return false;
+            }
+            std::this_thread::sleep_for(poll);
+        }
+        return true;
+    }
+
+    void AudioStream::Consume(i16* out, const size_t frames)
+    {
+        const size_t read = m_Ring.Read(out, frames);
+
+        if (read > 0U)
+        {
+            m_LastFrame = { out[read * 2U - 2U], out[read * 2U - 1U] };
+        }
+
+        if (read < frames)
+        {
+            // Holding the last level avoids a click where zero would not
+            for (size_t i = read; i < frames; i++)
+            {
+                out[i * 2U] = m_LastFrame[0];
+                out[i * 2U + 1U] = m_LastFrame[1];
+            }
+
+            m_Underruns.fetch_add(1U, std::memory_order_relaxed);
+        }
+    }
+
+    u64 AudioStream::GetUnderruns() const
+    {
+        return m_Underruns.load(std::memory_order_relaxed);
+    }
+
+    size_t AudioStream::GetFill() const
+    {
+        return m_Ring.Size();
+    }
+
+    double AudioStream::GetRatio() const
+    {
+        return m_RateController.GetRatio();
+    }
+}
@@ -0,0 +1,156 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Audio/BlipBuffer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace GBcc
+{
+    // Cutoff as a fraction of the output sample rate, a bit under Nyquist
+    constexpr double GB_BLIP_CUTOFF = 0.45;
+    constexpr double GB_BLIP_HIGH_PASS_HZ = 20.0;
+
+    const BlipBuffer::Kernel& BlipBuffer::GetKernel()
+    {
+        static const Kernel kernel = []()
+        {
+            Kernel result;
+            constexpr double pi = std::numbers::pi;
+
+            for (size_t phase = 0; phase < PHASES; phase++)
+            {
+                const double fraction = static_cast<double>(phase) / PHASES;
+                double sum = 0.0;
+
+                for (size_t tap = 0; tap < TAPS; tap++)
+                {
+                    const double x = static_cast<double>(tap) - (TAPS / 2U - 1U) - fraction;
+                    const double sinc = x == 0.0 ? 1.0 : std::sin(2.0 * pi * GB_BLIP_CUTOFF * x) / (2.0 * pi * GB_BLIP_CUTOFF * x);
+                    const double u = (static_cast<double>(tap) + 1.0 - fraction) / TAPS;
+                    const double window = 0.42 - 0.5 * std::cos(2.0 * pi * u) + 0.08 * std::cos(4.0 * pi * u);
+
+                    result[phase][tap] = static_cast<float>(sinc * window);
+                    sum += sinc * window;
+                }
+
+                // Each step must settle at exactly its delta
+                for (float& tap : result[phase])
+                {
+                    tap = static_cast<float>(tap / sum);
+                }
+            }
+
+            return result;
+        }();
+
+        return kernel;
+    }
+
+    BlipBuffer::BlipBuffer(const u32 clockRate, const u32 sampleRate, const size_t capacity) : 
+        m_Buffer(capacity ? capacity + TAPS + 1U : 0U, 0.0f),
+        m_Capacity(capacity),
+        m_ClockRate(clockRate),
+        m_SampleRate(sampleRate),
+        m_SamplesPerClock(static_cast<u64>((m_SampleRate / m_ClockRate) * (1ULL << FRACTION_BITS))),
+        m_HighPassFactor(static_cast<float>(1.0 - std::exp(-2.0 * std::numbers::pi * GB_BLIP_HIGH_PASS_HZ / sampleRate)))
+    {
+        GetKernel();
+    }
+
+    void BlipBuffer::SetCapacity(const size_t capacity)
+    {
+        // Assigning a new vector frees the old storage, clearing would not
+        m_Buffer = std::vector<float>(capacity ? capacity + TAPS + 1U : 0U, 0.0f);
+        m_Capacity = capacity;
+        Clear();
+    }
+
+    void BlipBuffer::SetGain(const float gain)
+    {
+        m_Gain = gain;
+    }
+
+    void BlipBuffer::EndFrame(const u64 duration)
+    {
+        m_FrameOffset += duration * m_SamplesPerClock;
+
+        if (m_Capacity == 0U)
+        {
+            m_FrameOffset &= (1ULL << FRACTION_BITS) - 1U;
+            return;
+        }
+
+        // Nobody is reading, keep only the newest half so the next frame
+        // still has room
+        const size_t available = SamplesAvailable();
+        if (available > m_Capacity / 2U)
+        {
+            RemoveSamples(available - m_Capacity / 2U);
+        }
+    }
+
+    size_t BlipBuffer::SamplesAvailable() const
+    {
+        return m_FrameOffset >> FRACTION_BITS;
+    }
+
+    void BlipBuffer::Consume(i16* out, const size_t count, const size_t stride)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            m_Integrator += m_Buffer[i];
+            m_DCLevel += (m_Integrator - m_DCLevel) * m_HighPassFactor;
+
+            if (out)
+            {
+                const float sample = (m_Integrator - m_DCLevel) * m_Gain;
+                out[i * stride] = static_cast<i16>(std::clamp(sample, -32768.0f, 32767.0f));
+            }
+        }
+
+        // Kernel tails of pending deltas reach past the available samples
+        const size_t used = std::min(SamplesAvailable() + TAPS + 1U, m_Buffer.size());
+        std::copy(m_Buffer.begin() + count, m_Buffer.begin() + used, m_Buffer.begin());
+        std::fill(m_Buffer.begin() + (used - count), m_Buffer.begin() + used, 0.0f);
+
+        m_FrameOffset -= static_cast<u64>(count) << FRACTION_BITS;
+    }
+
+    size_t BlipBuffer::ReadSamples(i16* out, size_t count, const size_t stride)
+    {
+        count = std::min(count, SamplesAvailable());
+        Consume(out, count, stride);
+        return count;
+    }
+
+    void BlipBuffer::RemoveSamples(const size_t count)
+    {
+        Consume(nullptr, std::min(count, SamplesAvailable()), 1U);
+    }
+
+    void BlipBuffer::Clear()
+    {
+        std::fill(m_Buffer.begin(), m_Buffer.end(), 0.0f);
+        m_FrameOffset &= (1ULL << FRACTION_BITS) - 1U;
+        m_Integrator = 0.0f;
+        m_DCLevel = 0.0f;
+    }
+}
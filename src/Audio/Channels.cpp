@@ -0,0 +1,433 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Audio/Channels.hpp"
+
+namespace GBcc
+{
+    // Steps of a timer that fires at start, start + period, ... before end
+    static u64 CountSteps(const u64 start, const u64 end, const u64 period)
+    {
+        return (end - start + period - 1U) / period;
+    }
+
+    void ChannelOutput::SetScales(const u64 time, const i32 newLeftScale, const i32 newRightScale)
+    {
+        const u64 frameTime = time - *frameStart;
+
+        if (newLeftScale != leftScale)
+        {
+            left->AddDelta(frameTime, static_cast<float>(level * (newLeftScale - leftScale)));
+        }
+        if (newRightScale != rightScale)
+        {
+            right->AddDelta(frameTime, static_cast<float>(level * (newRightScale - rightScale)));
+        }
+
+        leftScale = newLeftScale;
+        rightScale = newRightScale;
+    }
+
+    void Envelope::Trigger(const u8 nrx2)
+    {
+        volume = nrx2 >> 4U;
+        increase = nrx2 & 0b0000'1000U;
+        period = nrx2 & 0b0000'0111U;
+        timer = period;
+    }
+
+    void Envelope::Clock()
+    {
+        if (period == 0U || --timer != 0U)
+        {
+            return;
+        }
+
+        timer = period;
+
+        if (increase && volume < 15U)
+        {
+            volume++;
+        }
+        else if (!increase && volume > 0U)
+        {
+            volume--;
+        }
+    }
+
+    void LengthCounter::Load(const u16 maximum, const u8 value)
+    {
+        counter = maximum - value;
+    }
+
+    void LengthCounter::Trigger(const u16 maximum)
+    {
+        if (counter == 0U)
+        {
+            counter = maximum;
+        }
+    }
+
+    bool LengthCounter::Clock()
+    {
+        return enabled && counter > 0U && --counter == 0U;
+    }
+
+    u64 SquareChannel::GetPeriod() const
+    {
+        return (2048ULL - frequency) * 4ULL;
+    }
+
+    i32 SquareChannel::GetLevel() const
+    {
+        if (!enabled || !dacEnabled)
+        {
+            return 0;
+        }
+
+        return ((GB_DUTY_PATTERNS[duty] >> dutyStep) & 1U) ? envelope.volume : 0;
+    }
+
+    void SquareChannel::Run(ChannelOutput& output, const u64 from, const u64 to)
+    {
+        const u64 period = GetPeriod();
+        u64 time = from + timer;
+
+        if (time >= to)
+        {
+            timer = time - to;
+            return;
+        }
+
+        if (!enabled || !dacEnabled || envelope.volume == 0U)
+        {
+            // Silent until the next register write or sequencer clock, only
+            // the duty position has to move on
+            const u64 steps = CountSteps(time, to, period);
+            dutyStep = (dutyStep + steps) & 7U;
+            timer = time + steps * period - to;
+            return;
+        }
+
+        while (time < to)
+        {
+            dutyStep = (dutyStep + 1U) & 7U;
+            output.Update(time, GetLevel());
+            time += period;
+        }
+
+        timer = time - to;
+    }
+
+    void SquareChannel::Trigger()
+    {
+        enabled = dacEnabled;
+        length.Trigger(GB_SQUARE_LENGTH_MAX);
+        timer = GetPeriod();
+
+        if (hasSweep)
+        {
+            shadowFrequency = frequency;
+            sweepTimer = sweepPeriod ? sweepPeriod : 8U;
+            sweepEnabled = sweepPeriod || sweepShift;
+
+            if (sweepShift)
+            {
+                CalculateSweep();
+            }
+        }
+    }
+
+    u16 SquareChannel::CalculateSweep()
+    {
+        const u16 change = shadowFrequency >> sweepShift;
+        const u16 result = sweepNegate ? shadowFrequency - change : shadowFrequency + change;
+
+        if (result > GB_FREQUENCY_MAX)
+        {
+            enabled = false;
+        }
+
+        return result;
+    }
+
+    void SquareChannel::ClockSweep()
+    {
+        if (--sweepTimer != 0U)
+        {
+            return;
+        }
+
+        sweepTimer = sweepPeriod ? sweepPeriod : 8U;
+
+        if (!sweepEnabled || sweepPeriod == 0U)
+        {
+            return;
+        }
+
+        const u16 result = CalculateSweep();
+        if (result <= GB_FREQUENCY_MAX && sweepShift)
+        {
+            frequency = result;
+            shadowFrequency = result;
+            CalculateSweep();
+        }
+    }
+
+    u64 WaveChannel::GetPeriod() const
+    {
+        return (2048ULL - frequency) * 2ULL;
+    }
+
+    i32 WaveChannel::GetLevel() const
+    {
+        if (!enabled || !dacEnabled || volumeCode == 0U)
+        {
+            return 0;
+        }
+
+        const u8 byte = waveRam[position >> 1U];
+        const u8 sample = (position & 1U) ? (byte & 0x0FU) : (byte >> 4U);
+        return sample >> (volumeCode - 1U);
+    }
+
+    void WaveChannel::Run(ChannelOutput& output, const u64 from, const u64 to)
+    {
+        const u64 period = GetPeriod();
+        u64 time = from + timer;
+
+        if (time >= to)
+        {
+            timer = time - to;
+            return;
+        }
+
+        if (!enabled || !dacEnabled || volumeCode == 0U)
+        {
+            const u64 steps = CountSteps(time, to, period);
+            position = (position + steps) & 31U;
+            timer = time + steps * period - to;
+            return;
+        }
+
+        while (time < to)
+        {
+            position = (position + 1U) & 31U;
+            output.Update(time, GetLevel());
+            time += period;
+        }
+
+        timer = time - to;
+    }
+
+    void WaveChannel::Trigger()
+    {
+        enabled = dacEnabled;
+        length.Trigger(GB_WAVE_LENGTH_MAX);
+        timer = GetPeriod();
+        position = 0U;
+    }
+
+    u64 NoiseChannel::GetPeriod() const
+    {
+        return static_cast<u64>(GB_NOISE_DIVISORS[divisorCode]) << clockShift;
+    }
+
+    i32 NoiseChannel::GetLevel() const
+    {
+        if (!enabled || !dacEnabled)
+        {
+            return 0;
+        }
+
+        return (lfsr & 1U) ? 0 : envelope.volume;
+    }
+
+    void NoiseChannel::Run(ChannelOutput& output, const u64 from, const u64 to)
+    {
+        const u64 period = GetPeriod();
+        u64 time = from + timer;
+
+        if (time >= to)
+        {
+            timer = time - to;
+            return;
+        }
+
+        // Shifts of 14 and 15 stop the LFSR, and a silent channel only needs
+        // its timer kept. The LFSR restarts on trigger anyway.
+        if (!enabled || !dacEnabled || envelope.volume == 0U || clockShift >= 14U)
+        {
+            timer = time + CountSteps(time, to, period) * period - to;
+            return;
+        }
+
+        while (time < to)
+        {
+            const u16 feedback = (lfsr ^ (lfsr >> 1U)) & 1U;
+            lfsr = (lfsr >> 1U) | (feedback << 14U);
+
+            if (narrow)
+            {
+                lfsr = (lfsr & ~(1U << 6U)) | (feedback << 6U);
+            }
+
+            output.Update(time, GetLevel());
+            time += period;
+        }
+
+        timer = time - to;
+    }
+
+    void NoiseChannel::Trigger()
+    {
+        enabled = dacEnabled;
+        length.Trigger(GB_SQUARE_LENGTH_MAX);
+        timer = GetPeriod();
+        lfsr = 0x7FFFU;
+    }
+
+    void Envelope::SaveState(StateWriter& writer) const
+    {
+        writer.Write(volume);
+        writer.Write(period);
+        writer.Write(timer);
+        writer.Write(increase);
+    }
+
+    void Envelope::LoadState(StateReader& reader)
+    {
+        volume = reader.Read<u8>();
+        period = reader.Read<u8>();
+        timer = reader.Read<u8>();
+        increase = reader.Read<bool>();
+    }
+
+    void LengthCounter::SaveState(StateWriter& writer) const
+    {
+        writer.Write(counter);
+        writer.Write(enabled);
+    }
+
+    void LengthCounter::LoadState(StateReader& reader)
+    {
+        counter = reader.Read<u16>();
+        enabled = reader.Read<bool>();
+    }
+
+    void SquareChannel::SaveState(StateWriter& writer) const
+    {
+        writer.Write(enabled);
+        writer.Write(dacEnabled);
+        writer.Write(duty);
+        writer.Write(dutyStep);
+        writer.Write(frequency);
+        writer.Write(timer);
+        envelope.SaveState(writer);
+        length.SaveState(writer);
+
+        writer.Write(sweepEnabled);
+        writer.Write(sweepNegate);
+        writer.Write(sweepPeriod);
+        writer.Write(sweepShift);
+        writer.Write(sweepTimer);
+        writer.Write(shadowFrequency);
+    }
+
+    void SquareChannel::LoadState(StateReader& reader)
+    {
+        enabled = reader.Read<bool>();
+        dacEnabled = reader.Read<bool>();
+        duty = reader.Read<u8>();
+        dutyStep = reader.Read<u8>();
+        frequency = reader.Read<u16>();
+        timer = reader.Read<u64>();
+        envelope.LoadState(reader);
+        length.LoadState(reader);
+
+        sweepEnabled = reader.Read<bool>();
+        sweepNegate = reader.Read<bool>();
+        sweepPeriod = reader.Read<u8>();
+        sweepShift = reader.Read<u8>();
+        sweepTimer = reader.Read<u8>();
+        shadowFrequency = reader.Read<u16>();
+    }
+
+    bool SquareChannel::IsValid() const
+    {
+        return duty < GB_DUTY_PATTERNS.size() && dutyStep < 8U && sweepShift < 8U;
+    }
+
+    void WaveChannel::SaveState(StateWriter& writer) const
+    {
+        writer.Write(enabled);
+        writer.Write(dacEnabled);
+        writer.Write(volumeCode);
+        writer.Write(position);
+        writer.Write(frequency);
+        writer.Write(timer);
+        length.SaveState(writer);
+    }
+
+    void WaveChannel::LoadState(StateReader& reader)
+    {
+        enabled = reader.Read<bool>();
+        dacEnabled = reader.Read<bool>();
+        volumeCode = reader.Read<u8>();
+        position = reader.Read<u8>();
+        frequency = reader.Read<u16>();
+        timer = reader.Read<u64>();
+        length.LoadState(reader);
+    }
+
+    bool WaveChannel::IsValid() const
+    {
+        return position < 32U && volumeCode < 4U;
+    }
+
+    void NoiseChannel::SaveState(StateWriter& writer) const
+    {
+        writer.Write(enabled);
+        writer.Write(dacEnabled);
+        writer.Write(divisorCode);
+        writer.Write(clockShift);
+        writer.Write(narrow);
+        writer.Write(lfsr);
+        writer.Write(timer);
+        envelope.SaveState(writer);
+        length.SaveState(writer);
+    }
+
+    void NoiseChannel::LoadState(StateReader& reader)
+    {
+        enabled = reader.Read<bool>();
+        dacEnabled = reader.Read<bool>();
+        divisorCode = reader.Read<u8>();
+        clockShift = reader.Read<u8>();
+        narrow = reader.Read<bool>();
+        lfsr = reader.Read<u16>();
+        timer = reader.Read<u64>();
+        envelope.LoadState(reader);
+        length.LoadState(reader);
+    }
+
+    bool NoiseChannel::IsValid() const
+    {
+        return divisorCode < GB_NOISE_DIVISORS.size() && clockShift < 16U;
+    }
+}
@@ -0,0 +1,50 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Audio/RateController.hpp"
+
+#include <algorithm>
+
+namespace GBcc
+{
+    // Fill is sampled once per frame and jumps by whole host callbacks,
+    // smooth it over roughly a quarter second
+    constexpr double GB_RATE_FILL_SMOOTHING = 1.0 / 16.0;
+
+    RateController::RateController(const double maxDeviation, const double targetFill) : 
+        m_MaxDeviation(maxDeviation),
+        m_TargetFill(targetFill),
+        m_SmoothedFill(targetFill) {}
+
+    double RateController::Update(const size_t fill, const size_t capacity)
+    {
+        const double fraction = static_cast<double>(fill) / capacity;
+        m_SmoothedFill += (fraction - m_SmoothedFill) * GB_RATE_FILL_SMOOTHING;
+
+        // Below the target produce a little more, above it a little less
+        const double error = (m_TargetFill - m_SmoothedFill) / m_TargetFill;
+        m_Ratio = 1.0 + std::clamp(error, -1.0, 1.0) * m_MaxDeviation;
+
+        return m_Ratio;
+    }
+
+    double RateController::GetRatio() const
+    {
+        return m_Ratio;
+    }
+}
@@ -0,0 +1,284 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Audio/Resampler.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define GBCC_RESAMPLER_X86 1
+#endif
+
+namespace GBcc
+{
+    // Catmull-Rom weights for the frames at -1, 0, 1 and 2
+    static inline void GetWeights(const float t, float weights[4])
+    {
+        const float t2 = t * t;
+        const float t3 = t2 * t;
+
+        weights[0] = 0.5f * (-t3 + 2.0f * t2 - t);
+        weights[1] = 0.5f * (3.0f * t3 - 5.0f * t2 + 2.0f);
+        weights[2] = 0.5f * (-3.0f * t3 + 4.0f * t2 + t);
+        weights[3] = 0.5f * (t3 - t2);
+    }
+
+    static inline i16 ToSample(const float value)
+    {
+        return static_cast<i16>(std::lrintf(std::clamp(value, -32768.0f, 32767.0f)));
+    }
+
+    Resampler::Resampler(const size_t maxInputFrames) : 
+        m_Input((maxInputFrames + HISTORY_FRAMES) * 2U, 0.0f),
+        m_Path(GetBestPath()) {}
+
+    ResamplerPath Resampler::GetBestPath()
+    {
+#if defined(GBCC_RESAMPLER_X86) && defined(__GNUC__)
+        if (__builtin_cpu_supports("avx"))
+        {
+            return ResamplerPath::AVX;
+        }
+        if (__builtin_cpu_supports("sse2"))
+        {
+            return ResamplerPath::SSE;
+        }
+#endif
+        return ResamplerPath::SCALAR;
+    }
+
+    void Resampler::SetRatio(const double inputPerOutput)
+    {
+        m_Step = static_cast<u64>(inputPerOutput * (1ULL << FRACTION_BITS));
+    }
+
+    void Resampler::SetPath(const ResamplerPath path)
+    {
+        m_Path = std::min(path, GetBestPath());
+    }
+
+    ResamplerPath Resampler::GetPath() const
+    {
+        return m_Path;
+    }
+
+    void Resampler::ConvertInput(const i16* in, const size_t frames)
+    {
+        float* const dst = m_Input.data() + m_InputFrames * 2U;
+        const size_t samples = frames * 2U;
+        size_t i = 0;
+
+#if defined(GBCC_RESAMPLER_X86)
+        if (m_Path != ResamplerPath::SCALAR)
+        {
+            for (; i + 8U <= samples; i += 8U)
+            {
+                const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+                const __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(packed, packed), 16);
+                const __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(packed, packed), 16);
+                _mm_storeu_ps(dst + i, _mm_cvtepi32_ps(low));
+                _mm_storeu_ps(dst + i + 4U, _mm_cvtepi32_ps(high));
+            }
+        }
+#endif
+
+        for (; i < samples; i++)
+        {
+            dst[i] = static_cast<float>(in[i]);
+        }
+
+        m_InputFrames += frames;
+    }
+
+    size_t Resampler::RunScalar(i16* out, const size_t maxFrames)
+    {
+        size_t produced = 0;
+
+        while (produced < maxFrames)
+        {
+            const size_t index = m_Position >> FRACTION_BITS;
+            if (index + HISTORY_FRAMES >= m_InputFrames)
+            {
+                break;
+            }
+
+            float weights[4];
+            GetWeights(static_cast<float>(static_cast<u32>(m_Position)) * (1.0f / 4294967296.0f), weights);
+
+            const float* const taps = m_Input.data() + index * 2U;
+            float left = 0.0f;
+            float right = 0.0f;
+
+            for (size_t tap = 0; tap < 4U; tap++)
+            {
+                left += taps[tap * 2U] * weights[tap];
+                right += taps[tap * 2U + 1U] * weights[tap];
+            }
+
+            out[produced * 2U] = ToSample(left);
+            out[produced * 2U + 1U] = ToSample(right);
+
+            produced++;
+            m_Position += m_Step;
+        }
+
+        return produced;
+    }
+
+#if defined(GBCC_RESAMPLER_X86)
+    // One output frame per iteration: the four stereo taps are two vectors
+    // of two frames each, weighted, summed and folded to a single L/R pair
+    __attribute__((target("sse2")))
+    size_t Resampler::RunSSE(i16* out, const size_t maxFrames)
+    {
+        size_t produced = 0;
+
+        while (produced < maxFrames)
+        {
+            const size_t index = m_Position >> FRACTION_BITS;
+            if (index + HISTORY_FRAMES >= m_InputFrames)
+            {
+                break;
+            }
+
+            float weights[4];
+            GetWeights(static_cast<float>(static_cast<u32>(m_Position)) * (1.0f / 4294967296.0f), weights);
+
+            const float* const taps = m_Input.data() + index * 2U;
+            const __m128 early = _mm_mul_ps(_mm_loadu_ps(taps), _mm_setr_ps(weights[0], weights[0], weights[1], weights[1]));
+            const __m128 late = _mm_mul_ps(_mm_loadu_ps(taps + 4U), _mm_setr_ps(weights[2], weights[2], weights[3], weights[3]));
+            const __m128 sum = _mm_add_ps(early, late);
+            const __m128 folded = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+
+            // Saturating pack of the rounded pair
+            const __m128i rounded = _mm_cvtps_epi32(folded);
+            const __m128i packed = _mm_packs_epi32(rounded, rounded);
+            const u32 pair = static_cast<u32>(_mm_cvtsi128_si32(packed));
+            out[produced * 2U] = static_cast<i16>(pair & 0xFFFFU);
+            out[produced * 2U + 1U] = static_cast<i16>(pair >> 16U);
+
+            produced++;
+            m_Position += m_Step;
+        }
+
+        return produced;
+    }
+
+    // Same as the SSE path with two output frames side by side, one per
+    // 128-bit lane
+    __attribute__((target("avx")))
+    size_t Resampler::RunAVX(i16* out, const size_t maxFrames)
+    {
+        size_t produced = 0;
+
+        while (produced + 2U <= maxFrames)
+        {
+            const u64 nextPosition = m_Position + m_Step;
+            const size_t index0 = m_Position >> FRACTION_BITS;
+            const size_t index1 = nextPosition >> FRACTION_BITS;
+            if (index1 + HISTORY_FRAMES >= m_InputFrames)
+            {
+                break;
+            }
+
+            float weights0[4];
+            float weights1[4];
+            GetWeights(static_cast<float>(static_cast<u32>(m_Position)) * (1.0f / 4294967296.0f), weights0);
+            GetWeights(static_cast<float>(static_cast<u32>(nextPosition)) * (1.0f / 4294967296.0f), weights1);
+
+            const float* const taps0 = m_Input.data() + index0 * 2U;
+            const float* const taps1 = m_Input.data() + index1 * 2U;
+
+            const __m256 early = _mm256_mul_ps(
+                _mm256_loadu2_m128(taps1, taps0),
+                _mm256_setr_ps(weights0[0], weights0[0], weights0[1], weights0[1], weights1[0], weights1[0], weights1[1], weights1[1])
+            );
+            const __m256 late = _mm256_mul_ps(
+                _mm256_loadu2_m128(taps1 + 4U, taps0 + 4U),
+                _mm256_setr_ps(weights0[2], weights0[2], weights0[3], weights0[3], weights1[2], weights1[2], weights1[3], weights1[3])
+            );
+            const __m256 sum = _mm256_add_ps(early, late);
+            const __m256 folded = _mm256_add_ps(sum, _mm256_permute_ps(sum, 0b01'00'11'10));
+
+            // Lanes now hold [L0 R0 . .] and [L1 R1 . .]
+            const __m128 pairs = _mm_movelh_ps(_mm256_castps256_ps128(folded), _mm256_extractf128_ps(folded, 1));
+            const __m128i rounded = _mm_cvtps_epi32(pairs);
+            const __m128i packed = _mm_packs_epi32(rounded, rounded);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out + produced * 2U), packed);
+
+            produced += 2U;
+            m_Position = nextPosition + m_Step;
+        }
+
+        // An odd frame left at the end of the block
+        return produced + RunSSE(out + produced * 2U, maxFrames - produced);
+    }
+#else
+    size_t Resampler::RunSSE(i16* out, const size_t maxFrames)
+    {
+        return RunScalar(out, maxFrames);
+    }
+
+    size_t Resampler::RunAVX(i16* out, const size_t maxFrames)
+    {
+        return RunScalar(out, maxFrames);
+    }
+#endif
+
+    size_t Resampler::Process(const i16* in, const size_t inFrames, i16* out, const size_t maxOutFrames)
+    {
+        size_t produced = 0;
+        size_t consumed = 0;
+        const size_t capacity = m_Input.size() / 2U;
+
+        while (consumed < inFrames)
+        {
+            const size_t frames = std::min(inFrames - consumed, capacity - m_InputFrames);
+            ConvertInput(in + consumed * 2U, frames);
+            consumed += frames;
+
+            switch (m_Path)
+            {
+                case ResamplerPath::AVX:
+                    produced += RunAVX(out + produced * 2U, maxOutFrames - produced);
+                    break;
+                case ResamplerPath::SSE:
+                    produced += RunSSE(out + produced * 2U, maxOutFrames - produced);
+                    break;
+                default:
+                    produced += RunScalar(out + produced * 2U, maxOutFrames - produced);
+                    break;
+            }
+
+            // Keep the frames the next position still needs
+            const size_t keepFrom = std::min(static_cast<size_t>(m_Position >> FRACTION_BITS), m_InputFrames);
+            std::copy(m_Input.begin() + keepFrom * 2U, m_Input.begin() + m_InputFrames * 2U, m_Input.begin());
+            m_InputFrames -= keepFrom;
+            m_Position -= static_cast<u64>(keepFrom) << FRACTION_BITS;
+
+            if (produced == maxOutFrames)
+            {
+                break;
+            }
+        }
+
+        return produced;
+    }
+}
@@ -0,0 +1,73 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "Core/Cartridge.hpp"
+#include "Utility.hpp"
+
+#include <fstream>
+#include <vector>
+
+namespace GBcc
+{
+    Cartridge::Cartridge()
+    {
+        std::fill(m_Rom.begin(), m_Rom.end(), 0x00U);
+        m_Hash = HashBytes(m_Rom.data(), m_Rom.size());
+    }
+
+    std::shared_ptr<const Cartridge> Cartridge::FromBytes(const u8* const data, const size_t size)
+    {
+        if (size == 0U || size > GB_ROM_SIZE)
+        {
+            return nullptr;
+        }
+
+        auto pCartridge = std::make_shared<Cartridge>();
+        std::copy(data, data + size, pCartridge->m_Rom.begin());
+        pCartridge->m_Hash = HashBytes(pCartridge->m_Rom.data(), pCartridge->m_Rom.size());
+        return pCartridge;
+    }
+
+    std::shared_ptr<const Cartridge> Cartridge::FromFile(const std::string& path)
+    {
+        std::ifstream romFile(path, std::ios::binary);
+
+        if (!romFile)
+        {
+            return nullptr;
+        }
+
+        // There is no mapper, anything past the first 32K is never mapped
+        std::vector<u8> data(GB_ROM_SIZE);
+        romFile.read(
+            reinterpret_cast<char *>(data.data()),
+            data.size()
+        );
+        return FromBytes(data.data(), romFile.gcount());
+    }
+
+    const std::shared_ptr<const Cartridge>& Cartridge::Empty()
+    {
+        static const std::shared_ptr<const Cartridge> empty = std::make_shared<Cartridge>();
+        return empty;
+    }
+
+    u64 Cartridge::GetHash() const
+    {
+        return m_Hash;
+    }
+}
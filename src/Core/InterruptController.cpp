@@ -0,0 +1,147 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Core/InterruptController.hpp"
+
+#include <bit>
+
+namespace GBcc
+{
+    void InterruptController::UpdateCache()
+    {
+        m_Pending = m_IE & m_IF & GB_INTERRUPT_MASK;
+        m_NeedsService = m_Pending || m_EnableDelay || m_Halted;
+    }
+
+    u8 InterruptController::ReadFlags() const
+    {
+        return m_IF | static_cast<u8>(~GB_INTERRUPT_MASK);
+    }
+
+    void InterruptController::WriteFlags(const u8 data)
+    {
+        m_IF = data & GB_INTERRUPT_MASK;
+        UpdateCache();
+    }
+
+    u8 InterruptController::ReadEnable() const
+    {
+        return m_IE;
+    }
+
+    void InterruptController::WriteEnable(const u8 data)
+    {
+        m_IE = data;
+        UpdateCache();
+    }
+
+    void InterruptController::Request(const u8 interrupt)
+    {
+        m_IF |= interrupt;
+        UpdateCache();
+    }
+
+    void InterruptController::EnableMaster(const bool delayed)
+    {
+        if (delayed)
+        {
+            // EI takes effect after the instruction that follows it, the
+            // delay is counted down at the start of the next two steps
+            if (!m_IME && !m_EnableDelay)
+            {
+                m_EnableDelay = 2U;
+            }
+        }
+        else
+        {
+            m_IME = true;
+            m_EnableDelay = 0U;
+        }
+
+        UpdateCache();
+    }
+
+    void InterruptController::DisableMaster()
+    {
+        m_IME = false;
+        m_EnableDelay = 0U;
+        UpdateCache();
+    }
+
+    bool InterruptController::MasterEnabled() const
+    {
+        return m_IME;
+    }
+
+    void InterruptController::StepEnableDelay()
+    {
+        if (m_EnableDelay && --m_EnableDelay == 0U)
+        {
+            m_IME = true;
+            UpdateCache();
+        }
+    }
+
+    void InterruptController::Halt()
+    {
+        m_Halted = true;
+        UpdateCache();
+    }
+
+    void InterruptController::Wake()
+    {
+        m_Halted = false;
+        UpdateCache();
+    }
+
+    bool InterruptController::IsHalted() const
+    {
+        return m_Halted;
+    }
+
+    u16 InterruptController::Acknowledge()
+    {
+        // Lowest bit has the highest priority, vectors are 8 bytes apart
+        const u8 bit = static_cast<u8>(std::countr_zero(m_Pending));
+
+        m_IF &= ~(1U << bit);
+        m_IME = false;
+        UpdateCache();
+
+        return GB_INTERRUPT_VECTOR_BASE + bit * GB_INTERRUPT_VECTOR_STRIDE;
+    }
+
+    void InterruptController::SaveState(StateWriter& writer) const
+    {
+        writer.Write(m_IF);
+        writer.Write(m_IE);
+        writer.Write(m_IME);
+        writer.Write(m_EnableDelay);
+        writer.Write(m_Halted);
+    }
+
+    void InterruptController::LoadState(StateReader& reader)
+    {
+        m_IF = reader.Read<u8>();
+        m_IE = reader.Read<u8>();
+        m_IME = reader.Read<bool>();
+        m_EnableDelay = reader.Read<u8>();
+        m_Halted = reader.Read<bool>();
+        UpdateCache();
+    }
+}
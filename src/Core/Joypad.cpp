@@ -0,0 +1,87 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Core/Joypad.hpp"
+
+namespace GBcc
+{
+    Joypad::Joypad(InterruptController& interrupts) : m_Interrupts(interrupts) {}
+
+    // Active low, a line reads 0 while a pressed button of a selected group
+    // pulls it down
+    u8 Joypad::GetLines() const
+    {
+        u8 lines = GB_P1_LINES_MASK;
+
+        if (!(m_Select & GB_P1_SELECT_DPAD))
+        {
+            lines &= ~m_Pressed;
+        }
+        if (!(m_Select & GB_P1_SELECT_BUTTONS))
+        {
+            lines &= ~(m_Pressed >> 4U);
+        }
+
+        return lines & GB_P1_LINES_MASK;
+    }
+
+    void Joypad::UpdateLines(const u8 previousLines)
+    {
+        // Any line going low interrupts
+        if (previousLines & ~GetLines())
+        {
+            m_Interrupts.Request(GB_INTERRUPT_JOYPAD);
+        }
+    }
+
+    u8 Joypad::ReadRegister() const
+    {
+        return GB_P1_UNUSED | m_Select | GetLines();
+    }
+
+    void Joypad::WriteRegister(const u8 data)
+    {
+        const u8 previousLines = GetLines();
+        m_Select = data & GB_P1_SELECT_MASK;
+        UpdateLines(previousLines);
+    }
+
+    void Joypad::SetButtons(const u8 pressed)
+    {
+        const u8 previousLines = GetLines();
+        m_Pressed = pressed;
+        UpdateLines(previousLines);
+    }
+
+    u8 Joypad::GetButtons() const
+    {
+        return m_Pressed;
+    }
+
+    void Joypad::SaveState(StateWriter& writer) const
+    {
+        writer.Write(m_Select);
+        writer.Write(m_Pressed);
+    }
+
+    void Joypad::LoadState(StateReader& reader)
+    {
+        m_Select = reader.Read<u8>();
+        m_Pressed = reader.Read<u8>();
+    }
+}
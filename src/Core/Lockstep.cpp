@@ -0,0 +1,958 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "Core/Lockstep.hpp"
+#include "Core/Sharp/SharpALU.hpp"
+
+#include <algorithm>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define GBCC_LOCKSTEP_X86 1
+#endif
+
+namespace GBcc
+{
+    namespace
+    {
+        enum OpcodeKind : u8
+        {
+            // Handed to Sharp
+            KIND_SLOW       = 0,
+            // Registers and immediates only, the same work for every lane
+            KIND_REGISTER   = 1,
+            // Also reads or writes ROM, WRAM or HRAM at a per-lane address
+            KIND_MEMORY     = 2
+        };
+
+        constexpr u8 ClassifyOpcode(const u8 opcode)
+        {
+            const u8 x = opcode >> 6U;
+            const u8 y = (opcode >> 3U) & 7U;
+            const u8 z = opcode & 7U;
+            const u8 p = y >> 1U;
+            const u8 q = y & 1U;
+
+            switch (x)
+            {
+                case 0:
+                    switch (z)
+                    {
+                        // NOP and JR, not LD (nn),SP or STOP
+                        case 0: return (y == 0U || y >= 3U) ? KIND_REGISTER : KIND_SLOW;
+                        case 1: return KIND_REGISTER;
+                        case 2: return KIND_MEMORY;
+                        case 3: return KIND_REGISTER;
+                        case 4:
+                        case 5:
+                        case 6: return y == 6U ? KIND_MEMORY : KIND_REGISTER;
+                        // DAA
+                        default: return y == 4U ? KIND_SLOW : KIND_REGISTER;
+                    }
+                case 1:
+                    if (opcode == GB_INSTR_HALT_OPCODE)
+                    {
+                        return KIND_SLOW;
+                    }
+                    return (y == 6U || z == 6U) ? KIND_MEMORY : KIND_REGISTER;
+                case 2:
+                    return z == 6U ? KIND_MEMORY : KIND_REGISTER;
+                default:
+                    switch (z)
+                    {
+                        // RET cc, LDH (n),A and LDH A,(n)
+                        case 0: return (y <= 4U || y == 6U) ? KIND_MEMORY : KIND_SLOW;
+                        // POP and RET, JP HL and LD SP,HL, not RETI
+                        case 1: return (q == 0U || p == 0U) ? KIND_MEMORY : (p == 1U ? KIND_SLOW : KIND_REGISTER);
+                        case 2: return y < 4U ? KIND_REGISTER : KIND_MEMORY;
+                        // JP nn, not CB, DI or EI
+                        case 3: return y == 0U ? KIND_REGISTER : KIND_SLOW;
+                        case 4: return y < 4U ? KIND_MEMORY : KIND_SLOW;
+                        case 5: return (q == 0U || p == 0U) ? KIND_MEMORY : KIND_SLOW;
+                        case 6: return KIND_REGISTER;
+                        default: return KIND_MEMORY;
+                    }
+            }
+        }
+
+        constexpr std::array<u8, 256U> OPCODE_KINDS = []()
+        {
+            std::array<u8, 256U> kinds = {};
+            for (size_t i = 0; i < kinds.size(); i++)
+            {
+                kinds[i] = ClassifyOpcode(static_cast<u8>(i));
+            }
+            return kinds;
+        }();
+
+        // Instructions and their operands are fetched from the shared ROM
+        constexpr u16 FAST_PC_END = 0x7FFDU;
+
+        struct AllLanes
+        {
+            size_t count;
+
+            inline size_t size() const { return count; }
+            inline size_t operator[](const size_t k) const { return k; }
+        };
+
+        struct LaneList
+        {
+            const u32* lanes;
+            size_t count;
+
+            inline size_t size() const { return count; }
+            inline size_t operator[](const size_t k) const { return lanes[k]; }
+        };
+
+        template <typename Lanes, typename Body>
+        inline void ForEachLane(const Lanes& lanes, Body body)
+        {
+            // The count is read once, the rows are u8 and alias anything
+            const size_t count = lanes.size();
+            for (size_t k = 0; k < count; k++)
+            {
+                body(lanes[k]);
+            }
+        }
+    }
+
+    Lockstep::Lockstep(const size_t laneCount) : 
+        m_Stride((laneCount + 63U) & ~static_cast<size_t>(63U)),
+        m_Registers(m_Stride * 8U, 0x00U),
+        m_SP(m_Stride, 0x0000U),
+        m_PC(m_Stride, 0x0000U),
+        m_Cycles(m_Stride, 0ULL),
+        m_Path(GetBestPath())
+    {
+        for (size_t i = 0; i < laneCount; i++)
+        {
+            m_Lanes.push_back(std::make_unique<System>());
+            m_WorkRam.push_back(m_Lanes.back()->GetMemory().GetWorkRam());
+            m_HighRam.push_back(m_Lanes.back()->GetMemory().GetHighRam());
+        }
+
+        m_pRom = Cartridge::Empty()->GetData();
+        m_Active.reserve(laneCount);
+        m_Fallback.reserve(laneCount);
+    }
+
+    bool Lockstep::LoadRom(const u8* const data, const size_t size)
+    {
+        std::shared_ptr<const Cartridge> pCartridge = Cartridge::FromBytes(data, size);
+
+        if (!pCartridge)
+        {
+            return false;
+        }
+
+        for (auto& lane : m_Lanes)
+        {
+            lane->LoadCartridge(pCartridge);
+        }
+        m_pRom = pCartridge->GetData();
+        return true;
+    }
+
+    size_t Lockstep::GetLaneCount() const
+    {
+        return m_Lanes.size();
+    }
+
+    System& Lockstep::GetLane(const size_t lane)
+    {
+        return *m_Lanes[lane];
+    }
+
+    LockstepPath Lockstep::GetBestPath()
+    {
+#if defined(GBCC_LOCKSTEP_X86)
+        if (__builtin_cpu_supports("avx512bw"))
+        {
+            return LockstepPath::AVX512;
+        }
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return LockstepPath::AVX2;
+        }
+#endif
+        return LockstepPath::BASELINE;
+    }
+
+    void Lockstep::SetPath(const LockstepPath path)
+    {
+        m_Path = std::min(path, GetBestPath());
+    }
+
+    LockstepPath Lockstep::GetPath() const
+    {
+        return m_Path;
+    }
+
+    const LockstepStats& Lockstep::GetStats() const
+    {
+        return m_Stats;
+    }
+
+    bool Lockstep::IsRegisterOpcode(const u8 opcode)
+    {
+        return OPCODE_KINDS[opcode] == KIND_REGISTER;
+    }
+
+    inline u8* Lockstep::Row(const size_t reg)
+    {
+        return m_Registers.data() + reg * m_Stride;
+    }
+
+    void Lockstep::LoadLane(const u32 lane)
+    {
+        const SharpRegisterFile registers = m_Lanes[lane]->GetRegisterFile();
+
+        Row(REG_A)[lane] = registers.a;
+        Row(REG_F)[lane] = registers.f;
+        Row(REG_B)[lane] = registers.b;
+        Row(REG_C)[lane] = registers.c;
+        Row(REG_D)[lane] = registers.d;
+        Row(REG_E)[lane] = registers.e;
+        Row(REG_H)[lane] = registers.h;
+        Row(REG_L)[lane] = registers.l;
+        m_SP[lane] = registers.sp;
+        m_PC[lane] = registers.pc;
+        m_Cycles[lane] = registers.cycles;
+    }
+
+    void Lockstep::StoreLane(const u32 lane)
+    {
+        m_Lanes[lane]->SetRegisterFile({
+            Row(REG_A)[lane], Row(REG_F)[lane], 
+            Row(REG_B)[lane], Row(REG_C)[lane], 
+            Row(REG_D)[lane], Row(REG_E)[lane], 
+            Row(REG_H)[lane], Row(REG_L)[lane], 
+            m_SP[lane], m_PC[lane], m_Cycles[lane]
+        });
+    }
+
+    const u8* Lockstep::Readable(const u32 lane, const u16 address) const
+    {
+        if (address <= GB_CART_SPACE_END)
+        {
+            return m_pRom + address;
+        }
+        return Writable(lane, address);
+    }
+
+    u8* Lockstep::Writable(const u32 lane, const u16 address) const
+    {
+        // WRAM and its echo, then HRAM
+        if (address >= 0xC000U && address <= 0xFDFFU)
+        {
+            return m_WorkRam[lane] + ((address - 0xC000U) & 0x1FFFU);
+        }
+        if (address >= 0xFF80U && address <= 0xFFFEU)
+        {
+            return m_HighRam[lane] + (address - 0xFF80U);
+        }
+        return nullptr;
+    }
+
+    void Lockstep::RunFrame()
+    {
+        m_Active.clear();
+
+        for (u32 lane = 0; lane < m_Lanes.size(); lane++)
+        {
+            m_Lanes[lane]->BeginFrame();
+            LoadLane(lane);
+            m_Active.push_back(lane);
+        }
+
+        while (!m_Active.empty())
+        {
+            Step();
+        }
+    }
+
+    void Lockstep::Step()
+    {
+        size_t kept = 0;
+        m_Fallback.clear();
+
+        for (const u32 lane : m_Active)
+        {
+            System& system = *m_Lanes[lane];
+
+            // Sharp is up to date after a fallback step, and the registers
+            // are stored before dispatching
+            if (system.FrameDone())
+            {
+                continue;
+            }
+
+            if (m_Cycles[lane] >= system.GetNextEventCycle())
+            {
+                StoreLane(lane);
+                system.DispatchEvents();
+
+                if (!system.FrameDone())
+                {
+                    m_Active[kept++] = lane;
+                }
+                continue;
+            }
+
+            m_Active[kept++] = lane;
+
+            const u16 pc = m_PC[lane];
+            const u8 opcode = pc <= FAST_PC_END ? m_pRom[pc] : 0x00U;
+
+            if (pc > FAST_PC_END || system.InterruptPending() || OPCODE_KINDS[opcode] == KIND_SLOW)
+            {
+                m_Fallback.push_back(lane);
+                continue;
+            }
+
+            auto& group = m_Groups[opcode];
+            if (group.empty())
+            {
+                m_UsedOpcodes.push_back(opcode);
+            }
+            group.push_back(lane);
+        }
+
+        m_Active.resize(kept);
+
+        const bool uniform = (
+            m_UsedOpcodes.size() == 1U && 
+            m_Groups[m_UsedOpcodes[0]].size() == m_Lanes.size() && 
+            OPCODE_KINDS[m_UsedOpcodes[0]] == KIND_REGISTER
+        );
+
+        if (uniform)
+        {
+            // Every lane is active, so the group is 0 to N - 1 in order
+            RunUniform(m_UsedOpcodes[0]);
+            m_Stats.uniform += m_Lanes.size();
+        }
+        else
+        {
+            for (const u8 opcode : m_UsedOpcodes)
+            {
+                const auto& group = m_Groups[opcode];
+
+                if (OPCODE_KINDS[opcode] == KIND_REGISTER)
+                {
+                    RunRegisterOp(opcode, LaneList{group.data(), group.size()});
+                    m_Stats.grouped += group.size();
+                    continue;
+                }
+
+                for (const u32 lane : group)
+                {
+                    if (RunMemoryOp(opcode, lane))
+                    {
+                        m_Stats.grouped++;
+                    }
+                    else
+                    {
+                        m_Fallback.push_back(lane);
+                    }
+                }
+            }
+        }
+
+        for (const u8 opcode : m_UsedOpcodes)
+        {
+            m_Groups[opcode].clear();
+        }
+        m_UsedOpcodes.clear();
+
+        for (const u32 lane : m_Fallback)
+        {
+            StoreLane(lane);
+            m_Lanes[lane]->Step();
+            LoadLane(lane);
+        }
+        m_Stats.fallback += m_Fallback.size();
+    }
+
+    void Lockstep::RunUniform(const u8 opcode)
+    {
+        switch (m_Path)
+        {
+            case LockstepPath::AVX512:
+                RunUniformAVX512(opcode);
+                break;
+            case LockstepPath::AVX2:
+                RunUniformAVX2(opcode);
+                break;
+            default:
+                RunRegisterOp(opcode, AllLanes{m_Lanes.size()});
+                break;
+        }
+    }
+
+#if defined(GBCC_LOCKSTEP_X86)
+    // Same loops, flattened into a function built for the wider unit
+    __attribute__((target("avx2"), flatten))
+    void Lockstep::RunUniformAVX2(const u8 opcode)
+    {
+        RunRegisterOp(opcode, AllLanes{m_Lanes.size()});
+    }
+
+    __attribute__((target("avx2,avx512f,avx512bw"), flatten))
+    void Lockstep::RunUniformAVX512(const u8 opcode)
+    {
+        RunRegisterOp(opcode, AllLanes{m_Lanes.size()});
+    }
+#else
+    void Lockstep::RunUniformAVX2(const u8 opcode)
+    {
+        RunRegisterOp(opcode, AllLanes{m_Lanes.size()});
+    }
+
+    void Lockstep::RunUniformAVX512(const u8 opcode)
+    {
+        RunRegisterOp(opcode, AllLanes{m_Lanes.size()});
+    }
+#endif
+
+    template <typename Lanes>
+    void Lockstep::RunRegisterOp(const u8 opcode, const Lanes& lanes)
+    {
+        const u8 x = opcode >> 6U;
+        const u8 y = (opcode >> 3U) & 7U;
+        const u8 z = opcode & 7U;
+        const u8 p = y >> 1U;
+        const u8 q = y & 1U;
+        const u64 cost = GB_INSTR_CYCLES[opcode];
+
+        u8* const a = Row(REG_A);
+        u8* const f = Row(REG_F);
+        u8* const h = Row(REG_H);
+        u8* const l = Row(REG_L);
+        u16* const pc = m_PC.data();
+        u16* const sp = m_SP.data();
+        u64* const cycles = m_Cycles.data();
+        const u8* const rom = m_pRom;
+
+        // Pairs in opcode order, SP in the last slot
+        u8* const high = p == 3U ? nullptr : Row(p * 2U);
+        u8* const low = p == 3U ? nullptr : Row(p * 2U + 1U);
+
+        auto Next = [pc, cycles, cost](const size_t i, const u16 length)
+        {
+            pc[i] += length;
+            cycles[i] += cost;
+        };
+
+        if (x == 1U)
+        {
+            // LD r, r'
+            const u8* const source = Row(z);
+            u8* const destination = Row(y);
+            ForEachLane(lanes, [&](const size_t i) { destination[i] = source[i]; Next(i, 1U); });
+        }
+        else if (x == 2U || (x == 3U && z == 6U))
+        {
+            // ALU A, r and ALU A, n
+            const bool immediate = x == 3U;
+            const u8* const source = immediate ? nullptr : Row(z);
+
+            switch (y)
+            {
+                case GB_INSTR_ADD_OPCODE:
+                    ForEachLane(lanes, [&](const size_t i) { SharpALU::Accumulate(GB_INSTR_ADD_OPCODE, a[i], f[i], immediate ? rom[pc[i] + 1U] : source[i]); Next(i, immediate ? 2U : 1U); });
+                    break;
+                case GB_INSTR_ADC_OPCODE:
+                    ForEachLane(lanes, [&](const size_t i) { SharpALU::Accumulate(GB_INSTR_ADC_OPCODE, a[i], f[i], immediate ? rom[pc[i] + 1U] : source[i]); Next(i, immediate ? 2U : 1U); });
+                    break;
+                case GB_INSTR_SUB_OPCODE:
+                    ForEachLane(lanes, [&](const size_t i) { SharpALU::Accumulate(GB_INSTR_SUB_OPCODE, a[i], f[i], immediate ? rom[pc[i] + 1U] : source[i]); Next(i, immediate ? 2U : 1U); });
+                    break;
+                case GB_INSTR_SBC_OPCODE:
+                    ForEachLane(lanes, [&](const size_t i) { SharpALU::Accumulate(GB_INSTR_SBC_OPCODE, a[i], f[i], immediate ? rom[pc[i] + 1U] : source[i]); Next(i, immediate ? 2U : 1U); });
+                    break;
+                case GB_INSTR_AND_OPCODE:
+                    ForEachLane(lanes, [&](const size_t i) { SharpALU::Accumulate(GB_INSTR_AND_OPCODE, a[i], f[i], immediate ? rom[pc[i] + 1U] : source[i]); Next(i, immediate ? 2U : 1U); });
+                    break;
+                case GB_INSTR_XOR_OPCODE:
+                    ForEachLane(lanes, [&](const size_t i) { SharpALU::Accumulate(GB_INSTR_XOR_OPCODE, a[i], f[i], immediate ? rom[pc[i] + 1U] : source[i]); Next(i, immediate ? 2U : 1U); });
+                    break;
+                case GB_INSTR_OR_OPCODE:
+                    ForEachLane(lanes, [&](const size_t i) { SharpALU::Accumulate(GB_INSTR_OR_OPCODE, a[i], f[i], immediate ? rom[pc[i] + 1U] : source[i]); Next(i, immediate ? 2U : 1U); });
+                    break;
+                default:
+                    ForEachLane(lanes, [&](const size_t i) { SharpALU::Accumulate(GB_INSTR_CP_OPCODE, a[i], f[i], immediate ? rom[pc[i] + 1U] : source[i]); Next(i, immediate ? 2U : 1U); });
+                    break;
+            }
+        }
+        else if (x == 0U)
+        {
+            switch (z)
+            {
+                case 0:
+                    if (y == 0U)
+                    {
+                        // NOP
+                        ForEachLane(lanes, [&](const size_t i) { Next(i, 1U); });
+                    }
+                    else
+                    {
+                        // JR e and JR cc, e
+                        const bool always = y == 3U;
+                        const u8 code = y - 4U;
+                        ForEachLane(lanes, [&](const size_t i)
+                        {
+                            const bool taken = always || SharpALU::Condition(f[i], code);
+                            const i8 offset = static_cast<i8>(rom[pc[i] + 1U]);
+                            pc[i] += 2U + (taken ? offset : 0);
+                            cycles[i] += cost + (taken ? 4U : 0U);
+                        });
+                    }
+                    break;
+                case 1:
+                    if (q == 0U)
+                    {
+                        // LD rr, nn
+                        ForEachLane(lanes, [&](const size_t i)
+                        {
+                            const u16 value = rom[pc[i] + 1U] | (rom[pc[i] + 2U] << 8U);
+                            if (high)
+                            {
+                                high[i] = value >> 8U;
+                                low[i] = value & 0xFFU;
+                            }
+                            else
+                            {
+                                sp[i] = value;
+                            }
+                            Next(i, 3U);
+                        });
+                    }
+                    else
+                    {
+                        // ADD HL, rr
+                        ForEachLane(lanes, [&](const size_t i)
+                        {
+                            const u16 hl = (h[i] << 8U) | l[i];
+                            const u16 value = high ? ((high[i] << 8U) | low[i]) : sp[i];
+                            const u16 result = SharpALU::AddDouble(hl, value, f[i]);
+                            h[i] = (result >> 8U) & 0xFFU;
+                            l[i] = result & 0xFFU;
+                            Next(i, 1U);
+                        });
+                    }
+                    break;
+                case 3:
+                {
+                    // INC rr and DEC rr
+                    const u16 delta = q ? 0xFFFFU : 0x0001U;
+                    ForEachLane(lanes, [&](const size_t i)
+                    {
+                        if (high)
+                        {
+                            const u16 value = ((high[i] << 8U) | low[i]) + delta;
+                            high[i] = value >> 8U;
+                            low[i] = value & 0xFFU;
+                        }
+                        else
+                        {
+                            sp[i] += delta;
+                        }
+                        Next(i, 1U);
+                    });
+                }
+                    break;
+                case 4:
+                {
+                    u8* const reg = Row(y);
+                    ForEachLane(lanes, [&](const size_t i) { reg[i] = SharpALU::Increment(reg[i], f[i]); Next(i, 1U); });
+                }
+                    break;
+                case 5:
+                {
+                    u8* const reg = Row(y);
+                    ForEachLane(lanes, [&](const size_t i) { reg[i] = SharpALU::Decrement(reg[i], f[i]); Next(i, 1U); });
+                }
+                    break;
+                case 6:
+                {
+                    // LD r, n
+                    u8* const reg = Row(y);
+                    ForEachLane(lanes, [&](const size_t i) { reg[i] = rom[pc[i] + 1U]; Next(i, 2U); });
+                }
+                    break;
+                default:
+                    switch (y)
+                    {
+                        case GB_INSTR_ALU_OP_RLCA:
+                            ForEachLane(lanes, [&](const size_t i)
+                            {
+                                a[i] = SharpALU::RotateLeft(a[i], true, f[i]);
+                                f[i] &= ~SharpALU::FLAG_ZERO;
+                                Next(i, 1U);
+                            });
+                            break;
+                        case GB_INSTR_ALU_OP_RRCA:
+                            ForEachLane(lanes, [&](const size_t i)
+                            {
+                                a[i] = SharpALU::RotateRight(a[i], true, f[i]);
+                                f[i] &= ~SharpALU::FLAG_ZERO;
+                                Next(i, 1U);
+                            });
+                            break;
+                        case GB_INSTR_ALU_OP_RLA:
+                            ForEachLane(lanes, [&](const size_t i)
+                            {
+                                a[i] = SharpALU::RotateLeft(a[i], false, f[i]);
+                                f[i] &= ~SharpALU::FLAG_ZERO;
+                                Next(i, 1U);
+                            });
+                            break;
+                        case GB_INSTR_ALU_OP_RRA:
+                            ForEachLane(lanes, [&](const size_t i)
+                            {
+                                a[i] = SharpALU::RotateRight(a[i], false, f[i]);
+                                f[i] &= ~SharpALU::FLAG_ZERO;
+                                Next(i, 1U);
+                            });
+                            break;
+                        case GB_INSTR_ALU_OP_CPLA:
+                            ForEachLane(lanes, [&](const size_t i) { a[i] = SharpALU::Complement(a[i], f[i]); Next(i, 1U); });
+                            break;
+                        case GB_INSTR_ALU_OP_SCF:
+                            ForEachLane(lanes, [&](const size_t i) { SharpALU::SetCarry(f[i]); Next(i, 1U); });
+                            break;
+                        default:
+                            ForEachLane(lanes, [&](const size_t i) { SharpALU::ComplementCarry(f[i]); Next(i, 1U); });
+                            break;
+                    }
+                    break;
+            }
+        }
+        else if (z == 2U || opcode == 0xC3U)
+        {
+            // JP nn and JP cc, nn
+            const bool always = opcode == 0xC3U;
+            ForEachLane(lanes, [&](const size_t i)
+            {
+                const bool taken = always || SharpALU::Condition(f[i], y);
+                const u16 target = rom[pc[i] + 1U] | (rom[pc[i] + 2U] << 8U);
+                pc[i] = taken ? target : pc[i] + 3U;
+                cycles[i] += cost + (taken ? 4U : 0U);
+            });
+        }
+        else if (opcode == 0xE9U)
+        {
+            // JP HL
+            ForEachLane(lanes, [&](const size_t i) { pc[i] = (h[i] << 8U) | l[i]; cycles[i] += cost; });
+        }
+        else
+        {
+            // LD SP, HL
+            ForEachLane(lanes, [&](const size_t i) { sp[i] = (h[i] << 8U) | l[i]; Next(i, 1U); });
+        }
+    }
+
+    bool Lockstep::RunMemoryOp(const u8 opcode, const u32 lane)
+    {
+        const u8 x = opcode >> 6U;
+        const u8 y = (opcode >> 3U) & 7U;
+        const u8 z = opcode & 7U;
+        const u8 p = y >> 1U;
+        const u8 q = y & 1U;
+
+        u8& a = Row(REG_A)[lane];
+        u8& f = Row(REG_F)[lane];
+        u8& h = Row(REG_H)[lane];
+        u8& l = Row(REG_L)[lane];
+        u16& pc = m_PC[lane];
+        u16& sp = m_SP[lane];
+        u64& cycles = m_Cycles[lane];
+
+        const u16 hl = (h << 8U) | l;
+        const u8 n = m_pRom[pc + 1U];
+        const u16 nn = n | (m_pRom[pc + 2U] << 8U);
+        u64 cost = GB_INSTR_CYCLES[opcode];
+        u16 next = pc + 1U;
+
+        auto Pair = [this, lane](const u8 index) -> u16
+        {
+            return (Row(index * 2U)[lane] << 8U) | Row(index * 2U + 1U)[lane];
+        };
+
+        auto SetPair = [this, lane](const u8 index, const u16 value)
+        {
+            Row(index * 2U)[lane] = value >> 8U;
+            Row(index * 2U + 1U)[lane] = value & 0xFFU;
+        };
+
+        // Stack accesses are two bytes that may sit in different regions
+        auto Push = [this, lane, &sp](const u16 value) -> bool
+        {
+            u8* const low = Writable(lane, sp - 2U);
+            u8* const high = Writable(lane, sp - 1U);
+            if (!low || !high)
+            {
+                return false;
+            }
+            *low = value & 0xFFU;
+            *high = value >> 8U;
+            sp -= 2U;
+            return true;
+        };
+
+        auto Pop = [this, lane, &sp](u16& value) -> bool
+        {
+            const u8* const low = Readable(lane, sp);
+            const u8* const high = Readable(lane, sp + 1U);
+            if (!low || !high)
+            {
+                return false;
+            }
+            value = *low | (*high << 8U);
+            sp += 2U;
+            return true;
+        };
+
+        if (x == 0U)
+        {
+            if (z == 2U)
+            {
+                // LD (rr), A and LD A, (rr), HL moves after the access
+                const u16 address = p < 2U ? Pair(p) : hl;
+                if (q == 0U)
+                {
+                    u8* const target = Writable(lane, address);
+                    if (!target)
+                    {
+                        return false;
+                    }
+                    *target = a;
+                }
+                else
+                {
+                    const u8* const source = Readable(lane, address);
+                    if (!source)
+                    {
+                        return false;
+                    }
+                    a = *source;
+                }
+
+                if (p == 2U)
+                {
+                    SetPair(2U, hl + 1U);
+                }
+                else if (p == 3U)
+                {
+                    SetPair(2U, hl - 1U);
+                }
+            }
+            else
+            {
+                // INC (HL), DEC (HL) and LD (HL), n
+                u8* const target = Writable(lane, hl);
+                if (!target)
+                {
+                    return false;
+                }
+
+                if (z == 4U)
+                {
+                    *target = SharpALU::Increment(*target, f);
+                }
+                else if (z == 5U)
+                {
+                    *target = SharpALU::Decrement(*target, f);
+                }
+                else
+                {
+                    *target = n;
+                    next = pc + 2U;
+                }
+            }
+        }
+        else if (x == 1U)
+        {
+            if (z == 6U)
+            {
+                // LD r, (HL)
+                const u8* const source = Readable(lane, hl);
+                if (!source)
+                {
+                    return false;
+                }
+                Row(y)[lane] = *source;
+            }
+            else
+            {
+                // LD (HL), r
+                u8* const target = Writable(lane, hl);
+                if (!target)
+                {
+                    return false;
+                }
+                *target = Row(z)[lane];
+            }
+        }
+        else if (x == 2U)
+        {
+            // ALU A, (HL)
+            const u8* const source = Readable(lane, hl);
+            if (!source)
+            {
+                return false;
+            }
+            SharpALU::Accumulate(y, a, f, *source);
+        }
+        else
+        {
+            switch (z)
+            {
+                case 0:
+                    if (y <= GB_CPU_MAX_COND_CODE)
+                    {
+                        // RET cc
+                        if (SharpALU::Condition(f, y))
+                        {
+                            u16 target;
+                            if (!Pop(target))
+                            {
+                                return false;
+                            }
+                            next = target;
+                            cost += 12U;
+                        }
+                    }
+                    else
+                    {
+                        // LDH (n), A and LDH A, (n)
+                        const u16 address = GB_MMIO_BASE_ADDRESS | n;
+                        if (y == 4U)
+                        {
+                            u8* const target = Writable(lane, address);
+                            if (!target)
+                            {
+                                return false;
+                            }
+                            *target = a;
+                        }
+                        else
+                        {
+                            const u8* const source = Readable(lane, address);
+                            if (!source)
+                            {
+                                return false;
+                            }
+                            a = *source;
+                        }
+                        next = pc + 2U;
+                    }
+                    break;
+                case 1:
+                {
+                    u16 value;
+                    if (!Pop(value))
+                    {
+                        return false;
+                    }
+
+                    if (q)
+                    {
+                        // RET
+                        next = value;
+                        cost += 12U;
+                    }
+                    else if (p == 3U)
+                    {
+                        // POP AF, the low nibble of F does not exist
+                        a = value >> 8U;
+                        f = value & 0xF0U;
+                    }
+                    else
+                    {
+                        SetPair(p, value);
+                    }
+                }
+                    break;
+                case 2:
+                {
+                    // LD (C), A, LD (nn), A, LD A, (C) and LD A, (nn)
+                    const u16 address = q ? nn : (GB_MMIO_BASE_ADDRESS | Row(REG_C)[lane]);
+                    if (y == 4U || y == 5U)
+                    {
+                        u8* const target = Writable(lane, address);
+                        if (!target)
+                        {
+                            return false;
+                        }
+                        *target = a;
+                    }
+                    else
+                    {
+                        const u8* const source = Readable(lane, address);
+                        if (!source)
+                        {
+                            return false;
+                        }
+                        a = *source;
+                    }
+                    next = pc + (q ? 3U : 1U);
+                }
+                    break;
+                case 4:
+                case 5:
+                    if (z == 5U && q == 0U)
+                    {
+                        // PUSH rr
+                        const u16 value = p == 3U ? ((a << 8U) | f) : Pair(p);
+                        if (!Push(value))
+                        {
+                            return false;
+                        }
+                    }
+                    else
+                    {
+                        // CALL nn and CALL cc, nn
+                        next = pc + 3U;
+                        if (z == 5U || SharpALU::Condition(f, y))
+                        {
+                            if (!Push(next))
+                            {
+                                return false;
+                            }
+                            next = nn;
+                            cost += 12U;
+                        }
+                    }
+                    break;
+                default:
+                    // RST
+                    if (!Push(pc + 1U))
+                    {
+                        return false;
+                    }
+                    next = y * 8U;
+                    break;
+            }
+        }
+
+        pc = next;
+        cycles += cost;
+        return true;
+    }
+}
@@ -19,66 +19,152 @@
 #include "Core/Memory.hpp"
 
 #include <string>
-#include <fstream>
 #include <iostream>
 
 namespace GBcc
 {
-    Memory::Memory()
+    Memory::Memory(PPU* const pPPU, Timer* const pTimer, APU* const pAPU, InterruptController* const pInterrupts, Joypad* const pJoypad) : 
+        m_pPPU(pPPU), 
+        m_pTimer(pTimer), 
+        m_pAPU(pAPU), 
+        m_pInterrupts(pInterrupts),
+        m_pJoypad(pJoypad)
     {
-        std::string testRomPath = "../roms/cpu_instrs/individual/10-bit ops.gb";
-        std::ifstream testRomFile(testRomPath, std::ios::binary);
+        LoadCartridge(Cartridge::Empty());
 
-        testRomFile.read(
-            reinterpret_cast<char *>(m_Rom.data()),
-            m_Rom.size()
-        );
-
-        std::string bootRomPath = "../roms/dmg_boot.bin";
-        std::ifstream bootRomFile(bootRomPath, std::ios::binary);
-
-        bootRomFile.read(
-            reinterpret_cast<char *>(m_BootRom.data()),
-            m_BootRom.size()
-        );
+        // Execution starts after the boot ROM, so it is never mapped and not
+        // loaded from disk
         m_BootRomEnable = false;
 
         std::fill(m_HighRam.begin(), m_HighRam.end(), 0x00U);
         std::fill(m_WorkRam.begin(), m_WorkRam.end(), 0x00U);
-        std::fill(m_VideoRam.begin(), m_VideoRam.end(), 0x00U);
+        std::fill(m_IO_Ram.begin(), m_IO_Ram.end(), 0x00U);
+        std::fill(m_SerialRegs.begin(), m_SerialRegs.end(), 0x00U);
     }
 
-    u8 Memory::ReadWord(const u16 address)
+    std::span<const u8> Memory::GetView(const u16 address, const u16 size) const
     {
-        u16 trueAddress;
-        if (address < GB_BOOTROM_SIZE)
+        const u32 end = static_cast<u32>(address) + size;
+
+        if (address >= 0xC000U && end <= 0xE000U)
         {
-            if (m_BootRomEnable)
-            {
-                return m_BootRom[address];
-            }
-            else
-            {
-                return m_Rom[address];
-            }
+            return { m_WorkRam.data() + (address - 0xC000U), size };
+        }
+        if (address >= 0xFF80U && end <= 0xFFFFU)
+        {
+            return { m_HighRam.data() + (address - 0xFF80U), size };
+        }
+        return {};
+    }
+
+    u8* Memory::GetWorkRam()
+    {
+        return m_WorkRam.data();
+    }
+
+    u8* Memory::GetHighRam()
+    {
+        return m_HighRam.data();
+    }
+
+    void Memory::SetSerialCapture(const bool capture)
+    {
+        m_CaptureSerial = capture;
+    }
+
+    const std::string& Memory::GetSerialOutput() const
+    {
+        return m_SerialOutput;
+    }
+
+    void Memory::ClearSerialOutput()
+    {
+        m_SerialOutput.clear();
+    }
+
+    bool Memory::LoadRom(const std::string& path)
+    {
+        std::shared_ptr<const Cartridge> pCartridge = Cartridge::FromFile(path);
+
+        if (!pCartridge)
+        {
+            return false;
+        }
+
+        LoadCartridge(pCartridge);
+        return true;
+    }
+
+    bool Memory::LoadRom(const u8* const data, const size_t size)
+    {
+        std::shared_ptr<const Cartridge> pCartridge = Cartridge::FromBytes(data, size);
+
+        if (!pCartridge)
+        {
+            return false;
+        }
+
+        LoadCartridge(pCartridge);
+        return true;
+    }
+
+    void Memory::LoadCartridge(const std::shared_ptr<const Cartridge>& pCartridge)
+    {
+        m_pCartridge = pCartridge;
+        m_pRom = m_pCartridge->GetData();
+    }
+
+    const std::shared_ptr<const Cartridge>& Memory::GetCartridge() const
+    {
+        return m_pCartridge;
+    }
+
+    u64 Memory::GetRomHash() const
+    {
+        return m_pCartridge->GetHash();
+    }
+
+    void Memory::TransferOAM(const u8 sourcePage)
+    {
+        // The whole transfer lands at once instead of over 160 M-cycles
+        std::array<u8, GB_OAM_SIZE> oamData;
+        const u16 sourceAddress = static_cast<u16>(sourcePage) << 8U;
+
+        for (size_t i = 0; i < GB_OAM_SIZE; i++)
+        {
+            oamData[i] = ReadWord(sourceAddress + i);
         }
-        else if (address <= GB_CART_SPACE_END)
+
+        m_pPPU->TransferOAM(oamData);
+    }
+
+    u8 Memory::ReadWord(const u16 address)
+    {
+        u16 trueAddress;
+        if (address <= GB_CART_SPACE_END)
         {
-            return m_Rom[address];
+            return m_pRom[address];
         }
-        else if (address >= 0x8000U && address <= 0x9FFFU)
+        else if (address >= GB_VRAM_BEGIN && address <= GB_VRAM_END)
         {
-            trueAddress = address - 0x8000U;
-            return m_VideoRam[trueAddress];
+            return m_pPPU->ReadVideoRam(address);
         }
         else if (address >= 0xC000U && address <= 0xFDFFU)
         {
             trueAddress = address - 0xC000U - (address >= 0xE000 ? 0x2000U : 0U);
             return m_WorkRam[trueAddress];
         }
+        else if (address >= GB_OAM_BEGIN && address <= GB_OAM_END)
+        {
+            return m_pPPU->ReadOAM(address);
+        }
         else if (address >= 0xFF00 && address <= 0xFF7F)
         {
-            if (address == 0xFF01)
+            if (address == GB_REG_P1)
+            {
+                return m_pJoypad->ReadRegister();
+            }
+            else if (address == 0xFF01)
             {
                 return m_SerialRegs[0];
             }
@@ -86,9 +172,21 @@ namespace GBcc
             {
                 return m_SerialRegs[1];
             }
-            else if (address == 0xFF44)
+            else if (address >= GB_TIMER_REGS_BEGIN && address <= GB_TIMER_REGS_END)
+            {
+                return m_pTimer->ReadRegister(address);
+            }
+            else if (address == GB_INTERRUPT_FLAG_REGISTER)
             {
-                return 0x90;
+                return m_pInterrupts->ReadFlags();
+            }
+            else if (address >= GB_APU_REGS_BEGIN && address <= GB_APU_REGS_END)
+            {
+                return m_pAPU->ReadRegister(address);
+            }
+            else if (address >= GB_PPU_REGS_BEGIN && address <= GB_PPU_REGS_END)
+            {
+                return m_pPPU->ReadRegister(address);
             }
             else
             {
@@ -101,6 +199,10 @@ namespace GBcc
             trueAddress = address - 0xFF80;
             return m_HighRam[trueAddress];
         }
+        else if (address == GB_INTERRUPT_ENABLE_REGISTER)
+        {
+            return m_pInterrupts->ReadEnable();
+        }
 
         return 0;
     }
@@ -116,30 +218,65 @@ namespace GBcc
     void Memory::WriteWord(const u16 address, const u8 data)
     {
         u16 trueAddress;
-        if (address >= 0x8000U && address <= 0x9FFFU)
+        if (address >= GB_VRAM_BEGIN && address <= GB_VRAM_END)
         {
-            trueAddress = address - 0x8000U;
-            m_VideoRam[trueAddress] = data;
+            m_pPPU->WriteVideoRam(address, data);
         } 
         else if (address >= 0xC000U && address <= 0xFDFFU)
         {
             trueAddress = address - 0xC000U - (address >= 0xE000 ? 0x2000U : 0U);
             m_WorkRam[trueAddress] = data;
         }
+        else if (address >= GB_OAM_BEGIN && address <= GB_OAM_END)
+        {
+            m_pPPU->WriteOAM(address, data);
+        }
         else if (address >= 0xFF00 && address <= 0xFF7F)
         {
             if (address == 0xFF50)
             {
                 m_BootRomEnable = false;
             }
+            else if (address == GB_REG_P1)
+            {
+                m_pJoypad->WriteRegister(data);
+            }
             else if (address == 0xFF01)
             {
                 m_SerialRegs[0] = data;
             }
             else if (address == 0xFF02 && data == 0x81)
             {
-                char c = m_SerialRegs[0];
-                std::cout << c;
+                const char c = m_SerialRegs[0];
+                if (m_CaptureSerial)
+                {
+                    m_SerialOutput.push_back(c);
+                }
+                else
+                {
+                    std::cout << c;
+                }
+            }
+            else if (address >= GB_TIMER_REGS_BEGIN && address <= GB_TIMER_REGS_END)
+            {
+                m_pTimer->WriteRegister(address, data);
+            }
+            else if (address == GB_INTERRUPT_FLAG_REGISTER)
+            {
+                m_pInterrupts->WriteFlags(data);
+            }
+            else if (address >= GB_APU_REGS_BEGIN && address <= GB_APU_REGS_END)
+            {
+                m_pAPU->WriteRegister(address, data);
+            }
+            else if (address >= GB_PPU_REGS_BEGIN && address <= GB_PPU_REGS_END)
+            {
+                m_pPPU->WriteRegister(address, data);
+
+                if (address == GB_OAM_DMA_REGISTER)
+                {
+                    TransferOAM(data);
+                }
             }
             else
             {
@@ -152,6 +289,10 @@ namespace GBcc
             trueAddress = address - 0xFF80;
             m_HighRam[trueAddress] = data;
         }
+        else if (address == GB_INTERRUPT_ENABLE_REGISTER)
+        {
+            m_pInterrupts->WriteEnable(data);
+        }
     }
 
     void Memory::WriteDoubleWord(const u16 address, const u16 data)
@@ -159,4 +300,22 @@ namespace GBcc
         WriteWord(address    , (data & 0x00FF));
         WriteWord(address + 1, (data & 0xFF00) >> 8U);
     }
+
+    void Memory::SaveState(StateWriter& writer) const
+    {
+        writer.WriteBytes(m_WorkRam.data(), m_WorkRam.size());
+        writer.WriteBytes(m_HighRam.data(), m_HighRam.size());
+        writer.WriteBytes(m_IO_Ram.data(), m_IO_Ram.size());
+        writer.WriteBytes(m_SerialRegs.data(), m_SerialRegs.size());
+        writer.Write(m_BootRomEnable);
+    }
+
+    void Memory::LoadState(StateReader& reader)
+    {
+        reader.ReadBytes(m_WorkRam.data(), m_WorkRam.size());
+        reader.ReadBytes(m_HighRam.data(), m_HighRam.size());
+        reader.ReadBytes(m_IO_Ram.data(), m_IO_Ram.size());
+        reader.ReadBytes(m_SerialRegs.data(), m_SerialRegs.size());
+        m_BootRomEnable = reader.Read<bool>();
+    }
 }
\ No newline at end of file
@@ -0,0 +1,148 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Core/Movie.hpp"
+
+#include <fstream>
+
+namespace GBcc
+{
+    template <typename T>
+    static void WriteValue(std::ofstream& file, const T value)
+    {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    static bool ReadValue(std::ifstream& file, T& value)
+    {
+        return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+    }
+
+    void Movie::Begin(const u64 romHash, const u8* state, const size_t stateSize)
+    {
+        m_RomHash = romHash;
+        m_StartState.assign(state, state + stateSize);
+        m_Inputs.clear();
+    }
+
+    u64 Movie::GetRomHash() const
+    {
+        return m_RomHash;
+    }
+
+    bool Movie::StartsAtPowerOn() const
+    {
+        return m_StartState.empty();
+    }
+
+    const std::vector<u8>& Movie::GetStartState() const
+    {
+        return m_StartState;
+    }
+
+    bool Movie::Save(const std::string& path) const
+    {
+        std::ofstream file(path, std::ios::binary);
+        if (!file)
+        {
+            return false;
+        }
+
+        WriteValue(file, GB_MOVIE_MAGIC);
+        WriteValue(file, GB_MOVIE_VERSION);
+        WriteValue(file, m_RomHash);
+        WriteValue(file, static_cast<u32>(m_StartState.size()));
+        file.write(reinterpret_cast<const char*>(m_StartState.data()), m_StartState.size());
+        WriteValue(file, static_cast<u32>(m_Inputs.size()));
+
+        size_t frame = 0;
+        while (frame < m_Inputs.size())
+        {
+            const u8 buttons = m_Inputs[frame];
+            u16 run = 0U;
+
+            while (frame < m_Inputs.size() && m_Inputs[frame] == buttons && run < UINT16_MAX)
+            {
+                frame++;
+                run++;
+            }
+
+            WriteValue(file, buttons);
+            WriteValue(file, run);
+        }
+
+        return static_cast<bool>(file);
+    }
+
+    bool Movie::Load(const std::string& path)
+    {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        const std::streamoff length = file.tellg();
+        file.seekg(0);
+        u32 magic;
+        u16 version;
+        u32 stateSize;
+        u32 frames;
+
+        if (!ReadValue(file, magic) || magic != GB_MOVIE_MAGIC || 
+            !ReadValue(file, version) || version != GB_MOVIE_VERSION || 
+            !ReadValue(file, m_RomHash) || !ReadValue(file, stateSize))
+        {
+            return false;
+        }
+
+        // Sizes are checked against what is left of the file before
+        // anything is allocated for them
+        if (stateSize > length - file.tellg())
+        {
+            return false;
+        }
+
+        m_StartState.resize(stateSize);
+        if (!file.read(reinterpret_cast<char*>(m_StartState.data()), stateSize) || !ReadValue(file, frames))
+        {
+            return false;
+        }
+
+        // Each run takes 3 bytes and covers at most UINT16_MAX frames
+        const u64 runs = static_cast<u64>(length - file.tellg()) / (sizeof(u8) + sizeof(u16));
+        if (frames > runs * UINT16_MAX)
+        {
+            return false;
+        }
+
+        m_Inputs.clear();
+        m_Inputs.reserve(frames);
+
+        while (m_Inputs.size() < frames)
+        {
+            u8 buttons;
+            u16 run;
+
+            if (!ReadValue(file, buttons) || !ReadValue(file, run) || run == 0U || m_Inputs.size() + run > frames)
+            {
+                return false;
+            }
+
+            m_Inputs.insert(m_Inputs.end(), run, buttons);
+        }
+
+        return true;
+    }
+}
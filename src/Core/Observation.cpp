@@ -0,0 +1,253 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "Core/Observation.hpp"
+#include "Video/VideoConstants.hpp"
+
+#include <algorithm>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define GBCC_OBSERVATION_X86 1
+#endif
+
+namespace GBcc
+{
+    static constexpr size_t WIDTH = VideoConstants::GAMEBOY_SCREEN_WIDTH;
+    static constexpr size_t HEIGHT = VideoConstants::GAMEBOY_SCREEN_HEIGHT;
+
+    // Shades are 0-3, so 85 * shade is the two bits repeated four times
+    static inline u8 ToGray(const u8 shade)
+    {
+        return 0xFFU - shade * 85U;
+    }
+
+    static inline u8 Average(const u8 a, const u8 b)
+    {
+        return static_cast<u8>((a + b + 1U) >> 1U);
+    }
+
+    ObservationEncoder::ObservationEncoder() : m_Path(GetBestPath()) {}
+
+    size_t ObservationEncoder::GetSize(const ObservationFormat format)
+    {
+        switch (format)
+        {
+            case ObservationFormat::GRAYSCALE:
+                return WIDTH * HEIGHT;
+            case ObservationFormat::GRAYSCALE_HALF:
+                return (WIDTH / 2U) * (HEIGHT / 2U);
+            default:
+                return 0U;
+        }
+    }
+
+    ObservationPath ObservationEncoder::GetBestPath()
+    {
+#if defined(GBCC_OBSERVATION_X86) && defined(__GNUC__)
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return ObservationPath::AVX2;
+        }
+        if (__builtin_cpu_supports("sse2"))
+        {
+            return ObservationPath::SSE2;
+        }
+#endif
+        return ObservationPath::SCALAR;
+    }
+
+    void ObservationEncoder::SetPath(const ObservationPath path)
+    {
+        m_Path = std::min(path, GetBestPath());
+    }
+
+    ObservationPath ObservationEncoder::GetPath() const
+    {
+        return m_Path;
+    }
+
+    bool ObservationEncoder::Encode(const ObservationFormat format, const PPU::Framebuffer& frame, std::span<u8> out)
+    {
+        if (format == ObservationFormat::NONE || out.size() < GetSize(format))
+        {
+            return false;
+        }
+
+        switch (m_Path)
+        {
+            case ObservationPath::AVX2:
+                EncodeAVX2(format, frame.data(), out.data());
+                break;
+            case ObservationPath::SSE2:
+                EncodeSSE2(format, frame.data(), out.data());
+                break;
+            default:
+                EncodeScalar(format, frame.data(), out.data());
+                break;
+        }
+        return true;
+    }
+
+    void ObservationEncoder::EncodeScalar(const ObservationFormat format, const u8* const frame, u8* const out)
+    {
+        if (format == ObservationFormat::GRAYSCALE)
+        {
+            for (size_t i = 0; i < WIDTH * HEIGHT; i++)
+            {
+                out[i] = ToGray(frame[i]);
+            }
+            return;
+        }
+
+        // Rows first, then columns, rounding each time like pavgb
+        for (size_t y = 0; y < HEIGHT / 2U; y++)
+        {
+            const u8* const top = frame + y * 2U * WIDTH;
+            const u8* const bottom = top + WIDTH;
+
+            for (size_t x = 0; x < WIDTH / 2U; x++)
+            {
+                const u8 left = Average(ToGray(top[x * 2U]), ToGray(bottom[x * 2U]));
+                const u8 right = Average(ToGray(top[x * 2U + 1U]), ToGray(bottom[x * 2U + 1U]));
+                out[y * (WIDTH / 2U) + x] = Average(left, right);
+            }
+        }
+    }
+
+#if defined(GBCC_OBSERVATION_X86)
+    // Shades never carry out of their byte, so 16-bit shifts spread the two
+    // bits over the byte and a final XOR turns 85 * shade into the gray
+    __attribute__((target("sse2")))
+    static inline __m128i ToGraySSE2(const __m128i shades)
+    {
+        const __m128i twice = _mm_or_si128(shades, _mm_slli_epi16(shades, 2));
+        const __m128i spread = _mm_or_si128(twice, _mm_slli_epi16(twice, 4));
+        return _mm_xor_si128(spread, _mm_set1_epi8(static_cast<char>(0xFF)));
+    }
+
+    __attribute__((target("sse2")))
+    void ObservationEncoder::EncodeSSE2(const ObservationFormat format, const u8* const frame, u8* const out)
+    {
+        if (format == ObservationFormat::GRAYSCALE)
+        {
+            for (size_t i = 0; i < WIDTH * HEIGHT; i += 16U)
+            {
+                const __m128i shades = _mm_loadu_si128(reinterpret_cast<const __m128i*>(frame + i));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), ToGraySSE2(shades));
+            }
+            return;
+        }
+
+        const __m128i lowBytes = _mm_set1_epi16(0x00FF);
+
+        // 32 pixels of two rows become 16 output pixels
+        for (size_t y = 0; y < HEIGHT / 2U; y++)
+        {
+            const u8* const top = frame + y * 2U * WIDTH;
+            const u8* const bottom = top + WIDTH;
+            u8* const row = out + y * (WIDTH / 2U);
+
+            for (size_t x = 0; x < WIDTH; x += 32U)
+            {
+                __m128i halves[2];
+                for (size_t half = 0; half < 2U; half++)
+                {
+                    const __m128i upper = ToGraySSE2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(top + x + half * 16U)));
+                    const __m128i lower = ToGraySSE2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bottom + x + half * 16U)));
+                    const __m128i rows = _mm_avg_epu8(upper, lower);
+                    halves[half] = _mm_avg_epu16(_mm_and_si128(rows, lowBytes), _mm_srli_epi16(rows, 8));
+                }
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(row + x / 2U), _mm_packus_epi16(halves[0], halves[1]));
+            }
+        }
+    }
+
+    __attribute__((target("avx2")))
+    static inline __m256i ToGrayAVX2(const __m256i shades)
+    {
+        const __m256i twice = _mm256_or_si256(shades, _mm256_slli_epi16(shades, 2));
+        const __m256i spread = _mm256_or_si256(twice, _mm256_slli_epi16(twice, 4));
+        return _mm256_xor_si256(spread, _mm256_set1_epi8(static_cast<char>(0xFF)));
+    }
+
+    __attribute__((target("avx2")))
+    void ObservationEncoder::EncodeAVX2(const ObservationFormat format, const u8* const frame, u8* const out)
+    {
+        if (format == ObservationFormat::GRAYSCALE)
+        {
+            for (size_t i = 0; i < WIDTH * HEIGHT; i += 32U)
+            {
+                const __m256i shades = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(frame + i));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), ToGrayAVX2(shades));
+            }
+            return;
+        }
+
+        const __m256i lowBytes = _mm256_set1_epi16(0x00FF);
+
+        // 64 pixels of two rows become 32 output pixels, the remaining 32
+        // of each 160 pixel row take the SSE2 width
+        for (size_t y = 0; y < HEIGHT / 2U; y++)
+        {
+            const u8* const top = frame + y * 2U * WIDTH;
+            const u8* const bottom = top + WIDTH;
+            u8* const row = out + y * (WIDTH / 2U);
+            size_t x = 0;
+
+            for (; x + 64U <= WIDTH; x += 64U)
+            {
+                __m256i halves[2];
+                for (size_t half = 0; half < 2U; half++)
+                {
+                    const __m256i upper = ToGrayAVX2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(top + x + half * 32U)));
+                    const __m256i lower = ToGrayAVX2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(bottom + x + half * 32U)));
+                    const __m256i rows = _mm256_avg_epu8(upper, lower);
+                    halves[half] = _mm256_avg_epu16(_mm256_and_si256(rows, lowBytes), _mm256_srli_epi16(rows, 8));
+                }
+
+                // The pack works per 128-bit lane, put the quarters back in order
+                const __m256i packed = _mm256_packus_epi16(halves[0], halves[1]);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(row + x / 2U), _mm256_permute4x64_epi64(packed, 0b11'01'10'00));
+            }
+
+            for (; x < WIDTH; x += 32U)
+            {
+                __m128i halves[2];
+                for (size_t half = 0; half < 2U; half++)
+                {
+                    const __m128i upper = ToGraySSE2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(top + x + half * 16U)));
+                    const __m128i lower = ToGraySSE2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bottom + x + half * 16U)));
+                    const __m128i rows = _mm_avg_epu8(upper, lower);
+                    halves[half] = _mm_avg_epu16(_mm_and_si128(rows, _mm256_castsi256_si128(lowBytes)), _mm_srli_epi16(rows, 8));
+                }
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(row + x / 2U), _mm_packus_epi16(halves[0], halves[1]));
+            }
+        }
+    }
+#else
+    void ObservationEncoder::EncodeSSE2(const ObservationFormat format, const u8* const frame, u8* const out)
+    {
+        EncodeScalar(format, frame, out);
+    }
+
+    void ObservationEncoder::EncodeAVX2(const ObservationFormat format, const u8* const frame, u8* const out)
+    {
+        EncodeScalar(format, frame, out);
+    }
+#endif
+}
@@ -0,0 +1,107 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Core/PPU/FramePipeline.hpp"
+
+#include <algorithm>
+
+namespace GBcc
+{
+    FramePipeline::FramePipeline(const RasterRegisters& registers) : m_Renderer(registers)
+    {
+        std::fill(m_WorkFramebuffer.begin(), m_WorkFramebuffer.end(), 0x00U);
+        m_Renderer.SetTarget(&m_WorkFramebuffer);
+        m_Worker = std::thread(&FramePipeline::WorkerLoop, this);
+    }
+
+    FramePipeline::~FramePipeline()
+    {
+        if (m_Worker.joinable())
+        {
+            Renderer::Framebuffer discarded;
+            Stop(discarded);
+        }
+    }
+
+    void FramePipeline::WorkerLoop()
+    {
+        while (true)
+        {
+            FrameSnapshot* const snapshot = m_Snapshots.Front();
+
+            if (snapshot->stop)
+            {
+                m_Snapshots.Pop();
+                break;
+            }
+
+            m_Renderer.SetSource({
+                snapshot->videoRam.data(),
+                snapshot->oam.data(),
+                &snapshot->spriteIndex,
+                &snapshot->rasterLog
+            });
+
+            m_Renderer.RenderLinesUntil(snapshot->endCycle);
+            m_Renderer.ConsumeRasterLog();
+
+            if (snapshot->endOfFrame)
+            {
+                m_Renderer.BeginFrame();
+
+                Renderer::Framebuffer* const frame = m_Frames.BeginPush();
+                *frame = m_WorkFramebuffer;
+                m_Frames.EndPush();
+            }
+
+            m_Snapshots.Pop();
+        }
+    }
+
+    FrameSnapshot* FramePipeline::BeginSubmit(Renderer::Framebuffer& output)
+    {
+        CollectFrames(output);
+        return m_Snapshots.BeginPush();
+    }
+
+    void FramePipeline::Submit()
+    {
+        m_Snapshots.EndPush();
+    }
+
+    void FramePipeline::CollectFrames(Renderer::Framebuffer& output)
+    {
+        while (Renderer::Framebuffer* const frame = m_Frames.TryFront())
+        {
+            output = *frame;
+            m_Frames.Pop();
+        }
+    }
+
+    const RasterRegisters& FramePipeline::Stop(Renderer::Framebuffer& output)
+    {
+        FrameSnapshot* const snapshot = BeginSubmit(output);
+        snapshot->stop = true;
+        Submit();
+
+        m_Worker.join();
+        CollectFrames(output);
+
+        return m_Renderer.GetRegisters();
+    }
+}
@@ -0,0 +1,517 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Core/PPU/PPU.hpp"
+#include "Core/PPU/FramePipeline.hpp"
+#include "Core/MemoryConstants.hpp"
+#include "Core/InterruptConstants.hpp"
+#include "Utility.hpp"
+
+#include <algorithm>
+
+namespace GBcc
+{
+    // Cycle, register and value
+    constexpr size_t GB_RASTER_LOG_ENTRY_STATE_SIZE = sizeof(u32) + 2U * sizeof(u8);
+
+    PPU::PPU(Scheduler& scheduler, InterruptController& interrupts) : 
+        m_Scheduler(scheduler), 
+        m_Interrupts(interrupts), 
+        m_Renderer(m_Registers)
+    {
+        std::fill(m_VideoRam.begin(), m_VideoRam.end(), 0x00U);
+        std::fill(m_OAM.begin(), m_OAM.end(), 0x00U);
+        std::fill(m_Framebuffer.begin(), m_Framebuffer.end(), 0x00U);
+
+        m_Renderer.SetSource({ m_VideoRam.data(), m_OAM.data(), &m_SpriteIndex, &m_RasterLog });
+        m_Renderer.SetTarget(&m_Framebuffer);
+
+        m_Scheduler.Schedule(SchedulerEvent::FRAME_END, m_FrameStart + GB_CYCLES_PER_FRAME);
+        m_Scheduler.Schedule(SchedulerEvent::PPU_MODE, m_FrameStart + GB_OAM_SCAN_CYCLES);
+    }
+
+    PPU::~PPU() = default;
+
+    u8 PPU::ReadVideoRam(const u16 address) const
+    {
+        return m_VideoRam[address - GB_VRAM_BEGIN];
+    }
+
+    void PPU::WriteVideoRam(const u16 address, const u8 data)
+    {
+        u8& byte = m_VideoRam[address - GB_VRAM_BEGIN];
+        m_InputsChanged |= byte != data;
+        byte = data;
+    }
+
+    u8 PPU::ReadOAM(const u16 address) const
+    {
+        return m_OAM[address - GB_OAM_BEGIN];
+    }
+
+    void PPU::WriteOAM(const u16 address, const u8 data)
+    {
+        const u8 offset = address - GB_OAM_BEGIN;
+        m_InputsChanged |= m_OAM[offset] != data;
+        m_OAM[offset] = data;
+        m_SpriteIndex.OnOamWrite(offset, data);
+    }
+
+    void PPU::TransferOAM(const std::array<u8, GB_OAM_SIZE>& data)
+    {
+        m_InputsChanged |= m_OAM != data;
+        m_OAM = data;
+        m_SpriteIndex.OnOamTransfer(m_OAM);
+    }
+
+    u8 PPU::ReadRegister(const u16 address) const
+    {
+        switch (address)
+        {
+            case GB_REG_LCDC:
+                return m_Registers[RASTER_LCDC];
+            case GB_REG_STAT:
+                return m_STAT | (m_LY == m_LYC ? GB_STAT_COINCIDENCE : 0x00U) | m_Mode;
+            case GB_REG_SCY:
+                return m_Registers[RASTER_SCY];
+            case GB_REG_SCX:
+                return m_Registers[RASTER_SCX];
+            case GB_REG_LY:
+                return m_LY;
+            case GB_REG_LYC:
+                return m_LYC;
+            case GB_REG_DMA:
+                return m_DMA;
+            case GB_REG_BGP:
+                return m_Registers[RASTER_BGP];
+            case GB_REG_OBP0:
+                return m_Registers[RASTER_OBP0];
+            case GB_REG_OBP1:
+                return m_Registers[RASTER_OBP1];
+            case GB_REG_WY:
+                return m_Registers[RASTER_WY];
+            case GB_REG_WX:
+                return m_Registers[RASTER_WX];
+            default:
+                return 0xFFU;
+        }
+    }
+
+    void PPU::WriteRegister(const u16 address, const u8 data)
+    {
+        switch (address)
+        {
+            case GB_REG_LCDC:
+                WriteLCDC(data);
+                break;
+            case GB_REG_STAT:
+                m_STAT = 0x80U | (data & GB_STAT_WRITABLE);
+                UpdateStatLine();
+                break;
+            case GB_REG_SCY:
+                WriteRasterRegister(RASTER_SCY, data);
+                break;
+            case GB_REG_SCX:
+                WriteRasterRegister(RASTER_SCX, data);
+                break;
+            case GB_REG_LYC:
+                m_LYC = data;
+                UpdateStatLine();
+                break;
+            case GB_REG_DMA:
+                m_DMA = data;
+                break;
+            case GB_REG_BGP:
+                WriteRasterRegister(RASTER_BGP, data);
+                break;
+            case GB_REG_OBP0:
+                WriteRasterRegister(RASTER_OBP0, data);
+                break;
+            case GB_REG_OBP1:
+                WriteRasterRegister(RASTER_OBP1, data);
+                break;
+            case GB_REG_WY:
+                WriteRasterRegister(RASTER_WY, data);
+                break;
+            case GB_REG_WX:
+                WriteRasterRegister(RASTER_WX, data);
+                break;
+        }
+    }
+
+    u32 PPU::GetFrameCycle() const
+    {
+        return static_cast<u32>(m_Scheduler.Now() - m_FrameStart);
+    }
+
+    bool PPU::LCDEnabled() const
+    {
+        return m_Registers[RASTER_LCDC] & GB_LCDC_LCD_ENABLE;
+    }
+
+    void PPU::WriteLCDC(const u8 data)
+    {
+        const bool wasEnabled = LCDEnabled();
+        const bool enable = data & GB_LCDC_LCD_ENABLE;
+
+        if (wasEnabled && !enable)
+        {
+            m_LY = 0x00U;
+            m_Mode = PPU_MODE_HBLANK;
+            m_Scheduler.Deschedule(SchedulerEvent::PPU_MODE);
+        }
+        else if (!wasEnabled && enable)
+        {
+            // The LCD starts again from line 0, so the blank frame ends here
+            // and the next one is timed from this write
+            if (m_InputsChanged)
+            {
+                FlushRasterLog(UINT32_MAX, true);
+            }
+
+            m_FrameStart = m_Scheduler.Now();
+            m_LY = 0x00U;
+            m_Mode = PPU_MODE_OAM_SCAN;
+            m_Scheduler.Schedule(SchedulerEvent::FRAME_END, m_FrameStart + GB_CYCLES_PER_FRAME);
+            m_Scheduler.Schedule(SchedulerEvent::PPU_MODE, m_FrameStart + GB_OAM_SCAN_CYCLES);
+        }
+
+        WriteRasterRegister(RASTER_LCDC, data);
+        UpdateStatLine();
+    }
+
+    void PPU::UpdateStatLine()
+    {
+        const bool line = LCDEnabled() && (
+            ((m_STAT & GB_STAT_LYC_INTERRUPT) && m_LY == m_LYC) ||
+            ((m_STAT & GB_STAT_HBLANK_INTERRUPT) && m_Mode == PPU_MODE_HBLANK) ||
+            ((m_STAT & GB_STAT_VBLANK_INTERRUPT) && m_Mode == PPU_MODE_VBLANK) ||
+            ((m_STAT & GB_STAT_OAM_INTERRUPT) && m_Mode == PPU_MODE_OAM_SCAN)
+        );
+
+        // The sources are ORed into one line, only its rising edge interrupts
+        if (line && !m_StatLine)
+        {
+            m_Interrupts.Request(GB_INTERRUPT_STAT);
+        }
+
+        m_StatLine = line;
+    }
+
+    void PPU::HandleModeEvent(const u64 timestamp)
+    {
+        u64 next = timestamp;
+
+        switch (m_Mode)
+        {
+            case PPU_MODE_OAM_SCAN:
+                m_Mode = PPU_MODE_TRANSFER;
+                next += GB_TRANSFER_CYCLES;
+                break;
+            case PPU_MODE_TRANSFER:
+                m_Mode = PPU_MODE_HBLANK;
+                next += GB_HBLANK_CYCLES;
+                break;
+            case PPU_MODE_HBLANK:
+                m_LY++;
+                if (m_LY == GB_VBLANK_FIRST_LINE)
+                {
+                    // Finish the frame before the VBlank handler starts
+                    // changing VRAM, OAM and registers for the next one
+                    RenderFrame();
+                    m_Mode = PPU_MODE_VBLANK;
+                    m_Interrupts.Request(GB_INTERRUPT_VBLANK);
+                    next += GB_CYCLES_PER_LINE;
+                }
+                else
+                {
+                    m_Mode = PPU_MODE_OAM_SCAN;
+                    next += GB_OAM_SCAN_CYCLES;
+                }
+                break;
+            case PPU_MODE_VBLANK:
+                m_LY++;
+                if (m_LY == GB_LINES_PER_FRAME)
+                {
+                    m_LY = 0x00U;
+                    m_Mode = PPU_MODE_OAM_SCAN;
+                    next += GB_OAM_SCAN_CYCLES;
+                }
+                else
+                {
+                    next += GB_CYCLES_PER_LINE;
+                }
+                break;
+        }
+
+        m_Scheduler.Schedule(SchedulerEvent::PPU_MODE, next);
+        UpdateStatLine();
+    }
+
+    void PPU::WriteRasterRegister(const RasterRegister reg, const u8 data)
+    {
+        if (m_Registers[reg] == data)
+        {
+            return;
+        }
+
+        const u32 cycle = GetFrameCycle();
+
+        if (m_RasterLog.IsFull()) [[unlikely]]
+        {
+            // Render up to this write so the log can start over. In VBlank
+            // the frame is done and the log only holds the next frame's
+            // starting values.
+            FlushRasterLog(m_Mode == PPU_MODE_VBLANK ? 0U : cycle, false);
+        }
+
+        m_Registers[reg] = data;
+        m_RasterLog.Record(cycle, reg, data);
+        m_InputsChanged = true;
+    }
+
+    void PPU::FlushRasterLog(const u32 endCycle, const bool endOfFrame)
+    {
+        if (m_pPipeline)
+        {
+            FrameSnapshot* const snapshot = m_pPipeline->BeginSubmit(m_Framebuffer);
+            snapshot->videoRam = m_VideoRam;
+            snapshot->oam = m_OAM;
+            snapshot->spriteIndex = m_SpriteIndex;
+            snapshot->rasterLog = m_RasterLog;
+            snapshot->endCycle = endCycle;
+            snapshot->endOfFrame = endOfFrame;
+            snapshot->stop = false;
+            m_pPipeline->Submit();
+        }
+        else
+        {
+            m_Renderer.RenderLinesUntil(endCycle);
+            m_Renderer.ConsumeRasterLog();
+
+            if (endOfFrame)
+            {
+                m_Renderer.BeginFrame();
+            }
+        }
+
+        m_RasterLog.Clear();
+    }
+
+    void PPU::RenderFrame()
+    {
+        if (!m_InputsChanged)
+        {
+            // Pipelined frames are compared when they are collected
+            if (!m_pPipeline)
+            {
+                m_FrameChanged = false;
+            }
+            return;
+        }
+
+        FlushRasterLog(UINT32_MAX, true);
+        m_InputsChanged = false;
+
+        if (!m_pPipeline)
+        {
+            const u64 previousHash = m_FrameHash;
+            m_FrameHash = HashBytes(m_Framebuffer.data(), m_Framebuffer.size());
+            m_FrameChanged = m_FrameHash != previousHash;
+        }
+    }
+
+    void PPU::EndFrame()
+    {
+        if (!LCDEnabled())
+        {
+            // There is no VBlank with the LCD off, the frame ends here
+            RenderFrame();
+        }
+        else if (m_RasterLog.Size() > 0U)
+        {
+            // Writes made during VBlank, they take effect from line 0
+            FlushRasterLog(0U, false);
+        }
+
+        m_FrameStart += GB_CYCLES_PER_FRAME;
+        m_Scheduler.Schedule(SchedulerEvent::FRAME_END, m_FrameStart + GB_CYCLES_PER_FRAME);
+
+        // Frames arrive from the worker late and in batches, so hash whatever
+        // ended up on screen rather than tracking which frame was submitted
+        if (m_pPipeline)
+        {
+            const u64 previousHash = m_FrameHash;
+            m_pPipeline->CollectFrames(m_Framebuffer);
+            m_FrameHash = HashBytes(m_Framebuffer.data(), m_Framebuffer.size());
+            m_FrameChanged = m_FrameHash != previousHash;
+        }
+    }
+
+    u64 PPU::GetFrameStart() const
+    {
+        return m_FrameStart;
+    }
+
+    void PPU::SetPipelined(const bool enable)
+    {
+        // Only called between frames, when the renderer is at line 0
+        if (enable && !m_pPipeline)
+        {
+            m_pPipeline = std::make_unique<FramePipeline>(m_Renderer.GetRegisters());
+        }
+        else if (!enable && m_pPipeline)
+        {
+            m_Renderer.SetRegisters(m_pPipeline->Stop(m_Framebuffer));
+            m_pPipeline.reset();
+        }
+
+        m_InputsChanged = true;
+    }
+
+    const PPU::Framebuffer& PPU::GetFramebuffer() const
+    {
+        return m_Framebuffer;
+    }
+
+    bool PPU::FrameChanged() const
+    {
+        return m_FrameChanged;
+    }
+
+    void PPU::SaveState(StateWriter& writer) const
+    {
+        writer.WriteBytes(m_VideoRam.data(), m_VideoRam.size());
+        writer.WriteBytes(m_OAM.data(), m_OAM.size());
+
+        writer.Write(m_FrameStart);
+        writer.Write(m_LY);
+        writer.Write(m_Mode);
+        writer.Write(m_StatLine);
+        writer.Write(m_STAT);
+        writer.Write(m_LYC);
+        writer.Write(m_DMA);
+        writer.WriteBytes(m_Registers.data(), m_Registers.size());
+
+        writer.Write(static_cast<u16>(m_RasterLog.Size()));
+        for (size_t i = 0; i < m_RasterLog.Size(); i++)
+        {
+            writer.Write(m_RasterLog[i].cycle);
+            writer.Write(m_RasterLog[i].reg);
+            writer.Write(m_RasterLog[i].value);
+        }
+        writer.WriteZeros((GB_RASTER_LOG_CAPACITY - m_RasterLog.Size()) * GB_RASTER_LOG_ENTRY_STATE_SIZE);
+
+        if (m_pPipeline)
+        {
+            // Between frames the worker is at line 0 with the live registers
+            Renderer(m_Registers).SaveState(writer);
+        }
+        else
+        {
+            m_Renderer.SaveState(writer);
+        }
+
+        writer.WriteBytes(m_Framebuffer.data(), m_Framebuffer.size());
+        writer.Write(m_InputsChanged);
+        writer.Write(m_FrameChanged);
+        writer.Write(m_FrameHash);
+    }
+
+    void PPU::LoadState(StateReader& reader)
+    {
+        reader.ReadBytes(m_VideoRam.data(), m_VideoRam.size());
+        reader.ReadBytes(m_OAM.data(), m_OAM.size());
+        m_SpriteIndex.OnOamTransfer(m_OAM);
+
+        m_FrameStart = reader.Read<u64>();
+        m_LY = reader.Read<u8>();
+        m_Mode = reader.Read<PPUMode>();
+        m_StatLine = reader.Read<bool>();
+        m_STAT = reader.Read<u8>();
+        m_LYC = reader.Read<u8>();
+        m_DMA = reader.Read<u8>();
+        reader.ReadBytes(m_Registers.data(), m_Registers.size());
+
+        const size_t logSize = std::min<size_t>(reader.Read<u16>(), GB_RASTER_LOG_CAPACITY);
+        m_RasterLog.Clear();
+        for (size_t i = 0; i < logSize; i++)
+        {
+            const u32 cycle = reader.Read<u32>();
+            const u8 reg = reader.Read<u8>();
+            const u8 value = reader.Read<u8>();
+            m_RasterLog.Record(cycle, static_cast<RasterRegister>(reg), value);
+        }
+        reader.Skip((GB_RASTER_LOG_CAPACITY - logSize) * GB_RASTER_LOG_ENTRY_STATE_SIZE);
+
+        m_Renderer.LoadState(reader);
+
+        if (m_pPipeline)
+        {
+            m_pPipeline.reset();
+            m_pPipeline = std::make_unique<FramePipeline>(m_Renderer.GetRegisters());
+        }
+
+        reader.ReadBytes(m_Framebuffer.data(), m_Framebuffer.size());
+        m_InputsChanged = reader.Read<bool>();
+        m_FrameChanged = reader.Read<bool>();
+        m_FrameHash = reader.Read<u64>();
+    }
+
+    bool PPU::ValidateState(StateReader& reader)
+    {
+        reader.Skip(GB_VRAM_SIZE + GB_OAM_SIZE + sizeof(u64));
+
+        const u8 ly = reader.Read<u8>();
+        const u8 mode = reader.Read<u8>();
+        // StatLine, STAT, LYC, DMA and the raster registers
+        reader.Skip(sizeof(bool) + 3U * sizeof(u8) + RASTER_REGISTER_COUNT);
+        if (ly >= GB_LINES_PER_FRAME || mode > PPU_MODE_TRANSFER)
+        {
+            return false;
+        }
+
+        const size_t logSize = reader.Read<u16>();
+        if (logSize > GB_RASTER_LOG_CAPACITY)
+        {
+            return false;
+        }
+
+        for (size_t i = 0; i < logSize; i++)
+        {
+            const u32 cycle = reader.Read<u32>();
+            const u8 reg = reader.Read<u8>();
+            reader.Skip(sizeof(u8));
+
+            if (cycle >= RasterLog::CYCLE_LIMIT || reg >= RASTER_REGISTER_COUNT)
+            {
+                return false;
+            }
+        }
+        reader.Skip((GB_RASTER_LOG_CAPACITY - logSize) * GB_RASTER_LOG_ENTRY_STATE_SIZE);
+
+        if (!Renderer::ValidateState(reader))
+        {
+            return false;
+        }
+
+        // Shades are masked on conversion, so the framebuffer needs no check
+        reader.Skip(std::tuple_size_v<Framebuffer> + 2U * sizeof(bool) + sizeof(u64));
+        return !reader.Overflowed();
+    }
+}
@@ -0,0 +1,266 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Core/PPU/Renderer.hpp"
+
+#include <algorithm>
+
+namespace GBcc
+{
+    Renderer::Renderer(const RasterRegisters& registers) : m_Registers(registers) {}
+
+    void Renderer::SetSource(const Source& source)
+    {
+        m_Source = source;
+    }
+
+    void Renderer::SetTarget(Framebuffer* const pTarget)
+    {
+        m_pTarget = pTarget;
+    }
+
+    void Renderer::ApplyRasterLog(const u32 untilCycle)
+    {
+        const RasterLog& rasterLog = *m_Source.rasterLog;
+
+        while (m_LogCursor < rasterLog.Size() && rasterLog[m_LogCursor].cycle < untilCycle)
+        {
+            const RasterLog::Entry entry = rasterLog[m_LogCursor++];
+            m_Registers[entry.reg] = entry.value;
+        }
+    }
+
+    void Renderer::RenderLinesUntil(const u32 cycle)
+    {
+        // A line samples the registers as they were when it started drawing
+        while (m_NextLine < VideoConstants::GAMEBOY_SCREEN_HEIGHT)
+        {
+            const u32 lineStart = m_NextLine * GB_CYCLES_PER_LINE + GB_OAM_SCAN_CYCLES;
+            if (lineStart > cycle)
+            {
+                break;
+            }
+
+            ApplyRasterLog(lineStart);
+            RenderScanline(m_NextLine++);
+        }
+    }
+
+    void Renderer::ConsumeRasterLog()
+    {
+        ApplyRasterLog(UINT32_MAX);
+        m_LogCursor = 0;
+    }
+
+    bool Renderer::ValidateState(StateReader& reader)
+    {
+        reader.Skip(RASTER_REGISTER_COUNT);
+        const u8 nextLine = reader.Read<u8>();
+        reader.Skip(sizeof(u8));
+        return nextLine <= VideoConstants::GAMEBOY_SCREEN_HEIGHT;
+    }
+
+    void Renderer::BeginFrame()
+    {
+        m_NextLine = 0;
+        m_WindowLine = 0;
+    }
+
+    const RasterRegisters& Renderer::GetRegisters() const
+    {
+        return m_Registers;
+    }
+
+    void Renderer::SetRegisters(const RasterRegisters& registers)
+    {
+        m_Registers = registers;
+    }
+
+    u8 Renderer::GetTilePixel(const u16 tileAddress, const u8 row, const u8 column) const
+    {
+        const u16 rowAddress = tileAddress + row * 2U;
+        const u8 lowPlane = m_Source.videoRam[rowAddress];
+        const u8 highPlane = m_Source.videoRam[rowAddress + 1U];
+        const u8 bit = 7U - column;
+
+        return (((highPlane >> bit) & 1U) << 1U) | ((lowPlane >> bit) & 1U);
+    }
+
+    void Renderer::RenderBackground(const u8 line, u8* const lineShades, u8* const lineColors)
+    {
+        constexpr i32 screenWidth = VideoConstants::GAMEBOY_SCREEN_WIDTH;
+
+        const u8 lcdc = m_Registers[RASTER_LCDC];
+        const u8 bgp = m_Registers[RASTER_BGP];
+
+        if (!(lcdc & GB_LCDC_BG_ENABLE))
+        {
+            std::fill(lineShades, lineShades + screenWidth, 0x00U);
+            std::fill(lineColors, lineColors + screenWidth, 0x00U);
+            return;
+        }
+
+        const i32 windowStartX = static_cast<i32>(m_Registers[RASTER_WX]) - GB_WINDOW_X_OFFSET;
+        const bool windowVisible = (
+            (lcdc & GB_LCDC_WINDOW_ENABLE) && 
+            (m_Registers[RASTER_WY] <= line) && 
+            (windowStartX < screenWidth)
+        );
+
+        const u16 backgroundMap = (lcdc & GB_LCDC_BG_MAP) ? GB_TILE_MAP_HIGH_BASE : GB_TILE_MAP_LOW_BASE;
+        const u16 windowMap = (lcdc & GB_LCDC_WINDOW_MAP) ? GB_TILE_MAP_HIGH_BASE : GB_TILE_MAP_LOW_BASE;
+        const bool unsignedTileData = lcdc & GB_LCDC_TILE_DATA;
+        const u8 scrollX = m_Registers[RASTER_SCX];
+        const u8 scrollY = m_Registers[RASTER_SCY];
+
+        for (i32 x = 0; x < screenWidth; x++)
+        {
+            u16 map;
+            u8 mapX;
+            u8 mapY;
+
+            if (windowVisible && x >= windowStartX)
+            {
+                map = windowMap;
+                mapX = x - windowStartX;
+                mapY = m_WindowLine;
+            }
+            else
+            {
+                map = backgroundMap;
+                mapX = x + scrollX;
+                mapY = line + scrollY;
+            }
+
+            const u8 tileIndex = m_Source.videoRam[map + (mapY / 8U) * GB_TILE_MAP_WIDTH + (mapX / 8U)];
+            const u16 tileAddress = unsignedTileData ?
+                GB_TILE_DATA_UNSIGNED_BASE + tileIndex * GB_TILE_SIZE :
+                GB_TILE_DATA_SIGNED_BASE + static_cast<i8>(tileIndex) * GB_TILE_SIZE;
+
+            const u8 color = GetTilePixel(tileAddress, mapY % 8U, mapX % 8U);
+            lineColors[x] = color;
+            lineShades[x] = (bgp >> (color * 2U)) & 0b11U;
+        }
+
+        if (windowVisible)
+        {
+            m_WindowLine++;
+        }
+    }
+
+    void Renderer::RenderSprites(const u8 line, u8* const lineShades, const u8* const lineColors)
+    {
+        constexpr i32 screenWidth = VideoConstants::GAMEBOY_SCREEN_WIDTH;
+
+        const u8 spriteHeight = (m_Registers[RASTER_LCDC] & GB_LCDC_OBJ_SIZE) ? 
+            GB_SPRITE_HEIGHT_TALL : 
+            GB_SPRITE_HEIGHT_NORMAL;
+
+        m_Source.spriteIndex->SetSpriteHeight(spriteHeight);
+        const auto& spriteLine = m_Source.spriteIndex->GetLine(line);
+
+        // Entries come in priority order, so the first opaque pixel wins
+        std::array<bool, screenWidth> pixelTaken = { false };
+
+        for (u8 i = 0; i < spriteLine.count; i++)
+        {
+            const size_t base = spriteLine.entries[i] * GB_OAM_ENTRY_SIZE;
+            const i32 spriteY = static_cast<i32>(m_Source.oam[base + GB_OAM_Y_OFFSET]) - GB_SPRITE_SCREEN_Y_OFFSET;
+            const i32 spriteX = static_cast<i32>(m_Source.oam[base + GB_OAM_X_OFFSET]) - GB_SPRITE_SCREEN_X_OFFSET;
+            const u8 flags = m_Source.oam[base + GB_OAM_FLAGS_OFFSET];
+
+            u8 tileIndex = m_Source.oam[base + GB_OAM_TILE_OFFSET];
+            if (spriteHeight == GB_SPRITE_HEIGHT_TALL)
+            {
+                tileIndex &= 0xFEU;
+            }
+
+            u8 row = line - spriteY;
+            if (flags & GB_OBJ_FLAG_Y_FLIP)
+            {
+                row = spriteHeight - 1U - row;
+            }
+
+            const u16 tileAddress = GB_TILE_DATA_UNSIGNED_BASE + tileIndex * GB_TILE_SIZE;
+            const u8 palette = (flags & GB_OBJ_FLAG_PALETTE) ? 
+                m_Registers[RASTER_OBP1] : 
+                m_Registers[RASTER_OBP0];
+
+            for (u8 column = 0; column < 8U; column++)
+            {
+                const i32 x = spriteX + column;
+                if (x < 0 || x >= screenWidth || pixelTaken[x])
+                {
+                    continue;
+                }
+
+                const u8 tileColumn = (flags & GB_OBJ_FLAG_X_FLIP) ? 7U - column : column;
+                const u8 color = GetTilePixel(tileAddress, row, tileColumn);
+                if (color == 0)
+                {
+                    continue;
+                }
+
+                pixelTaken[x] = true;
+
+                if ((flags & GB_OBJ_FLAG_PRIORITY) && lineColors[x] != 0)
+                {
+                    continue;
+                }
+
+                lineShades[x] = (palette >> (color * 2U)) & 0b11U;
+            }
+        }
+    }
+
+    void Renderer::RenderScanline(const u8 line)
+    {
+        constexpr size_t screenWidth = VideoConstants::GAMEBOY_SCREEN_WIDTH;
+        u8* const lineShades = m_pTarget->data() + line * screenWidth;
+        const u8 lcdc = m_Registers[RASTER_LCDC];
+
+        if (!(lcdc & GB_LCDC_LCD_ENABLE))
+        {
+            std::fill(lineShades, lineShades + screenWidth, 0x00U);
+            return;
+        }
+
+        std::array<u8, screenWidth> lineColors;
+        RenderBackground(line, lineShades, lineColors.data());
+
+        if (lcdc & GB_LCDC_OBJ_ENABLE)
+        {
+            RenderSprites(line, lineShades, lineColors.data());
+        }
+    }
+
+    void Renderer::SaveState(StateWriter& writer) const
+    {
+        writer.WriteBytes(m_Registers.data(), m_Registers.size());
+        writer.Write(m_NextLine);
+        writer.Write(m_WindowLine);
+    }
+
+    void Renderer::LoadState(StateReader& reader)
+    {
+        reader.ReadBytes(m_Registers.data(), m_Registers.size());
+        m_NextLine = reader.Read<u8>();
+        m_WindowLine = reader.Read<u8>();
+        m_LogCursor = 0;
+    }
+}
@@ -0,0 +1,119 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Core/PPU/SpriteIndex.hpp"
+
+#include <algorithm>
+
+namespace GBcc
+{
+    SpriteIndex::SpriteIndex()
+    {
+        std::fill(m_SpriteY.begin(), m_SpriteY.end(), 0x00U);
+        std::fill(m_SpriteX.begin(), m_SpriteX.end(), 0x00U);
+    }
+
+    void SpriteIndex::OnOamWrite(const u8 offset, const u8 data)
+    {
+        const u8 entry = offset / GB_OAM_ENTRY_SIZE;
+
+        switch (offset % GB_OAM_ENTRY_SIZE)
+        {
+            case GB_OAM_Y_OFFSET:
+                m_Dirty |= m_SpriteY[entry] != data;
+                m_SpriteY[entry] = data;
+                break;
+            case GB_OAM_X_OFFSET:
+                m_Dirty |= m_SpriteX[entry] != data;
+                m_SpriteX[entry] = data;
+                break;
+        }
+    }
+
+    void SpriteIndex::OnOamTransfer(const std::array<u8, GB_OAM_SIZE>& oam)
+    {
+        // Most games DMA the same positions frame after frame, only a
+        // change in Y or X needs a rebuild
+        for (size_t entry = 0; entry < GB_OAM_ENTRY_COUNT; entry++)
+        {
+            const size_t base = entry * GB_OAM_ENTRY_SIZE;
+            const u8 y = oam[base + GB_OAM_Y_OFFSET];
+            const u8 x = oam[base + GB_OAM_X_OFFSET];
+
+            m_Dirty |= m_SpriteY[entry] != y || m_SpriteX[entry] != x;
+            m_SpriteY[entry] = y;
+            m_SpriteX[entry] = x;
+        }
+    }
+
+    void SpriteIndex::SetSpriteHeight(const u8 height)
+    {
+        m_Dirty |= m_SpriteHeight != height;
+        m_SpriteHeight = height;
+    }
+
+    void SpriteIndex::Rebuild()
+    {
+        constexpr i32 screenHeight = VideoConstants::GAMEBOY_SCREEN_HEIGHT;
+
+        for (auto& line : m_Lines)
+        {
+            line.count = 0;
+        }
+
+        // Selection follows OAM order, the hardware keeps the first ten hits
+        for (u8 entry = 0; entry < GB_OAM_ENTRY_COUNT; entry++)
+        {
+            const i32 top = static_cast<i32>(m_SpriteY[entry]) - GB_SPRITE_SCREEN_Y_OFFSET;
+            const i32 firstLine = std::max(top, 0);
+            const i32 lastLine = std::min(top + m_SpriteHeight, screenHeight);
+
+            for (i32 lineIndex = firstLine; lineIndex < lastLine; lineIndex++)
+            {
+                auto& line = m_Lines[lineIndex];
+                if (line.count < GB_MAX_SPRITES_PER_LINE)
+                {
+                    line.entries[line.count++] = entry;
+                }
+            }
+        }
+
+        // Drawing priority is by X, ties go to the lower OAM index. Buckets are
+        // at most ten long and already in OAM order, so a stable insertion sort
+        // is enough.
+        for (auto& line : m_Lines)
+        {
+            for (u8 i = 1; i < line.count; i++)
+            {
+                const u8 entry = line.entries[i];
+                const u8 x = m_SpriteX[entry];
+                u8 j = i;
+
+                while (j > 0 && m_SpriteX[line.entries[j - 1]] > x)
+                {
+                    line.entries[j] = line.entries[j - 1];
+                    j--;
+                }
+
+                line.entries[j] = entry;
+            }
+        }
+
+        m_Dirty = false;
+    }
+}
@@ -0,0 +1,230 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Core/Scheduler.hpp"
+
+#include <algorithm>
+
+namespace GBcc
+{
+    Scheduler::Scheduler(const u64& clock) : m_Clock(clock)
+    {
+        std::fill(m_HeapPosition.begin(), m_HeapPosition.end(), NOT_SCHEDULED);
+    }
+
+    void Scheduler::Place(const size_t position, const Event& event)
+    {
+        m_Heap[position] = event;
+        m_HeapPosition[static_cast<size_t>(event.type)] = position;
+    }
+
+    void Scheduler::SiftUp(size_t position)
+    {
+        const Event event = m_Heap[position];
+
+        while (position > 0)
+        {
+            const size_t parent = (position - 1U) / 2U;
+            if (m_Heap[parent].timestamp <= event.timestamp)
+            {
+                break;
+            }
+
+            Place(position, m_Heap[parent]);
+            position = parent;
+        }
+
+        Place(position, event);
+    }
+
+    void Scheduler::SiftDown(size_t position)
+    {
+        const Event event = m_Heap[position];
+
+        while (true)
+        {
+            size_t child = position * 2U + 1U;
+            if (child >= m_Size)
+            {
+                break;
+            }
+
+            if (child + 1U < m_Size && m_Heap[child + 1U].timestamp < m_Heap[child].timestamp)
+            {
+                child++;
+            }
+
+            if (event.timestamp <= m_Heap[child].timestamp)
+            {
+                break;
+            }
+
+            Place(position, m_Heap[child]);
+            position = child;
+        }
+
+        Place(position, event);
+    }
+
+    void Scheduler::RemoveAt(const size_t position)
+    {
+        m_HeapPosition[static_cast<size_t>(m_Heap[position].type)] = NOT_SCHEDULED;
+        m_Size--;
+
+        if (position != m_Size)
+        {
+            Place(position, m_Heap[m_Size]);
+            SiftDown(position);
+            SiftUp(m_HeapPosition[static_cast<size_t>(m_Heap[position].type)]);
+        }
+    }
+
+    void Scheduler::Schedule(const SchedulerEvent type, const u64 timestamp)
+    {
+        const u8 position = m_HeapPosition[static_cast<size_t>(type)];
+
+        if (position == NOT_SCHEDULED)
+        {
+            Place(m_Size, { timestamp, type });
+            SiftUp(m_Size++);
+        }
+        else
+        {
+            const u64 previous = m_Heap[position].timestamp;
+            m_Heap[position].timestamp = timestamp;
+
+            if (timestamp < previous)
+            {
+                SiftUp(position);
+            }
+            else
+            {
+                SiftDown(position);
+            }
+        }
+
+        m_NextDeadline = m_Heap[0].timestamp;
+    }
+
+    void Scheduler::Deschedule(const SchedulerEvent type)
+    {
+        const u8 position = m_HeapPosition[static_cast<size_t>(type)];
+
+        if (position == NOT_SCHEDULED)
+        {
+            return;
+        }
+
+        RemoveAt(position);
+        m_NextDeadline = m_Size ? m_Heap[0].timestamp : UINT64_MAX;
+    }
+
+    bool Scheduler::IsScheduled(const SchedulerEvent type) const
+    {
+        return m_HeapPosition[static_cast<size_t>(type)] != NOT_SCHEDULED;
+    }
+
+    bool Scheduler::PopDue(SchedulerEvent& type, u64& timestamp)
+    {
+        if (m_Size == 0 || m_Heap[0].timestamp > m_Clock)
+        {
+            return false;
+        }
+
+        type = m_Heap[0].type;
+        timestamp = m_Heap[0].timestamp;
+
+        RemoveAt(0);
+        m_NextDeadline = m_Size ? m_Heap[0].timestamp : UINT64_MAX;
+
+        return true;
+    }
+
+    void Scheduler::SaveState(StateWriter& writer) const
+    {
+        writer.Write(static_cast<u8>(m_Size));
+
+        for (size_t i = 0; i < EVENT_COUNT; i++)
+        {
+            const bool used = i < m_Size;
+            writer.Write(used ? m_Heap[i].timestamp : 0ULL);
+            writer.Write(used ? m_Heap[i].type : SchedulerEvent::FRAME_END);
+        }
+    }
+
+    bool Scheduler::ReadState(StateReader& reader, std::array<Event, EVENT_COUNT>& heap, size_t& size)
+    {
+        size = reader.Read<u8>();
+        for (auto& event : heap)
+        {
+            event.timestamp = reader.Read<u64>();
+            event.type = reader.Read<SchedulerEvent>();
+        }
+
+        if (reader.Overflowed() || size > EVENT_COUNT)
+        {
+            return false;
+        }
+
+        std::array<bool, EVENT_COUNT> seen = {};
+        for (size_t i = 0; i < size; i++)
+        {
+            const size_t type = static_cast<size_t>(heap[i].type);
+            if (type >= EVENT_COUNT || seen[type])
+            {
+                return false;
+            }
+            seen[type] = true;
+
+            if (i > 0 && heap[(i - 1U) / 2U].timestamp > heap[i].timestamp)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool Scheduler::ValidateState(StateReader& reader)
+    {
+        std::array<Event, EVENT_COUNT> heap;
+        size_t size;
+        return ReadState(reader, heap, size);
+    }
+
+    bool Scheduler::LoadState(StateReader& reader)
+    {
+        std::array<Event, EVENT_COUNT> heap;
+        size_t size;
+
+        if (!ReadState(reader, heap, size))
+        {
+            return false;
+        }
+
+        m_Heap = heap;
+        m_Size = size;
+        m_HeapPosition.fill(NOT_SCHEDULED);
+        for (size_t i = 0; i < m_Size; i++)
+        {
+            m_HeapPosition[static_cast<size_t>(m_Heap[i].type)] = static_cast<u8>(i);
+        }
+
+        m_NextDeadline = m_Size ? m_Heap[0].timestamp : UINT64_MAX;
+        return true;
+    }
+}
@@ -18,6 +18,7 @@
 #include "Utility.hpp"
 
 #include "Core/Sharp/Sharp.hpp"
+#include "Core/InterruptController.hpp"
 
 namespace GBcc
 {
@@ -59,7 +60,12 @@ namespace GBcc
     {
         if (opcode == GB_INSTR_HALT_OPCODE) [[unlikely]]
         {
-            // Halt not implemented right now
+            // With IME off and a line already pending HALT does not stop
+            // the CPU. The PC double read that follows is not modelled.
+            if (m_pInterrupts->MasterEnabled() || !m_pInterrupts->GetPending())
+            {
+                m_pInterrupts->Halt();
+            }
             return;
         }
 
@@ -135,11 +141,11 @@ namespace GBcc
                     }
                     else if (yIndex == 6)
                     {
-                        // TODO: Disable interrupts
+                        m_pInterrupts->DisableMaster();
                     }
                     else if (yIndex == 7)
                     {
-                        // TODO: Enable interrupts
+                        m_pInterrupts->EnableMaster(true);
                     }
                     else
                     {
@@ -18,6 +18,7 @@
 #include "Utility.hpp"
 
 #include "Core/Sharp/Sharp.hpp"
+#include "Core/InterruptController.hpp"
 #include "Core/Memory.hpp"
 
 namespace GBcc
@@ -267,7 +268,8 @@ namespace GBcc
             switch (pIndex)
             {
                 case 1:
-                    // TODO: Interrupts
+                    m_pInterrupts->EnableMaster(false);
+                    [[fallthrough]];
                 case 0:
                     Return();
                     break;
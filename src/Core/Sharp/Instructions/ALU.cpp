@@ -22,104 +22,43 @@ namespace GBcc
 {
     u8 Sharp::UnsignedAddWord(const u8 lhs, const u8 rhs, const bool shouldAddCarry)
     {
-        u8 carry = shouldAddCarry ? static_cast<u8>(FlagIsSet(SharpFlags::CARRY)) : 0U;
-        u8 lhsLowNibble = lhs & U8_LOW_NIBBLE;
-        u8 rhsLowNibble = rhs & U8_LOW_NIBBLE;
-
-        u8 halfAdd = lhsLowNibble + rhsLowNibble + carry;
-        bool shouldSetHalfCarry = TestBit(halfAdd, 4U);
-        UpdateFlag(SharpFlags::HALF, shouldSetHalfCarry);
-
-        u16 result16 = lhs + rhs + carry;
-        bool shouldSetCarry = TestBit(result16, 8U);
-        UpdateFlag(SharpFlags::CARRY, shouldSetCarry);
-
-        u8 result = result16 & U16_LOW_BYTE;
-        bool isZero = result == 0;
-        UpdateFlag(SharpFlags::ZERO, isZero);
-
-        ResetFlag(SharpFlags::NOT_ADD);
+        u8 flags = m_F.GetValue();
+        const u8 carry = shouldAddCarry ? SharpALU::Carry(flags) : 0U;
+        const u8 result = SharpALU::Add(lhs, rhs, carry, flags);
+        m_F.SetValue(flags);
 
         return result;
     }
 
     u8 Sharp::UnsignedSubtractWord(const u8 lhs, const u8 rhs, const bool shouldBorrow)
     {
-        const u8 rhsModified = rhs + (
-            shouldBorrow ?
-            static_cast<u8>(FlagIsSet(SharpFlags::CARRY)) :
-            0U
-        );
-
-        const u8 result = lhs - rhsModified;
-
-        u8 lhsLowNibble = lhs & U8_LOW_NIBBLE;
-        u8 rhsLowNibble = rhs & U8_LOW_NIBBLE;
-
-        bool shouldSetHalfCarry = lhsLowNibble < rhsLowNibble;
-        bool shouldSetCarry = lhs < rhs;
-
-        const bool isCarrySet = FlagIsSet(SharpFlags::CARRY);
-
-        
-        if (shouldBorrow)
-        {
-            shouldSetHalfCarry = shouldSetHalfCarry || (isCarrySet && (lhsLowNibble == rhsLowNibble));
-            shouldSetCarry = shouldSetCarry || (isCarrySet && (lhs == rhs));
-        }
-
-        UpdateFlag(SharpFlags::HALF, shouldSetHalfCarry);
-        UpdateFlag(SharpFlags::CARRY, shouldSetCarry);
-
-        bool isZero = result == 0;
-        UpdateFlag(SharpFlags::ZERO, isZero);
-
-        SetFlag(SharpFlags::NOT_ADD);
+        u8 flags = m_F.GetValue();
+        const u8 borrow = shouldBorrow ? SharpALU::Carry(flags) : 0U;
+        const u8 result = SharpALU::Subtract(lhs, rhs, borrow, flags);
+        m_F.SetValue(flags);
 
         return result;
     }
 
     void Sharp::DecrementRegisterWord(ByteRegister& reg)
     {
-        const bool bCurrentCarry = FlagIsSet(SharpFlags::CARRY);
-
-        const u8 currentRegisterValue = reg.GetValue();
-        const u8 decrementedRegister = UnsignedSubtractWord(currentRegisterValue, 1U);
-
-        reg.SetValue(decrementedRegister);
-        
-        UpdateFlag(SharpFlags::CARRY, bCurrentCarry);
+        u8 flags = m_F.GetValue();
+        reg.SetValue(SharpALU::Decrement(reg.GetValue(), flags));
+        m_F.SetValue(flags);
     }
 
     void Sharp::IncrementRegisterWord(ByteRegister& reg)
     {
-        const bool bCurrentCarry = FlagIsSet(SharpFlags::CARRY);
-
-        const u8 currentRegisterValue = reg.GetValue();
-        const u8 incrementedRegister = UnsignedAddWord(currentRegisterValue, 1U);
-        
-        reg.SetValue(incrementedRegister);
-
-        ResetFlag(SharpFlags::NOT_ADD);
-        UpdateFlag(SharpFlags::CARRY, bCurrentCarry); 
+        u8 flags = m_F.GetValue();
+        reg.SetValue(SharpALU::Increment(reg.GetValue(), flags));
+        m_F.SetValue(flags);
     }
 
     u16 Sharp::UnsignedAddDoubleWord(const u16 lhs, const u16 rhs)
     {
-        u16 lhsMasked = lhs & 0x0F'FFU;
-        u16 rhsMasked = rhs & 0x0F'FFU;
-        
-        u16 halfAdd = lhsMasked + rhsMasked;
-        bool shouldSetHalfCarry = TestBit(halfAdd, 12U);
-        UpdateFlag(SharpFlags::HALF, shouldSetHalfCarry);
-
-        u32 result32 = lhs + rhs;
-        bool shouldSetCarry = TestBit(result32, 16U);
-        UpdateFlag(SharpFlags::CARRY, shouldSetCarry);
-
-        u16 result = result32 & U32_LOW_HALF;
-
-        ResetFlag(SharpFlags::NOT_ADD);
+        u8 flags = m_F.GetValue();
+        const u16 result = SharpALU::AddDouble(lhs, rhs, flags);
+        m_F.SetValue(flags);
 
         return result;
     }
@@ -160,16 +99,15 @@ namespace GBcc
 
     void Sharp::ComplementCarry()
     {
-        const bool carryComplement = !FlagIsSet(SharpFlags::CARRY);
-        UpdateFlag(SharpFlags::CARRY, carryComplement);
-        ResetFlag(SharpFlags::NOT_ADD);
-        ResetFlag(SharpFlags::HALF);
+        u8 flags = m_F.GetValue();
+        SharpALU::ComplementCarry(flags);
+        m_F.SetValue(flags);
     }
 
     void Sharp::SetCarry()
     {
-        SetFlag(SharpFlags::CARRY);
-        ResetFlag(SharpFlags::NOT_ADD);
-        ResetFlag(SharpFlags::HALF);
+        u8 flags = m_F.GetValue();
+        SharpALU::SetCarry(flags);
+        m_F.SetValue(flags);
     }
 }
\ No newline at end of file
@@ -21,45 +21,23 @@ namespace GBcc
 {
     void Sharp::AndAccumulator(const u8 value)
     {
-        u8 currentAccumulator = m_A.GetValue();
-        currentAccumulator &= value;
-
-        bool isZero = currentAccumulator == 0U; 
-
-        UpdateFlag(SharpFlags::ZERO, isZero);
-        ResetFlag(SharpFlags::NOT_ADD);
-        SetFlag(SharpFlags::HALF);
-        ResetFlag(SharpFlags::CARRY);
-
-        m_A.SetValue(currentAccumulator);
+        u8 flags = m_F.GetValue();
+        m_A.SetValue(SharpALU::And(m_A.GetValue(), value, flags));
+        m_F.SetValue(flags);
     }
 
     void Sharp::XorAccumulator(const u8 value)
-    {        
-        const u8 currentAccumulator = m_A.GetValue() ^ value;
-        
-        const bool isZero = currentAccumulator == 0U; 
-
-        UpdateFlag(SharpFlags::ZERO, isZero);
-        ResetFlag(SharpFlags::NOT_ADD);
-        ResetFlag(SharpFlags::HALF);
-        ResetFlag(SharpFlags::CARRY);
-
-        m_A.SetValue(currentAccumulator);
+    {
+        u8 flags = m_F.GetValue();
+        m_A.SetValue(SharpALU::Xor(m_A.GetValue(), value, flags));
+        m_F.SetValue(flags);
     }
 
     void Sharp::OrAccumulator(const u8 value)
     {
-        const u8 currentAccumulator = m_A.GetValue() | value;
-
-        const bool isZero = currentAccumulator == 0U; 
-
-        UpdateFlag(SharpFlags::ZERO, isZero);
-        ResetFlag(SharpFlags::NOT_ADD);
-        ResetFlag(SharpFlags::HALF);
-        ResetFlag(SharpFlags::CARRY);
-        
-        m_A.SetValue(currentAccumulator);
+        u8 flags = m_F.GetValue();
+        m_A.SetValue(SharpALU::Or(m_A.GetValue(), value, flags));
+        m_F.SetValue(flags);
     }
 
     void Sharp::RotateLeftAccumulator(const bool bCircular)
@@ -125,9 +103,8 @@ namespace GBcc
 
     void Sharp::ComplementAccumulator()
     {
-        const u8 accumulatorComplement = ~m_A.GetValue();
-        m_A.SetValue(accumulatorComplement);
-        SetFlag(SharpFlags::HALF);
-        SetFlag(SharpFlags::NOT_ADD);
+        u8 flags = m_F.GetValue();
+        m_A.SetValue(SharpALU::Complement(m_A.GetValue(), flags));
+        m_F.SetValue(flags);
     }
 }
\ No newline at end of file
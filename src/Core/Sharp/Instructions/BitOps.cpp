@@ -105,36 +105,18 @@ namespace GBcc
 
     u8 Sharp::RotateLeft(const u8 value, const bool bCircular)
     {
-        const u8 outBit = (value & 0b1000'0000) >> 7U;
-        const u8 inBit  = bCircular ? outBit : FlagIsSet(SharpFlags::CARRY);
-        
-        u8 newValue = value << 1U;
-        newValue |= inBit;
-
-        const bool isZero = newValue == 0; 
-
-        UpdateFlag(SharpFlags::ZERO, isZero);
-        ResetFlag(SharpFlags::NOT_ADD);
-        ResetFlag(SharpFlags::HALF);
-        UpdateFlag(SharpFlags::CARRY, outBit);
+        u8 flags = m_F.GetValue();
+        const u8 newValue = SharpALU::RotateLeft(value, bCircular, flags);
+        m_F.SetValue(flags);
 
         return newValue;
     }
 
     u8 Sharp::RotateRight(const u8 value, const bool bCircular)
     {
-        const u8 outBit = value & 0b1;
-        const u8 inBit = bCircular ? outBit : FlagIsSet(SharpFlags::CARRY);
-
-        u8 newValue = value >> 1U;
-        newValue |= (inBit << 7U);
-
-        const bool isZero = newValue == 0; 
-
-        UpdateFlag(SharpFlags::ZERO, isZero);
-        ResetFlag(SharpFlags::NOT_ADD);
-        ResetFlag(SharpFlags::HALF);
-        UpdateFlag(SharpFlags::CARRY, outBit);
+        u8 flags = m_F.GetValue();
+        const u8 newValue = SharpALU::RotateRight(value, bCircular, flags);
+        m_F.SetValue(flags);
 
         return newValue;
     }
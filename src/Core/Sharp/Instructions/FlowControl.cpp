@@ -37,7 +37,7 @@ namespace GBcc
         if (!bConditionMet)
             return;
         m_PC = bAddressInHL ? m_HL.GetDoubleWord() : m_Operand.as16;
-        m_CyclesTaken += 4ULL;
+        m_CyclesTaken += bAddressInHL ? 0ULL : 4ULL;
     }
 
     void Sharp::JumpRelative(const bool bConditionMet)
@@ -19,6 +19,7 @@
 
 #include "Core/Sharp/Sharp.hpp"
 #include "Core/Memory.hpp"
+#include "Core/InterruptController.hpp"
 #include "Core/Bitmasks.hpp"
 
 #include <iostream>
@@ -27,12 +28,13 @@
 
 namespace GBcc 
 {
-    Sharp::Sharp(Memory* const pMemBus) : 
+    Sharp::Sharp(Memory* const pMemBus, InterruptController* const pInterrupts) : 
         m_AF(m_A, m_F),
         m_BC(m_B, m_C),
         m_DE(m_D, m_E),
         m_HL(m_H, m_L),
-        m_pMemBus(pMemBus)
+        m_pMemBus(pMemBus),
+        m_pInterrupts(pInterrupts)
     {
         m_A.SetValue(0x01U);
         SetFlag(SharpFlags::ZERO);
@@ -45,7 +47,18 @@ namespace GBcc
         m_HL.SetDoubleWord(0x014D);
         m_PC = 0x0100;
         m_SP = 0xFFFE;
-        m_ExecLog.open("execlog.txt");
+    }
+
+    void Sharp::SetExecLog(const std::string& path)
+    {
+        m_pExecLog.reset();
+        m_LogExecution = false;
+
+        if (!path.empty())
+        {
+            m_pExecLog = std::make_unique<std::ofstream>(path);
+            m_LogExecution = m_pExecLog->is_open();
+        }
     }
 
     void Sharp::DumpRegs()
@@ -55,9 +68,10 @@ namespace GBcc
         for (size_t i = 0; i < 4; i++)
             memLog[i] = m_pMemBus->ReadWord(m_PC + i);
 
-        if (m_ExecLog)
+        if (m_pExecLog && *m_pExecLog)
         {
-            m_ExecLog << std::hex << std::uppercase << "A:"  << std::setw(2) << std::setfill('0') << (u16)m_A.GetValue() 
+            std::ofstream& execLog = *m_pExecLog;
+            execLog << std::hex << std::uppercase << "A:"  << std::setw(2) << std::setfill('0') << (u16)m_A.GetValue() 
 											 << " F:"  << std::setw(2) << std::setfill('0') << (u16)m_F.GetValue() 
 											 << " B:"  << std::setw(2) << std::setfill('0') << (u16)m_B.GetValue() 
 											 << " C:"  << std::setw(2) << std::setfill('0') << (u16)m_C.GetValue() 
@@ -148,7 +162,18 @@ namespace GBcc
         if (opcode == GB_INSTR_PREFIX_CB)
         {
             FetchWord();
-            DecodePrefixCB(m_Operand.as8);
+
+            const u8 cbOpcode = m_Operand.as8;
+            const bool isBitOnHL = (
+                (GetValueFromMask(cbOpcode, GB_INSTR_BLOCK_MASK) == 1U) &&
+                (GetValueFromMask(cbOpcode, GB_Z_INDEX_MASK) == GB_CPU_DEREF_HL_PTR)
+            );
+
+            m_CyclesTaken += isBitOnHL ? 
+                GB_INSTR_CB_BIT_HL_CYCLES : 
+                GB_INSTR_CB_CYCLES[GetValueFromMask(cbOpcode, GB_Z_INDEX_MASK)];
+
+            DecodePrefixCB(cbOpcode);
             return;
         }
 
@@ -170,11 +195,139 @@ namespace GBcc
         }
     }
 
+    bool Sharp::ServiceInterrupts()
+    {
+        m_pInterrupts->StepEnableDelay();
+        const bool bPending = m_pInterrupts->GetPending();
+
+        if (m_pInterrupts->IsHalted())
+        {
+            if (!bPending)
+            {
+                IdleUntilDeadline();
+                return true;
+            }
+
+            m_pInterrupts->Wake();
+        }
+
+        if (bPending && m_pInterrupts->MasterEnabled())
+        {
+            ResetToVector(m_pInterrupts->Acknowledge());
+            m_CyclesTaken += GB_INTERRUPT_DISPATCH_CYCLES;
+            return true;
+        }
+
+        return false;
+    }
+
+    void Sharp::IdleUntilDeadline()
+    {
+        // While halted only a scheduled event can raise a line, so jump
+        // straight to the next one, rounded up to a whole M-cycle
+        const u64 deadline = m_pIdleDeadline ? *m_pIdleDeadline : UINT64_MAX;
+
+        if (deadline == UINT64_MAX || deadline <= m_CyclesTaken)
+        {
+            m_CyclesTaken += 4ULL;
+        }
+        else
+        {
+            m_CyclesTaken += (deadline - m_CyclesTaken + 3ULL) & ~3ULL;
+        }
+    }
+
     u64 Sharp::Step()
     {
-        //DumpRegs();
+        if (m_LogExecution) [[unlikely]]
+        {
+            DumpRegs();
+        }
+        const u64 cyclesBefore = m_CyclesTaken;
+
+        if (m_pInterrupts->NeedsService()) [[unlikely]]
+        {
+            if (ServiceInterrupts())
+            {
+                return m_CyclesTaken - cyclesBefore;
+            }
+        }
+
         const u8 opcode = m_pMemBus->ReadWord(m_PC++);
+        m_CyclesTaken += GB_INSTR_CYCLES[opcode];
+        m_InstructionCount++;
         ExecuteOpcode(opcode);
-        return 0;
+        return m_CyclesTaken - cyclesBefore;
+    }
+
+    const u64& Sharp::GetCyclesTaken() const
+    {
+        return m_CyclesTaken;
+    }
+
+    u64 Sharp::GetInstructionCount() const
+    {
+        return m_InstructionCount;
+    }
+
+    void Sharp::SetIdleDeadline(const u64* pDeadline)
+    {
+        m_pIdleDeadline = pDeadline;
+    }
+
+    SharpRegisterFile Sharp::GetRegisterFile() const
+    {
+        return {
+            m_A.GetValue(), m_F.GetValue(), 
+            m_B.GetValue(), m_C.GetValue(), 
+            m_D.GetValue(), m_E.GetValue(), 
+            m_H.GetValue(), m_L.GetValue(), 
+            m_SP, m_PC, m_CyclesTaken
+        };
+    }
+
+    void Sharp::SetRegisterFile(const SharpRegisterFile& registers)
+    {
+        m_A.SetValue(registers.a);
+        m_F.SetValue(registers.f);
+        m_B.SetValue(registers.b);
+        m_C.SetValue(registers.c);
+        m_D.SetValue(registers.d);
+        m_E.SetValue(registers.e);
+        m_H.SetValue(registers.h);
+        m_L.SetValue(registers.l);
+        m_SP = registers.sp;
+        m_PC = registers.pc;
+        m_CyclesTaken = registers.cycles;
+    }
+
+    void Sharp::SaveState(StateWriter& writer) const
+    {
+        writer.Write(m_A.GetValue());
+        writer.Write(m_F.GetValue());
+        writer.Write(m_B.GetValue());
+        writer.Write(m_C.GetValue());
+        writer.Write(m_D.GetValue());
+        writer.Write(m_E.GetValue());
+        writer.Write(m_H.GetValue());
+        writer.Write(m_L.GetValue());
+        writer.Write(m_SP);
+        writer.Write(m_PC);
+        writer.Write(m_CyclesTaken);
+    }
+
+    void Sharp::LoadState(StateReader& reader)
+    {
+        m_A.SetValue(reader.Read<u8>());
+        m_F.SetValue(reader.Read<u8>());
+        m_B.SetValue(reader.Read<u8>());
+        m_C.SetValue(reader.Read<u8>());
+        m_D.SetValue(reader.Read<u8>());
+        m_E.SetValue(reader.Read<u8>());
+        m_H.SetValue(reader.Read<u8>());
+        m_L.SetValue(reader.Read<u8>());
+        m_SP = reader.Read<u16>();
+        m_PC = reader.Read<u16>();
+        m_CyclesTaken = reader.Read<u64>();
     }
 }
\ No newline at end of file
@@ -20,10 +20,419 @@
 
 namespace GBcc
 {
-    System::System() : m_CPU(&m_Memory) {};
+    static_assert(sizeof(System) <= GB_SYSTEM_SIZE_TARGET);
+
+    namespace
+    {
+        // For components any bytes are a valid state of
+        template <typename Component>
+        void SkipState(StateReader& reader, const Component& component)
+        {
+            StateWriter counter(nullptr, 0U);
+            component.SaveState(counter);
+            reader.Skip(counter.Size());
+        }
+    }
+
+    System::System() : 
+        m_CPU(&m_Memory, &m_Interrupts), 
+        m_Scheduler(m_CPU.GetCyclesTaken()), 
+        m_Joypad(m_Interrupts), 
+        m_Timer(m_Scheduler, m_Interrupts), 
+        m_APU(m_Scheduler), 
+        m_Memory(&m_PPU, &m_Timer, &m_APU, &m_Interrupts, &m_Joypad), 
+        m_PPU(m_Scheduler, m_Interrupts)
+    {
+        m_CPU.SetIdleDeadline(&m_Scheduler.NextDeadline());
+
+        StateWriter counter(nullptr, 0U);
+        WriteState(counter);
+        m_StateSize = counter.Size();
+    }
+
+    bool System::LoadRom(const std::string& path)
+    {
+        return m_Memory.LoadRom(path);
+    }
+
+    bool System::LoadRom(const u8* const data, const size_t size)
+    {
+        return m_Memory.LoadRom(data, size);
+    }
+
+    bool System::SetObservation(const ObservationFormat format, std::span<u8> buffer)
+    {
+        if (buffer.size() < ObservationEncoder::GetSize(format))
+        {
+            return false;
+        }
+
+        m_ObservationFormat = format;
+        m_Observation = buffer.first(ObservationEncoder::GetSize(format));
+        return true;
+    }
+
+    void System::SetObservationPath(const ObservationPath path)
+    {
+        m_ObservationEncoder.SetPath(path);
+    }
+
+    void System::SetRewardFunction(const RewardFunction pReward, void* pUser)
+    {
+        m_pReward = pReward;
+        m_pRewardUser = pUser;
+    }
+
+    EnvStep System::StepEnvironment(const u8 buttons, const u32 frames)
+    {
+        m_Joypad.SetButtons(buttons);
+
+        for (u32 i = 0; i < frames; i++)
+        {
+            RunFrame();
+        }
+
+        EnvStep step;
+        const PPU::Framebuffer& framebuffer = m_PPU.GetFramebuffer();
+        step.framebuffer = framebuffer;
+        step.workRam = m_Memory.GetView(0xC000U, 0x2000U);
+        step.highRam = m_Memory.GetView(0xFF80U, 0x007FU);
+
+        if (m_ObservationFormat != ObservationFormat::NONE)
+        {
+            m_ObservationEncoder.Encode(m_ObservationFormat, framebuffer, m_Observation);
+            step.observation = m_Observation;
+        }
+        if (m_pReward)
+        {
+            step.reward = m_pReward(*this, m_pRewardUser);
+        }
+        return step;
+    }
+
+    std::span<const u8> System::GetMemoryView(const u16 address, const u16 size) const
+    {
+        return m_Memory.GetView(address, size);
+    }
+
+    void System::LoadCartridge(const std::shared_ptr<const Cartridge>& pCartridge)
+    {
+        m_Memory.LoadCartridge(pCartridge);
+    }
+
+    const std::shared_ptr<const Cartridge>& System::GetCartridge() const
+    {
+        return m_Memory.GetCartridge();
+    }
+
+    void System::SetExecLog(const std::string& path)
+    {
+        m_CPU.SetExecLog(path);
+    }
 
     void System::Step()
     {
         m_CPU.Step();
-    }    
+        DispatchEvents();
+    }
+
+    void System::RunFrame()
+    {
+        BeginFrame();
+
+        while (!m_FrameDone)
+        {
+            RunUntilNextEvent();
+            DispatchEvents();
+        }
+    }
+
+    void System::BeginFrame()
+    {
+        m_FrameDone = false;
+
+        if (m_pReplay && m_ReplayFrame < m_pReplay->GetFrameCount())
+        {
+            m_Joypad.SetButtons(m_pReplay->GetInput(m_ReplayFrame++));
+        }
+        if (m_pRecording)
+        {
+            m_pRecording->RecordFrame(m_Joypad.GetButtons());
+        }
+    }
+
+    bool System::FrameDone() const
+    {
+        return m_FrameDone;
+    }
+
+    u64 System::GetNextEventCycle() const
+    {
+        return m_Scheduler.NextDeadline();
+    }
+
+    bool System::InterruptPending() const
+    {
+        return m_Interrupts.NeedsService();
+    }
+
+    SharpRegisterFile System::GetRegisterFile() const
+    {
+        return m_CPU.GetRegisterFile();
+    }
+
+    void System::SetRegisterFile(const SharpRegisterFile& registers)
+    {
+        m_CPU.SetRegisterFile(registers);
+    }
+
+    Memory& System::GetMemory()
+    {
+        return m_Memory;
+    }
+
+    u64 System::RunCycles(const u64 cycles)
+    {
+        const u64& now = m_CPU.GetCyclesTaken();
+        const u64 start = now;
+        const u64 end = start + cycles;
+
+        while (now < end)
+        {
+            while (now < end && now < m_Scheduler.NextDeadline())
+            {
+                m_CPU.Step();
+            }
+            DispatchEvents();
+        }
+
+        return now - start;
+    }
+
+    void System::RunUntilNextEvent()
+    {
+        // Devices reschedule from inside instructions (register writes), so
+        // the deadline is read again after every step
+        const u64& cycles = m_CPU.GetCyclesTaken();
+
+        while (cycles < m_Scheduler.NextDeadline())
+        {
+            m_CPU.Step();
+        }
+    }
+
+    void System::DispatchEvents()
+    {
+        SchedulerEvent event;
+        u64 timestamp;
+
+        while (m_Scheduler.PopDue(event, timestamp))
+        {
+            switch (event)
+            {
+                case SchedulerEvent::FRAME_END:
+                    m_PPU.EndFrame();
+                    m_APU.EndFrame();
+                    m_FrameDone = true;
+                    break;
+                case SchedulerEvent::PPU_MODE:
+                    m_PPU.HandleModeEvent(timestamp);
+                    break;
+                case SchedulerEvent::TIMER_OVERFLOW:
+                    m_Timer.HandleOverflowEvent();
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    void System::SetPipelinedRendering(const bool enable)
+    {
+        m_PPU.SetPipelined(enable);
+    }
+
+    const PPU::Framebuffer& System::GetFramebuffer() const
+    {
+        return m_PPU.GetFramebuffer();
+    }
+
+    bool System::FrameChanged() const
+    {
+        return m_PPU.FrameChanged();
+    }
+
+    u64 System::GetCyclesTaken() const
+    {
+        return m_CPU.GetCyclesTaken();
+    }
+
+    u64 System::GetInstructionCount() const
+    {
+        return m_CPU.GetInstructionCount();
+    }
+
+    APU& System::GetAPU()
+    {
+        return m_APU;
+    }
+
+    void System::WriteState(StateWriter& writer) const
+    {
+        writer.Write(GB_SAVE_STATE_MAGIC);
+        writer.Write(GB_SAVE_STATE_VERSION);
+        writer.Write(static_cast<u32>(m_StateSize));
+
+        m_CPU.SaveState(writer);
+        m_Scheduler.SaveState(writer);
+        m_Interrupts.SaveState(writer);
+        m_Joypad.SaveState(writer);
+        m_Timer.SaveState(writer);
+        m_APU.SaveState(writer);
+        m_Memory.SaveState(writer);
+        m_PPU.SaveState(writer);
+    }
+
+    size_t System::GetStateSize() const
+    {
+        return m_StateSize;
+    }
+
+    size_t System::SaveState(u8* const buffer, const size_t size) const
+    {
+        if (size < m_StateSize)
+        {
+            return 0U;
+        }
+
+        StateWriter writer(buffer, size);
+        WriteState(writer);
+
+        return writer.Size();
+    }
+
+    bool System::ValidateState(StateReader& reader) const
+    {
+        if (reader.Read<u32>() != GB_SAVE_STATE_MAGIC || 
+            reader.Read<u16>() != GB_SAVE_STATE_VERSION || 
+            reader.Read<u32>() != m_StateSize)
+        {
+            return false;
+        }
+
+        SkipState(reader, m_CPU);
+        if (!Scheduler::ValidateState(reader))
+        {
+            return false;
+        }
+
+        SkipState(reader, m_Interrupts);
+        SkipState(reader, m_Joypad);
+        SkipState(reader, m_Timer);
+        if (!APU::ValidateState(reader))
+        {
+            return false;
+        }
+
+        SkipState(reader, m_Memory);
+        return PPU::ValidateState(reader) && !reader.Overflowed();
+    }
+
+    bool System::LoadState(const u8* const buffer, const size_t size)
+    {
+        if (size < m_StateSize)
+        {
+            return false;
+        }
+
+        // Nothing is loaded until the whole blob is known to be good
+        StateReader validator(buffer, size);
+        if (!ValidateState(validator))
+        {
+            return false;
+        }
+
+        StateReader reader(buffer, size);
+        reader.Skip(sizeof(GB_SAVE_STATE_MAGIC) + sizeof(GB_SAVE_STATE_VERSION) + sizeof(u32));
+
+        m_CPU.LoadState(reader);
+        m_Scheduler.LoadState(reader);
+        m_Interrupts.LoadState(reader);
+        m_Joypad.LoadState(reader);
+        m_Timer.LoadState(reader);
+        m_APU.LoadState(reader);
+        m_Memory.LoadState(reader);
+        m_PPU.LoadState(reader);
+
+        return true;
+    }
+
+    u64 System::GetRomHash() const
+    {
+        return m_Memory.GetRomHash();
+    }
+
+    void System::SetJoypad(const u8 buttons)
+    {
+        m_Joypad.SetButtons(buttons);
+    }
+
+    void System::StartRecording(Movie& movie)
+    {
+        if (GetCyclesTaken() == 0ULL)
+        {
+            movie.Begin(GetRomHash(), nullptr, 0U);
+        }
+        else
+        {
+            std::vector<u8> state(m_StateSize);
+            SaveState(state.data(), state.size());
+            movie.Begin(GetRomHash(), state.data(), state.size());
+        }
+
+        m_pRecording = &movie;
+    }
+
+    void System::StopRecording()
+    {
+        m_pRecording = nullptr;
+    }
+
+    bool System::StartReplay(const Movie& movie)
+    {
+        if (movie.GetRomHash() != GetRomHash())
+        {
+            return false;
+        }
+
+        if (movie.StartsAtPowerOn() ? GetCyclesTaken() != 0ULL : 
+            !LoadState(movie.GetStartState().data(), movie.GetStartState().size()))
+        {
+            return false;
+        }
+
+        m_pReplay = &movie;
+        m_ReplayFrame = 0;
+        return true;
+    }
+
+    bool System::ReplayFinished() const
+    {
+        return !m_pReplay || m_ReplayFrame >= m_pReplay->GetFrameCount();
+    }
+
+    void System::SetSerialCapture(const bool capture)
+    {
+        m_Memory.SetSerialCapture(capture);
+    }
+
+    const std::string& System::GetSerialOutput() const
+    {
+        return m_Memory.GetSerialOutput();
+    }
+
+    void System::ClearSerialOutput()
+    {
+        m_Memory.ClearSerialOutput();
+    }
 }
\ No newline at end of file
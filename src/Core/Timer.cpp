@@ -0,0 +1,189 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Core/Timer.hpp"
+
+namespace GBcc
+{
+    Timer::Timer(Scheduler& scheduler, InterruptController& interrupts) : 
+        m_Scheduler(scheduler), 
+        m_Interrupts(interrupts)
+    {
+        m_LastSync = m_Scheduler.Now();
+        m_CounterOffset -= m_LastSync;
+    }
+
+    u64 Timer::GetCounter() const
+    {
+        return m_Scheduler.Now() + m_CounterOffset;
+    }
+
+    bool Timer::Enabled() const
+    {
+        return m_TAC & GB_TAC_ENABLE;
+    }
+
+    u8 Timer::GetClockBit() const
+    {
+        return GB_TIMER_CLOCK_BITS[m_TAC & GB_TAC_CLOCK_MASK];
+    }
+
+    bool Timer::GetTimerSignal() const
+    {
+        return Enabled() && ((GetCounter() >> GetClockBit()) & 1U);
+    }
+
+    void Timer::Sync()
+    {
+        const u64 now = m_Scheduler.Now();
+
+        if (Enabled())
+        {
+            // Falling edges of bit n in (from, to] are the multiples of
+            // 2^(n+1) in that range
+            const u8 shift = GetClockBit() + 1U;
+            const u64 from = m_LastSync + m_CounterOffset;
+            const u64 to = now + m_CounterOffset;
+
+            Increment((to >> shift) - (from >> shift));
+        }
+
+        m_LastSync = now;
+    }
+
+    void Timer::Increment(u64 edges)
+    {
+        while (edges > 0)
+        {
+            const u64 untilOverflow = 0x100U - m_TIMA;
+
+            if (edges < untilOverflow)
+            {
+                m_TIMA += edges;
+                return;
+            }
+
+            edges -= untilOverflow;
+            m_TIMA = m_TMA;
+            m_Interrupts.Request(GB_INTERRUPT_TIMER);
+        }
+    }
+
+    void Timer::ScheduleOverflow()
+    {
+        if (!Enabled())
+        {
+            m_Scheduler.Deschedule(SchedulerEvent::TIMER_OVERFLOW);
+            return;
+        }
+
+        const u8 shift = GetClockBit() + 1U;
+        const u64 edges = 0x100U - m_TIMA;
+        const u64 overflowCounter = ((GetCounter() >> shift) + edges) << shift;
+
+        m_Scheduler.Schedule(SchedulerEvent::TIMER_OVERFLOW, overflowCounter - m_CounterOffset);
+    }
+
+    u8 Timer::ReadRegister(const u16 address)
+    {
+        switch (address)
+        {
+            case GB_REG_DIV:
+                return static_cast<u8>(GetCounter() >> 8U);
+            case GB_REG_TIMA:
+                Sync();
+                return m_TIMA;
+            case GB_REG_TMA:
+                return m_TMA;
+            case GB_REG_TAC:
+                return m_TAC | GB_TAC_UNUSED;
+            default:
+                return 0xFFU;
+        }
+    }
+
+    void Timer::WriteRegister(const u16 address, const u8 data)
+    {
+        Sync();
+
+        switch (address)
+        {
+            case GB_REG_DIV:
+            {
+                // Clearing the counter is a falling edge if the selected
+                // bit was set
+                const bool signal = GetTimerSignal();
+                m_CounterOffset = 0ULL - m_Scheduler.Now();
+                m_LastSync = m_Scheduler.Now();
+
+                if (signal)
+                {
+                    Increment(1U);
+                }
+                break;
+            }
+            case GB_REG_TIMA:
+                m_TIMA = data;
+                break;
+            case GB_REG_TMA:
+                m_TMA = data;
+                return;
+            case GB_REG_TAC:
+            {
+                // The edge detector sees enable AND the selected bit, so
+                // disabling or switching to a low bit can clock TIMA
+                const bool signal = GetTimerSignal();
+                m_TAC = data | GB_TAC_UNUSED;
+
+                if (signal && !GetTimerSignal())
+                {
+                    Increment(1U);
+                }
+                break;
+            }
+            default:
+                return;
+        }
+
+        ScheduleOverflow();
+    }
+
+    void Timer::HandleOverflowEvent()
+    {
+        Sync();
+        ScheduleOverflow();
+    }
+
+    void Timer::SaveState(StateWriter& writer) const
+    {
+        writer.Write(m_CounterOffset);
+        writer.Write(m_LastSync);
+        writer.Write(m_TIMA);
+        writer.Write(m_TMA);
+        writer.Write(m_TAC);
+    }
+
+    void Timer::LoadState(StateReader& reader)
+    {
+        m_CounterOffset = reader.Read<u64>();
+        m_LastSync = reader.Read<u64>();
+        m_TIMA = reader.Read<u8>();
+        m_TMA = reader.Read<u8>();
+        m_TAC = reader.Read<u8>();
+    }
+}
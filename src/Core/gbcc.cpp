@@ -0,0 +1,107 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "gbcc.h"
+#include "Core/System.hpp"
+
+#include <new>
+
+struct gbcc_instance
+{
+    GBcc::System system;
+};
+
+static_assert(GBCC_SCREEN_WIDTH * GBCC_SCREEN_HEIGHT == std::tuple_size_v<GBcc::PPU::Framebuffer>);
+static_assert(GBCC_BUTTON_RIGHT == GBcc::JOYPAD_RIGHT && GBCC_BUTTON_START == GBcc::JOYPAD_START);
+
+gbcc_instance* gbcc_create(void)
+{
+    return new (std::nothrow) gbcc_instance();
+}
+
+void gbcc_destroy(gbcc_instance* instance)
+{
+    delete instance;
+}
+
+int gbcc_load_rom(gbcc_instance* instance, const uint8_t* data, size_t size)
+{
+    return instance->system.LoadRom(data, size) ? 0 : -1;
+}
+
+void gbcc_share_rom(gbcc_instance* instance, const gbcc_instance* source)
+{
+    instance->system.LoadCartridge(source->system.GetCartridge());
+}
+
+uint64_t gbcc_run_cycles(gbcc_instance* instance, uint64_t cycles)
+{
+    return instance->system.RunCycles(cycles);
+}
+
+void gbcc_run_frames(gbcc_instance* instance, uint32_t frames)
+{
+    for (uint32_t i = 0; i < frames; i++)
+    {
+        instance->system.RunFrame();
+    }
+}
+
+uint64_t gbcc_get_cycles(const gbcc_instance* instance)
+{
+    return instance->system.GetCyclesTaken();
+}
+
+const uint8_t* gbcc_get_framebuffer(const gbcc_instance* instance)
+{
+    return instance->system.GetFramebuffer().data();
+}
+
+void gbcc_set_input(gbcc_instance* instance, uint8_t buttons)
+{
+    instance->system.SetJoypad(buttons);
+}
+
+const char* gbcc_get_serial_output(const gbcc_instance* instance, size_t* size)
+{
+    const std::string& output = instance->system.GetSerialOutput();
+    if (size)
+    {
+        *size = output.size();
+    }
+    return output.c_str();
+}
+
+void gbcc_clear_serial_output(gbcc_instance* instance)
+{
+    instance->system.ClearSerialOutput();
+}
+
+size_t gbcc_get_state_size(const gbcc_instance* instance)
+{
+    return instance->system.GetStateSize();
+}
+
+size_t gbcc_save_state(const gbcc_instance* instance, void* buffer, size_t size)
+{
+    return instance->system.SaveState(static_cast<GBcc::u8*>(buffer), size);
+}
+
+int gbcc_load_state(gbcc_instance* instance, const void* buffer, size_t size)
+{
+    return instance->system.LoadState(static_cast<const GBcc::u8*>(buffer), size) ? 0 : -1;
+}
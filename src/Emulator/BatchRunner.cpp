@@ -0,0 +1,110 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "Emulator/BatchRunner.hpp"
+#include "Core/System.hpp"
+#include "Core/Movie.hpp"
+#include "Utility.hpp"
+
+#include <chrono>
+#include <map>
+#include <memory>
+
+namespace GBcc
+{
+    BatchRunner::BatchRunner(const size_t threads) : m_Pool(threads) {}
+
+    size_t BatchRunner::GetThreadCount() const
+    {
+        return m_Pool.GetThreadCount();
+    }
+
+    std::vector<BatchResult> BatchRunner::Run(const std::vector<BatchJob>& jobs)
+    {
+        std::vector<BatchResult> results(jobs.size());
+        std::map<std::string, std::shared_ptr<const Cartridge>> cartridges;
+
+        for (const BatchJob& job : jobs)
+        {
+            if (!cartridges.count(job.romPath))
+            {
+                cartridges[job.romPath] = Cartridge::FromFile(job.romPath);
+            }
+        }
+
+        m_Pool.ParallelFor(jobs.size(), [&jobs, &results, &cartridges](const size_t i)
+        {
+            results[i] = RunJob(jobs[i], cartridges.at(jobs[i].romPath));
+        });
+
+        return results;
+    }
+
+    BatchResult BatchRunner::RunJob(const BatchJob& job, const std::shared_ptr<const Cartridge>& pCartridge)
+    {
+        BatchResult result;
+        const auto start = std::chrono::steady_clock::now();
+
+        if (!pCartridge)
+        {
+            result.error = "could not read ROM " + job.romPath;
+            return result;
+        }
+
+        // Built on the worker so its memory is first touched there
+        auto pSystem = std::make_unique<System>();
+        pSystem->LoadCartridge(pCartridge);
+        pSystem->SetSerialCapture(true);
+
+        Movie movie;
+        u64 frames = job.frames;
+
+        if (!job.moviePath.empty())
+        {
+            if (!movie.Load(job.moviePath))
+            {
+                result.error = "could not read movie " + job.moviePath;
+                return result;
+            }
+            if (!pSystem->StartReplay(movie))
+            {
+                result.error = "movie " + job.moviePath + " was not recorded on this ROM";
+                return result;
+            }
+            if (frames == 0ULL)
+            {
+                frames = movie.GetFrameCount();
+            }
+        }
+
+        for (u64 frame = 0; frame < frames; frame++)
+        {
+            pSystem->RunFrame();
+        }
+
+        std::vector<u8> state(pSystem->GetStateSize());
+        pSystem->SaveState(state.data(), state.size());
+
+        result.ok = true;
+        result.frames = frames;
+        result.cycles = pSystem->GetCyclesTaken();
+        result.stateHash = HashBytes(state.data(), state.size());
+        result.serialOutput = pSystem->GetSerialOutput();
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+}
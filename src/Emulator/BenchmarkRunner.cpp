@@ -0,0 +1,83 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "Emulator/BenchmarkRunner.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace GBcc
+{
+    double BenchmarkReport::GetFramesPerSecond() const
+    {
+        return seconds > 0.0 ? frames / seconds : 0.0;
+    }
+
+    double BenchmarkReport::GetInstructionsPerSecond() const
+    {
+        return seconds > 0.0 ? instructions / seconds : 0.0;
+    }
+
+    double BenchmarkReport::GetMeanFrameNs() const
+    {
+        return frames ? seconds * 1e9 / frames : 0.0;
+    }
+
+    u64 BenchmarkReport::GetFrameNsPercentile(const double percentile) const
+    {
+        if (frameNs.empty())
+        {
+            return 0ULL;
+        }
+
+        const double rank = std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0 * frameNs.size());
+        const size_t index = rank < 1.0 ? 0U : static_cast<size_t>(rank) - 1U;
+        return frameNs[std::min(index, frameNs.size() - 1U)];
+    }
+
+    BenchmarkReport BenchmarkRunner::Run(System& system, const u64 frames)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        BenchmarkReport report;
+        report.frameNs.reserve(frames);
+
+        const u64 cyclesBefore = system.GetCyclesTaken();
+        const u64 instructionsBefore = system.GetInstructionCount();
+
+        const auto start = Clock::now();
+        auto frameStart = start;
+
+        for (u64 i = 0; i < frames; i++)
+        {
+            system.RunFrame();
+
+            const auto frameEnd = Clock::now();
+            report.frameNs.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(frameEnd - frameStart).count());
+            frameStart = frameEnd;
+        }
+
+        report.seconds = std::chrono::duration<double>(frameStart - start).count();
+        report.frames = frames;
+        report.cycles = system.GetCyclesTaken() - cyclesBefore;
+        report.instructions = system.GetInstructionCount() - instructionsBefore;
+
+        std::sort(report.frameNs.begin(), report.frameNs.end());
+        return report;
+    }
+}
@@ -0,0 +1,121 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "Emulator/ConformanceRunner.hpp"
+#include "Core/Cartridge.hpp"
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <string_view>
+
+namespace GBcc
+{
+    // Results are looked for once per frame worth of cycles
+    static constexpr u64 CHECK_INTERVAL = 70'224ULL;
+
+    static constexpr std::array<u8, 6U> MOONEYE_PASS = { 3U, 5U, 8U, 13U, 21U, 34U };
+    static constexpr std::array<u8, 6U> MOONEYE_FAIL = { 0x42U, 0x42U, 0x42U, 0x42U, 0x42U, 0x42U };
+
+    static bool Contains(const std::string& text, const std::array<u8, 6U>& bytes)
+    {
+        return text.find(std::string_view(reinterpret_cast<const char*>(bytes.data()), bytes.size())) != std::string::npos;
+    }
+
+    static bool Detect(const System& system, ConformanceResult& result)
+    {
+        const std::string& serial = system.GetSerialOutput();
+
+        if (serial.find("Passed") != std::string::npos || Contains(serial, MOONEYE_PASS))
+        {
+            result = ConformanceResult::PASSED;
+            return true;
+        }
+        if (serial.find("Failed") != std::string::npos || Contains(serial, MOONEYE_FAIL))
+        {
+            result = ConformanceResult::FAILED;
+            return true;
+        }
+
+        const SharpRegisterFile registers = system.GetRegisterFile();
+        const std::array<u8, 6U> values = { registers.b, registers.c, registers.d, registers.e, registers.h, registers.l };
+
+        if (values == MOONEYE_PASS)
+        {
+            result = ConformanceResult::PASSED;
+            return true;
+        }
+        if (values == MOONEYE_FAIL)
+        {
+            result = ConformanceResult::FAILED;
+            return true;
+        }
+        return false;
+    }
+
+    ConformanceReport ConformanceRunner::Run(const std::string& romPath, const u64 cycleBudget)
+    {
+        std::shared_ptr<const Cartridge> pCartridge = Cartridge::FromFile(romPath);
+
+        if (!pCartridge)
+        {
+            return {};
+        }
+
+        auto pSystem = std::make_unique<System>();
+        pSystem->LoadCartridge(pCartridge);
+        return Run(*pSystem, cycleBudget);
+    }
+
+    ConformanceReport ConformanceRunner::Run(System& system, const u64 cycleBudget)
+    {
+        ConformanceReport report;
+        report.result = ConformanceResult::TIMEOUT;
+        system.SetSerialCapture(true);
+
+        const u64 start = system.GetCyclesTaken();
+
+        while (report.cycles < cycleBudget)
+        {
+            system.RunCycles(std::min(CHECK_INTERVAL, cycleBudget - report.cycles));
+            report.cycles = system.GetCyclesTaken() - start;
+
+            if (Detect(system, report.result))
+            {
+                break;
+            }
+        }
+
+        report.serialOutput = system.GetSerialOutput();
+        return report;
+    }
+
+    const char* ConformanceRunner::GetResultName(const ConformanceResult result)
+    {
+        switch (result)
+        {
+            case ConformanceResult::PASSED:
+                return "passed";
+            case ConformanceResult::FAILED:
+                return "failed";
+            case ConformanceResult::TIMEOUT:
+                return "timed out";
+            default:
+                return "could not read ROM";
+        }
+    }
+}
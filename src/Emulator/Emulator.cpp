@@ -17,39 +17,289 @@
 */
 #include "Emulator/Emulator.hpp"
 #include "Video/VideoConstants.hpp"
+#include "Video/Palette.hpp"
 
+#include <algorithm>
 #include <cstdlib>
+#include <iomanip>
+#include <iostream>
 #include <sstream>
 
 namespace GBcc {
-    Emulator::Emulator() : m_Video(Video::GetInstance()) {}
+    constexpr double GB_MIN_SPEED_MULTIPLIER = 0.25;
+    constexpr double GB_MAX_SPEED_MULTIPLIER = 16.0;
+    constexpr auto GB_STATS_WINDOW = std::chrono::milliseconds(500);
+    constexpr size_t GB_REWIND_MEMORY_CAP = 64U << 20U;
+    constexpr u32 GB_REWIND_KEYFRAME_INTERVAL = 60U;
+    constexpr u32 GB_MAX_RUN_AHEAD_FRAMES = 8U;
+    // Longer than any host audio period, a stream that has not drained by
+    // then has no callback behind it
+    constexpr auto GB_AUDIO_SYNC_TIMEOUT = std::chrono::milliseconds(100);
+
+    Emulator::Emulator() : 
+        m_Video(Video::GetInstance()), 
+        m_FramePacer(VideoConstants::GAMEBOY_REFRESH_RATE)
+    {
+        m_System.SetSerialCapture(false);
+    }
     
     Emulator::~Emulator() { }
 
-    void Emulator::LimitFramerate(const float fps)
+    bool Emulator::LoadRom(const std::string& path)
+    {
+        if (!m_System.LoadRom(path))
+        {
+            return false;
+        }
+
+        if (m_pRunAhead)
+        {
+            m_pRunAhead->LoadCartridge(m_System.GetCartridge());
+        }
+        return true;
+    }
+
+    void Emulator::SetPipelinedRendering(const bool enable)
+    {
+        m_System.SetPipelinedRendering(enable);
+    }
+
+    void Emulator::SetSkipUnchangedFrames(const bool skip)
+    {
+        m_Video.SetSkipUnchangedFrames(skip);
+    }
+
+    void Emulator::SetSyncMode(const SyncMode mode)
+    {
+        m_SyncMode = mode;
+        if (m_SyncMode == SyncMode::AUDIO)
+        {
+            SetAudioEnabled(true);
+        }
+        UpdatePacing();
+    }
+
+    void Emulator::SetSpeedMultiplier(const double multiplier)
+    {
+        m_SpeedMultiplier = std::clamp(multiplier, GB_MIN_SPEED_MULTIPLIER, GB_MAX_SPEED_MULTIPLIER);
+        m_AudioStream.SetSpeed(m_SpeedMultiplier);
+        UpdatePacing();
+    }
+
+    void Emulator::SetUncapped(const bool uncapped)
+    {
+        m_Uncapped = uncapped;
+        UpdatePacing();
+    }
+
+    void Emulator::SetRewindSeconds(const double seconds)
+    {
+        if (seconds <= 0.0 || !m_MoviePath.empty())
+        {
+            m_pRewind.reset();
+            return;
+        }
+
+        const size_t frames = static_cast<size_t>(seconds * VideoConstants::GAMEBOY_REFRESH_RATE);
+        m_StateBuffer.resize(m_System.GetStateSize());
+        m_pRewind = std::make_unique<RewindBuffer>(m_StateBuffer.size(), GB_REWIND_MEMORY_CAP, frames, GB_REWIND_KEYFRAME_INTERVAL);
+    }
+
+    void Emulator::SetRunAheadFrames(const u32 frames)
+    {
+        m_RunAheadFrames = std::min(frames, GB_MAX_RUN_AHEAD_FRAMES);
+
+        if (m_RunAheadFrames == 0U)
+        {
+            m_pRunAhead.reset();
+            return;
+        }
+
+        if (!m_pRunAhead)
+        {
+            // Shares the image instead of reading the ROM again
+            m_pRunAhead = std::make_unique<System>();
+            m_pRunAhead->LoadCartridge(m_System.GetCartridge());
+        }
+        m_StateBuffer.resize(m_System.GetStateSize());
+    }
+
+    void Emulator::StartRecording(const std::string& path)
+    {
+        // Rewinding would put input in the movie that no longer happened
+        m_pRewind.reset();
+        m_MoviePath = path;
+        m_System.StartRecording(m_Movie);
+    }
+
+    void Emulator::SetExecLog(const std::string& path)
+    {
+        m_System.SetExecLog(path);
+    }
+
+    u8 Emulator::ReadButtons() const
+    {
+        static constexpr std::array<std::pair<int, JoypadButton>, 8U> keyMap = {{
+            {GLFW_KEY_RIGHT, JOYPAD_RIGHT},
+            {GLFW_KEY_LEFT, JOYPAD_LEFT},
+            {GLFW_KEY_UP, JOYPAD_UP},
+            {GLFW_KEY_DOWN, JOYPAD_DOWN},
+            {GLFW_KEY_X, JOYPAD_A},
+            {GLFW_KEY_Z, JOYPAD_B},
+            {GLFW_KEY_RIGHT_SHIFT, JOYPAD_SELECT},
+            {GLFW_KEY_ENTER, JOYPAD_START}
+        }};
+
+        u8 buttons = 0U;
+        for (const auto& [key, button] : keyMap)
+        {
+            if (m_Video.IsKeyPressed(key))
+            {
+                buttons |= button;
+            }
+        }
+        return buttons;
+    }
+
+    const PPU::Framebuffer& Emulator::RunAhead()
+    {
+        if (!m_pRunAhead)
+        {
+            return m_System.GetFramebuffer();
+        }
+
+        const auto start = Clock::now();
+
+        m_System.SaveState(m_StateBuffer.data(), m_StateBuffer.size());
+        m_pRunAhead->LoadState(m_StateBuffer.data(), m_StateBuffer.size());
+
+        for (u32 i = 0; i < m_RunAheadFrames; i++)
+        {
+            m_pRunAhead->RunFrame();
+        }
+
+        m_StatsWindowRunAhead += Clock::now() - start;
+        m_StatsWindowPresents++;
+
+        return m_pRunAhead->GetFramebuffer();
+    }
+
+    // Returns true when the frame came from the rewind history
+    bool Emulator::StepFrame()
+    {
+        if (m_pRewind && m_Video.IsKeyPressed(GLFW_KEY_BACKSPACE))
+        {
+            if (m_pRewind->Pop(m_StateBuffer.data()))
+            {
+                m_System.LoadState(m_StateBuffer.data(), m_StateBuffer.size());
+            }
+            return true;
+        }
+
+        m_System.SetJoypad(ReadButtons());
+        m_System.RunFrame();
+
+        if (m_pRewind)
+        {
+            m_System.SaveState(m_StateBuffer.data(), m_StateBuffer.size());
+            m_pRewind->Push(m_StateBuffer.data());
+        }
+        return false;
+    }
+
+    void Emulator::SetAudioEnabled(const bool enable)
     {
-        float expectedFrametime = 1e9f / fps;
-        auto chronoExpectedFrametime = std::chrono::nanoseconds(static_cast<u64>(expectedFrametime));
-        auto expectedEndTime = m_StartFrame + chronoExpectedFrametime;
-        while (m_Timer.now() < expectedEndTime) {}
+        m_AudioEnabled = enable;
+        m_System.GetAPU().SetOutputEnabled(enable);
+    }
+
+    AudioStream& Emulator::GetAudioStream()
+    {
+        return m_AudioStream;
+    }
+
+    const EmulatorStats& Emulator::GetStats() const
+    {
+        return m_Stats;
+    }
+
+    bool Emulator::IsFastForwarding() const
+    {
+        return m_Uncapped || m_SpeedMultiplier > 1.0;
+    }
+
+    void Emulator::UpdatePacing()
+    {
+        // Only real time speed can be locked to the display
+        m_Video.SetVSync(m_SyncMode == SyncMode::VSYNC && m_SpeedMultiplier == 1.0 && !m_Uncapped);
+        m_FramePacer.SetFrameRate(VideoConstants::GAMEBOY_REFRESH_RATE * m_SpeedMultiplier);
+    }
+
+    void Emulator::WaitForNextFrame()
+    {
+        // The host callback drains the stream at the audio clock. Should it
+        // stall the timer takes over, restarted so it does not catch up.
+        if (m_SyncMode == SyncMode::AUDIO && m_AudioEnabled)
+        {
+            if (m_AudioStream.WaitForSpace(GB_AUDIO_SYNC_TIMEOUT))
+            {
+                m_FramePacer.Resync();
+                return;
+            }
+        }
+
+        m_FramePacer.WaitForNextFrame();
+    }
+
+    void Emulator::UpdateStats()
+    {
+        m_StatsWindowFrames++;
+
+        const auto now = Clock::now();
+        const auto elapsed = now - m_StatsWindowStart;
+        if (elapsed < GB_STATS_WINDOW)
+        {
+            return;
+        }
+
+        const double seconds = std::chrono::duration<double>(elapsed).count();
+        const u64 cycles = m_System.GetCyclesTaken();
+
+        m_Stats.framesPerSecond = m_StatsWindowFrames / seconds;
+        // Rewinding moves the clock back
+        m_Stats.cpuMHz = cycles >= m_StatsWindowCycles ? (cycles - m_StatsWindowCycles) / seconds / 1e6 : 0.0;
+        m_Stats.speed = m_Stats.framesPerSecond / VideoConstants::GAMEBOY_REFRESH_RATE;
+        m_Stats.runAheadMs = m_StatsWindowPresents ? 
+            std::chrono::duration<double, std::milli>(m_StatsWindowRunAhead).count() / m_StatsWindowPresents : 0.0;
+
+        m_StatsWindowStart = now;
+        m_StatsWindowFrames = 0ULL;
+        m_StatsWindowCycles = cycles;
+        m_StatsWindowPresents = 0ULL;
+        m_StatsWindowRunAhead = Clock::duration::zero();
+
+        std::ostringstream title;
+        title << std::fixed << std::setprecision(1) << "GBcc - " 
+            << m_Stats.framesPerSecond << " fps (" 
+            << std::setprecision(2) << m_Stats.speed << "x), " 
+            << m_Stats.cpuMHz << " MHz";
+
+        if (m_pRunAhead)
+        {
+            title << ", run-ahead " << m_RunAheadFrames << ": " << m_Stats.runAheadMs << " ms";
+        }
+        m_Video.SetTitle(title.str());
     }
 
     void Emulator::Run()
     {    
         std::array<u8, 160U * 144U * 3U> framebuffer = { 0U };
-        std::array<std::array<u8, 3U>, 4U> colorLut ={
-            {
-                {0x08, 0x18, 0x20},
-                {0x34, 0x68, 0x56},
-                {0x88, 0xC0, 0x70},
-                {0xE0, 0xF8, 0xD0}
-            }
-        };
+        const Palette palette;
 
         u64 hScroll = 0;
         u64 vScroll = 0;
 
-        auto DrawChecker = [&framebuffer, colorLut](const u64 hScroll, const u64 vScroll)
+        auto DrawChecker = [&framebuffer, &palette](const u64 hScroll, const u64 vScroll)
         {
             u64 color1 = 0;
             u64 color2 = 2;
@@ -62,11 +312,12 @@ namespace GBcc {
                     constexpr u64 boxRowStride = 20U * 8U * boxPixelStride;
                     size_t start = y * boxRowStride + x * boxPixelStride;
 
-                    u64 color;
+                    u64 shade;
                     if (x % 2 == 0)
-                        color = color1;
+                        shade = color1;
                     else
-                        color = color2;
+                        shade = color2;
+                    const auto& color = palette.GetColor(static_cast<u8>(3U - shade));
 
                     for (size_t boxY = 0; boxY < 8; boxY++)
                     {
@@ -96,31 +347,96 @@ namespace GBcc {
                             if (realIndex > framebufferEnd)
                                 realIndex -= (framebufferEnd + 1);
 
-                            std::copy(colorLut[color].begin(), colorLut[color].end(), framebuffer.begin() + realIndex);
+                            std::copy(color.begin(), color.end(), framebuffer.begin() + realIndex);
                         }
                     }
-                    color ^= 1;
+                    shade ^= 1;
                 }
                 std::swap(color1, color2);
             }
         };
 
+        m_FramePacer.Resync();
+        m_NextPresent = Clock::now();
+        m_StatsWindowStart = Clock::now();
+        m_StatsWindowCycles = m_System.GetCyclesTaken();
+
+        bool frameChanged = true;
+
         while (!m_Video.ShouldClose())
         {
-            m_StartFrame = m_Timer.now();
+            const bool rewound = StepFrame();
+            UpdateStats();
 
-            for (size_t i = 0; i <= 4194304; i += 4)
-                m_System.Step();
-            
-            //DrawChecker(hScroll, vScroll);
-            //m_Video.UpdateTexture(framebuffer);
+            // Uncapped has no meaningful pitch, the APU drops what nobody reads
+            if (m_AudioEnabled && !m_Uncapped)
+            {
+                m_AudioStream.Produce(m_System.GetAPU());
+            }
+
+            frameChanged |= rewound || m_System.FrameChanged();
+
+            // Faster than real time, only present at the display rate
+            if (IsFastForwarding())
+            {
+                const auto now = Clock::now();
+                if (now < m_NextPresent)
+                {
+                    if (!m_Uncapped)
+                    {
+                        WaitForNextFrame();
+                    }
+                    continue;
+                }
+
+                m_NextPresent = now + std::chrono::nanoseconds(
+                    static_cast<u64>(1e9 / VideoConstants::GAMEBOY_REFRESH_RATE)
+                );
+            }
+
+            // A speculative frame is new every time, and rewinding shows the
+            // history as it was
+            const auto& shades = rewound ? m_System.GetFramebuffer() : RunAhead();
+            frameChanged |= m_pRunAhead && !rewound;
+
+            if (frameChanged)
+            {
+                palette.Convert(shades, framebuffer);
+
+                //DrawChecker(hScroll, vScroll);
+                m_Video.UpdateTexture(framebuffer);
+            }
             
-            m_Video.Draw();
+            const bool presented = m_Video.Draw(frameChanged);
+            frameChanged = false;
+
+            // A present already waited on vsync, restart the timer from there.
+            // Skipped presents and timer sync are paced by the timer, audio
+            // sync by the audio stream.
+            if (m_Uncapped)
+            {
+                continue;
+            }
+            else if (presented && m_SyncMode == SyncMode::VSYNC && m_SpeedMultiplier == 1.0)
+            {
+                m_FramePacer.Resync();
+            }
+            else
+            {
+                WaitForNextFrame();
+            }
 
             //hScroll = (hScroll + 1) % VideoConstants::GAMEBOY_SCREEN_WIDTH;
             //vScroll = (vScroll + 1) % VideoConstants::GAMEBOY_SCREEN_HEIGHT;
-            
-            //LimitFramerate(VideoConstants::GAMEBOY_REFRESH_RATE);
+        }
+
+        if (!m_MoviePath.empty())
+        {
+            m_System.StopRecording();
+            if (!m_Movie.Save(m_MoviePath))
+            {
+                std::cerr << "Could not write movie " << m_MoviePath << std::endl;
+            }
         }
     }
 }
\ No newline at end of file
@@ -0,0 +1,104 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Emulator/FramePacer.hpp"
+
+#include <chrono>
+#include <thread>
+
+#if defined(__unix__)
+#include <cerrno>
+#include <time.h>
+#endif
+
+namespace GBcc
+{
+    // Sleeping past this far behind would only make the next frames burst
+    constexpr u64 GB_PACER_MAX_LAG_FRAMES = 4ULL;
+    constexpr u64 GB_PACER_DEFAULT_SPIN_NS = 200'000ULL;
+
+    FramePacer::FramePacer(const double framesPerSecond) : 
+        m_FramePeriodNs(1e9 / framesPerSecond),
+        m_SpinNs(GB_PACER_DEFAULT_SPIN_NS)
+    {
+        Resync();
+    }
+
+    u64 FramePacer::Now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()
+        ).count();
+    }
+
+    void FramePacer::SleepUntil(const u64 deadline)
+    {
+#if defined(__unix__)
+        // steady_clock is CLOCK_MONOTONIC on the platforms we build for
+        timespec target;
+        target.tv_sec = static_cast<time_t>(deadline / 1'000'000'000ULL);
+        target.tv_nsec = static_cast<long>(deadline % 1'000'000'000ULL);
+
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &target, nullptr) == EINTR) {}
+#else
+        std::this_thread::sleep_until(
+            std::chrono::steady_clock::time_point(std::chrono::nanoseconds(deadline))
+        );
+#endif
+    }
+
+    void FramePacer::SetFrameRate(const double framesPerSecond)
+    {
+        m_FramePeriodNs = 1e9 / framesPerSecond;
+        Resync();
+    }
+
+    void FramePacer::SetSpinThreshold(const u64 nanoseconds)
+    {
+        m_SpinNs = nanoseconds;
+    }
+
+    void FramePacer::Resync()
+    {
+        m_Origin = Now();
+        m_FramesSinceOrigin = 0ULL;
+    }
+
+    void FramePacer::WaitForNextFrame()
+    {
+        m_FramesSinceOrigin++;
+        const u64 deadline = m_Origin + static_cast<u64>(m_FramesSinceOrigin * m_FramePeriodNs);
+        const u64 now = Now();
+
+        if (now > deadline)
+        {
+            if (now - deadline > GB_PACER_MAX_LAG_FRAMES * m_FramePeriodNs)
+            {
+                Resync();
+            }
+            return;
+        }
+
+        if (deadline - now > m_SpinNs)
+        {
+            SleepUntil(deadline - m_SpinNs);
+        }
+
+        while (Now() < deadline) {}
+    }
+}
@@ -0,0 +1,325 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Emulator/RewindBuffer.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace GBcc
+{
+    // Records are a series of tokens: a run of zero bytes, then a run of
+    // literal bytes, each count a u16
+    constexpr size_t GB_REWIND_TOKEN_SIZE = 2U * sizeof(u16);
+    constexpr size_t GB_REWIND_MAX_RUN = UINT16_MAX;
+
+    RewindBuffer::RewindBuffer(const size_t stateSize, const size_t memoryCap, const size_t maxSnapshots, const u32 keyframeInterval) : 
+        m_StateSize(stateSize),
+        m_KeyframeInterval(static_cast<u32>(std::clamp<size_t>(keyframeInterval, 1U, std::max<size_t>(maxSnapshots / 2U, 1U)))),
+        m_Data(memoryCap),
+        m_Snapshots(std::max<size_t>(maxSnapshots, 1U)),
+        m_Current(stateSize, 0x00U),
+        // Literal runs are only cut by a token's worth of zeros or a full
+        // run, which bounds the overhead
+        m_Encoded(stateSize + GB_REWIND_TOKEN_SIZE * (stateSize / GB_REWIND_MAX_RUN + 2U)) {}
+
+    RewindBuffer::Snapshot& RewindBuffer::GetSnapshot(const size_t index)
+    {
+        return m_Snapshots[(m_First + index) % m_Snapshots.size()];
+    }
+
+    size_t RewindBuffer::Encode(const u8* state, const bool keyframe)
+    {
+        const u8* const previous = m_Current.data();
+        const size_t length = m_StateSize;
+
+        auto value = [&](const size_t i) -> u8
+        {
+            return keyframe ? state[i] : state[i] ^ previous[i];
+        };
+
+        auto wordIsZero = [&](const size_t i) -> bool
+        {
+            u64 a;
+            u64 b = 0ULL;
+            std::memcpy(&a, state + i, sizeof(u64));
+            if (!keyframe)
+            {
+                std::memcpy(&b, previous + i, sizeof(u64));
+            }
+            return a == b;
+        };
+
+        u8* const out = m_Encoded.data();
+        size_t size = 0;
+        size_t i = 0;
+
+        while (i < length)
+        {
+            size_t zeros = 0;
+            while (i + sizeof(u64) <= length && zeros + sizeof(u64) <= GB_REWIND_MAX_RUN && wordIsZero(i))
+            {
+                i += sizeof(u64);
+                zeros += sizeof(u64);
+            }
+            while (i < length && zeros < GB_REWIND_MAX_RUN && value(i) == 0U)
+            {
+                i++;
+                zeros++;
+            }
+
+            // Short gaps of zeros are cheaper inside the literals than as a
+            // new token
+            const size_t literalStart = i;
+            size_t literals = 0;
+            while (i < length && literals < GB_REWIND_MAX_RUN)
+            {
+                if (value(i) == 0U)
+                {
+                    size_t gap = 1U;
+                    while (i + gap < length && gap < GB_REWIND_TOKEN_SIZE && value(i + gap) == 0U)
+                    {
+                        gap++;
+                    }
+
+                    if (gap == GB_REWIND_TOKEN_SIZE || i + gap == length || literals + gap > GB_REWIND_MAX_RUN)
+                    {
+                        break;
+                    }
+
+                    i += gap;
+                    literals += gap;
+                    continue;
+                }
+
+                i++;
+                literals++;
+            }
+
+            const u16 token[2] = { static_cast<u16>(zeros), static_cast<u16>(literals) };
+            std::memcpy(out + size, token, GB_REWIND_TOKEN_SIZE);
+            size += GB_REWIND_TOKEN_SIZE;
+
+            for (size_t j = 0; j < literals; j++)
+            {
+                out[size + j] = value(literalStart + j);
+            }
+            size += literals;
+        }
+
+        return size;
+    }
+
+    // Keyframes overwrite the target, deltas are XORed into it
+    void RewindBuffer::Decode(const Snapshot& snapshot, u8* target) const
+    {
+        const u8* in = m_Data.data() + snapshot.offset;
+        const u8* const end = in + snapshot.size;
+        u8* out = target;
+
+        while (in < end)
+        {
+            u16 token[2];
+            std::memcpy(token, in, GB_REWIND_TOKEN_SIZE);
+            in += GB_REWIND_TOKEN_SIZE;
+
+            if (snapshot.keyframe)
+            {
+                std::memset(out, 0, token[0]);
+                std::memcpy(out + token[0], in, token[1]);
+            }
+            else
+            {
+                u8* const literals = out + token[0];
+                for (size_t i = 0; i < token[1]; i++)
+                {
+                    literals[i] ^= in[i];
+                }
+            }
+
+            out += token[0] + token[1];
+            in += token[1];
+        }
+    }
+
+    bool RewindBuffer::Reserve(const size_t size, size_t& offset)
+    {
+        while (true)
+        {
+            if (m_Count == 0)
+            {
+                offset = 0;
+                return size <= m_Data.size();
+            }
+
+            if (m_Count < m_Snapshots.size())
+            {
+                const size_t oldest = GetSnapshot(0).offset;
+
+                if (m_WriteOffset > oldest)
+                {
+                    if (m_WriteOffset + size <= m_Data.size())
+                    {
+                        offset = m_WriteOffset;
+                        return true;
+                    }
+                    if (size <= oldest)
+                    {
+                        offset = 0;
+                        return true;
+                    }
+                }
+                else if (m_WriteOffset + size <= oldest)
+                {
+                    offset = m_WriteOffset;
+                    return true;
+                }
+            }
+
+            if (!DropOldestGroup())
+            {
+                return false;
+            }
+        }
+    }
+
+    // The deltas after a keyframe can only be rebuilt from it, so they go
+    // with it. The newest group is never dropped.
+    bool RewindBuffer::DropOldestGroup()
+    {
+        size_t next = 1U;
+        while (next < m_Count && !GetSnapshot(next).keyframe)
+        {
+            next++;
+        }
+
+        if (next == m_Count)
+        {
+            return false;
+        }
+
+        for (size_t i = 0; i < next; i++)
+        {
+            m_Used -= GetSnapshot(i).size;
+        }
+
+        m_First = (m_First + next) % m_Snapshots.size();
+        m_Count -= next;
+        return true;
+    }
+
+    void RewindBuffer::Push(const u8* state)
+    {
+        bool keyframe = m_Count == 0 || m_SinceKeyframe >= m_KeyframeInterval;
+        size_t size = Encode(state, keyframe);
+        size_t offset;
+
+        if (!Reserve(size, offset))
+        {
+            // Only the newest group is left and it has outgrown the buffer
+            Clear();
+            keyframe = true;
+            size = Encode(state, keyframe);
+
+            if (!Reserve(size, offset))
+            {
+                return;
+            }
+        }
+
+        std::memcpy(m_Data.data() + offset, m_Encoded.data(), size);
+        m_Count++;
+        GetSnapshot(m_Count - 1U) = { offset, size, keyframe };
+
+        m_WriteOffset = offset + size;
+        m_Used += size;
+        m_SinceKeyframe = keyframe ? 1U : m_SinceKeyframe + 1U;
+        std::memcpy(m_Current.data(), state, m_StateSize);
+    }
+
+    bool RewindBuffer::Pop(u8* state)
+    {
+        if (m_Count == 0)
+        {
+            return false;
+        }
+
+        std::memcpy(state, m_Current.data(), m_StateSize);
+        StepBack();
+        return true;
+    }
+
+    void RewindBuffer::StepBack()
+    {
+        const Snapshot newest = GetSnapshot(m_Count - 1U);
+        m_Count--;
+        m_Used -= newest.size;
+        m_WriteOffset = newest.offset;
+
+        if (m_Count == 0)
+        {
+            Clear();
+            return;
+        }
+
+        if (!newest.keyframe)
+        {
+            // XOR undoes itself
+            Decode(newest, m_Current.data());
+        }
+        else
+        {
+            // Crossing a keyframe, replay the group before it
+            size_t keyframe = m_Count - 1U;
+            while (!GetSnapshot(keyframe).keyframe)
+            {
+                keyframe--;
+            }
+
+            for (size_t i = keyframe; i < m_Count; i++)
+            {
+                Decode(GetSnapshot(i), m_Current.data());
+            }
+        }
+
+        m_SinceKeyframe = 1U;
+        for (size_t i = m_Count - 1U; !GetSnapshot(i).keyframe; i--)
+        {
+            m_SinceKeyframe++;
+        }
+    }
+
+    void RewindBuffer::Clear()
+    {
+        m_First = 0;
+        m_Count = 0;
+        m_Used = 0;
+        m_WriteOffset = 0;
+        m_SinceKeyframe = 0U;
+    }
+
+    size_t RewindBuffer::Size() const
+    {
+        return m_Count;
+    }
+
+    size_t RewindBuffer::MemoryUsed() const
+    {
+        return m_Used;
+    }
+}
@@ -0,0 +1,175 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "Emulator/ThreadPool.hpp"
+
+#include <algorithm>
+
+namespace GBcc
+{
+    ThreadPool::ThreadPool(const size_t threads) : 
+        m_ThreadCount(threads ? threads : std::max(1U, std::thread::hardware_concurrency()))
+    {
+        for (size_t i = 0; i < m_ThreadCount; i++)
+        {
+            m_Queues.push_back(std::make_unique<Queue>());
+        }
+
+        // The calling thread is worker 0
+        for (size_t worker = 1; worker < m_ThreadCount; worker++)
+        {
+            m_Threads.emplace_back(&ThreadPool::WorkerLoop, this, worker);
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard lock(m_Mutex);
+            m_Stop = true;
+        }
+        m_Start.notify_all();
+
+        for (auto& thread : m_Threads)
+        {
+            thread.join();
+        }
+    }
+
+    size_t ThreadPool::GetThreadCount() const
+    {
+        return m_ThreadCount;
+    }
+
+    bool ThreadPool::Pop(const size_t worker, size_t& task)
+    {
+        Queue& queue = *m_Queues[worker];
+        std::lock_guard lock(queue.mutex);
+
+        if (queue.tasks.empty())
+        {
+            return false;
+        }
+
+        task = queue.tasks.back();
+        queue.tasks.pop_back();
+        return true;
+    }
+
+    bool ThreadPool::Steal(const size_t worker, size_t& task)
+    {
+        for (size_t i = 1; i < m_ThreadCount; i++)
+        {
+            Queue& victim = *m_Queues[(worker + i) % m_ThreadCount];
+            std::lock_guard lock(victim.mutex);
+
+            if (!victim.tasks.empty())
+            {
+                task = victim.tasks.front();
+                victim.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void ThreadPool::Work(const size_t worker, const std::function<void(const size_t)>& task)
+    {
+        // Nothing is queued while running, once stealing fails everything
+        // left is already being worked on
+        size_t index;
+        while (Pop(worker, index) || Steal(worker, index))
+        {
+            task(index);
+        }
+    }
+
+    void ThreadPool::WorkerLoop(const size_t worker)
+    {
+        u64 epoch = 0ULL;
+
+        while (true)
+        {
+            const std::function<void(const size_t)>* pTask;
+            {
+                std::unique_lock lock(m_Mutex);
+                m_Start.wait(lock, [&]() { return m_Stop || m_Epoch != epoch; });
+
+                if (m_Stop)
+                {
+                    return;
+                }
+
+                // A call never returns before its workers are done, so one
+                // that skips this worker is the only epoch it can miss
+                epoch = m_Epoch;
+                if (worker >= m_Workers)
+                {
+                    continue;
+                }
+                pTask = m_pTask;
+            }
+
+            Work(worker, *pTask);
+
+            std::lock_guard lock(m_Mutex);
+            if (--m_Running == 0U)
+            {
+                m_Done.notify_one();
+            }
+        }
+    }
+
+    void ThreadPool::ParallelFor(const size_t count, const std::function<void(const size_t)>& task)
+    {
+        const size_t workers = std::min(m_ThreadCount, count);
+        if (workers == 0U)
+        {
+            return;
+        }
+
+        // Contiguous blocks, pushed in reverse so a worker runs its own in
+        // order while thieves take from the far end
+        for (size_t worker = 0; worker < workers; worker++)
+        {
+            const size_t begin = count * worker / workers;
+            const size_t end = count * (worker + 1U) / workers;
+
+            for (size_t i = end; i-- > begin;)
+            {
+                m_Queues[worker]->tasks.push_back(i);
+            }
+        }
+
+        if (workers > 1U)
+        {
+            {
+                std::lock_guard lock(m_Mutex);
+                m_pTask = &task;
+                m_Workers = workers;
+                m_Running = workers - 1U;
+                m_Epoch++;
+            }
+            m_Start.notify_all();
+        }
+
+        Work(0U, task);
+
+        std::unique_lock lock(m_Mutex);
+        m_Done.wait(lock, [&]() { return m_Running == 0U; });
+    }
+}
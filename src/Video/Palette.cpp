@@ -0,0 +1,60 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "Video/Palette.hpp"
+
+#include <algorithm>
+
+namespace GBcc
+{
+    Palette::Palette() :
+        m_Colors({
+            {
+                {0x08, 0x18, 0x20},
+                {0x34, 0x68, 0x56},
+                {0x88, 0xC0, 0x70},
+                {0xE0, 0xF8, 0xD0}
+            }
+        })
+    {
+    }
+
+    Palette::Palette(const Colors& colors) :
+        m_Colors(colors)
+    {
+    }
+
+    const Palette::Color& Palette::GetColor(const u8 shade) const
+    {
+        return m_Colors[3U - (shade & 0x03U)];
+    }
+
+    bool Palette::Convert(std::span<const u8> shades, std::span<u8> rgb) const
+    {
+        if (rgb.size() < shades.size() * 3U)
+        {
+            return false;
+        }
+
+        for (size_t i = 0; i < shades.size(); i++)
+        {
+            const auto& color = GetColor(shades[i]);
+            std::copy(color.begin(), color.end(), rgb.begin() + i * 3U);
+        }
+        return true;
+    }
+}
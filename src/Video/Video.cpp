@@ -86,6 +86,7 @@ namespace GBcc
             exit(-1);
         }
         glfwMakeContextCurrent(m_Window);
+        glfwSwapInterval(1);
 
         if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
         {
@@ -241,8 +242,15 @@ namespace GBcc
         glBindTexture(GL_TEXTURE_2D, 0);
     }
 
-    void Video::Draw()
+    bool Video::Draw(const bool frameChanged)
     {
+        // The back buffer would hold the same image, keep showing the front one
+        if (!frameChanged && m_SkipUnchangedFrames)
+        {
+            glfwPollEvents();
+            return false;
+        }
+
         glClear(GL_COLOR_BUFFER_BIT);
         glUseProgram(m_ShaderProgram);
 
@@ -254,13 +262,33 @@ namespace GBcc
 
         glBindTexture(GL_TEXTURE_2D, 0);
 
-        glfwSwapInterval(1);
         glfwSwapBuffers(m_Window);
         glfwPollEvents();
+        return true;
+    }
+
+    void Video::SetSkipUnchangedFrames(const bool skip)
+    {
+        m_SkipUnchangedFrames = skip;
+    }
+
+    void Video::SetVSync(const bool enable)
+    {
+        glfwSwapInterval(enable ? 1 : 0);
+    }
+
+    void Video::SetTitle(const std::string& title)
+    {
+        glfwSetWindowTitle(m_Window, title.c_str());
     }
 
     bool Video::ShouldClose()
     {
         return glfwWindowShouldClose(m_Window);
     }
+
+    bool Video::IsKeyPressed(const int key)
+    {
+        return glfwGetKey(m_Window, key) == GLFW_PRESS;
+    }
 }
\ No newline at end of file
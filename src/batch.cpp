@@ -0,0 +1,165 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "Emulator/BatchRunner.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+namespace {
+    // One job per line, tab separated: frames, ROM path and optionally a
+    // movie. Empty lines and lines starting with # are skipped.
+    std::vector<GBcc::BatchJob> ReadJobs(const std::string& path)
+    {
+        std::ifstream file(path);
+        if (!file)
+        {
+            std::cerr << "Could not open job file " << path << std::endl;
+            exit(-1);
+        }
+
+        std::vector<GBcc::BatchJob> jobs;
+        std::string line;
+
+        while (std::getline(file, line))
+        {
+            if (line.empty() || line[0] == '#')
+            {
+                continue;
+            }
+
+            std::istringstream fields(line);
+            std::string frames;
+            GBcc::BatchJob job;
+
+            std::getline(fields, frames, '\t');
+            std::getline(fields, job.romPath, '\t');
+            std::getline(fields, job.moviePath, '\t');
+            job.frames = std::strtoull(frames.c_str(), nullptr, 10);
+
+            if (job.romPath.empty())
+            {
+                std::cerr << "Job without a ROM: " << line << std::endl;
+                exit(-1);
+            }
+            jobs.push_back(job);
+        }
+
+        return jobs;
+    }
+
+    std::string Escape(const std::string& text)
+    {
+        std::ostringstream escaped;
+        for (const char c : text)
+        {
+            if (c == '\n')
+            {
+                escaped << "\\n";
+            }
+            else if (c < 0x20 || c > 0x7E)
+            {
+                escaped << "\\x" << std::hex << std::setw(2) << std::setfill('0') << (static_cast<int>(c) & 0xFF) << std::dec;
+            }
+            else
+            {
+                escaped << c;
+            }
+        }
+        return escaped.str();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    size_t threads = 0U;
+    size_t repeat = 1U;
+    std::string jobPath;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string_view argument = argv[i];
+
+        if (argument == "--threads" && i + 1 < argc)
+        {
+            threads = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if (argument == "--repeat" && i + 1 < argc)
+        {
+            repeat = std::max(1UL, std::strtoul(argv[++i], nullptr, 10));
+        }
+        else
+        {
+            jobPath = argument;
+        }
+    }
+
+    if (jobPath.empty())
+    {
+        std::cerr << "Usage: GBccBatch [--threads N] [--repeat N] <job file>" << std::endl;
+        exit(-1);
+    }
+
+    const auto fileJobs = ReadJobs(jobPath);
+    std::vector<GBcc::BatchJob> jobs;
+    for (size_t i = 0; i < repeat; i++)
+    {
+        jobs.insert(jobs.end(), fileJobs.begin(), fileJobs.end());
+    }
+
+    GBcc::BatchRunner runner(threads);
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto results = runner.Run(jobs);
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    GBcc::u64 totalFrames = 0ULL;
+    int failed = 0;
+
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const auto& result = results[i];
+
+        if (!result.ok)
+        {
+            std::cout << i << " " << jobs[i].romPath << ": " << result.error << std::endl;
+            failed++;
+            continue;
+        }
+
+        totalFrames += result.frames;
+        std::cout << i << " " << jobs[i].romPath << ": " 
+            << result.frames << " frames, " 
+            << result.cycles << " cycles, " 
+            << std::fixed << std::setprecision(1) << result.seconds * 1e3 << " ms, state " 
+            << std::hex << std::setw(16) << std::setfill('0') << result.stateHash << std::dec << std::setfill(' ') 
+            << ", serial \"" << Escape(result.serialOutput) << "\"" << std::endl;
+    }
+
+    std::cout << results.size() << " instances on " << runner.GetThreadCount() << " threads in " 
+        << std::setprecision(3) << seconds << " s, " 
+        << std::setprecision(0) << totalFrames / seconds << " frames/s" << std::endl;
+
+    return failed ? 1 : 0;
+}
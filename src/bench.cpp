@@ -0,0 +1,536 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "Core/System.hpp"
+#include "Core/PPU/Renderer.hpp"
+#include "Video/Palette.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+    using GBcc::u8;
+    using GBcc::u16;
+    using GBcc::u64;
+
+    // A case runs one batch and returns how many ops were in it
+    struct BenchCase
+    {
+        std::string name;
+        std::string unit;
+        std::function<u64()> batch;
+    };
+
+    struct BenchResult
+    {
+        u64 iterations;
+        u64 ops;
+        double seconds;
+    };
+
+    // Keeps reads from being optimized away
+    volatile u64 g_Sink = 0ULL;
+
+    BenchResult Measure(const BenchCase& benchCase, const double minSeconds)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        // Warm up caches and lazy state before timing
+        benchCase.batch();
+
+        BenchResult result = {};
+        const auto start = Clock::now();
+        do
+        {
+            result.ops += benchCase.batch();
+            result.iterations++;
+            result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        } while (result.seconds < minSeconds);
+
+        return result;
+    }
+
+    struct Instruction
+    {
+        std::string name;
+        std::vector<u8> bytes;
+        // Instructions and cycles in bytes
+        u64 count;
+        u64 cycles;
+    };
+
+    constexpr u16 BENCH_PROGRAM_START = 0x0150U;
+    constexpr u64 BENCH_REPEATS = 1024U;
+    constexpr u64 BENCH_PASSES = 16U;
+    constexpr u64 BENCH_JUMP_CYCLES = 16U;
+    constexpr u64 BENCH_ACCESSES = 4096U;
+
+    // The program turns the LCD off so the PPU stays out of the numbers,
+    // points HL at WRAM and SP at the top of it, then loops over the same
+    // instruction. Calls go to a RET at 0x0000.
+    BenchCase MakeInstructionCase(const std::string& group, const Instruction& instruction)
+    {
+        std::vector<u8> rom(GBcc::GB_ROM_SIZE, 0x00U);
+        const std::vector<u8> prologue = {
+            0xAFU, 0xE0U, 0x40U,
+            0x21U, 0x00U, 0xC0U,
+            0x31U, 0xF0U, 0xDFU
+        };
+
+        rom[0x0000U] = 0xC9U;
+        rom[0x0100U] = 0x00U;
+        rom[0x0101U] = 0xC3U;
+        rom[0x0102U] = BENCH_PROGRAM_START & 0xFFU;
+        rom[0x0103U] = BENCH_PROGRAM_START >> 8U;
+
+        size_t address = BENCH_PROGRAM_START;
+        for (const u8 byte : prologue)
+        {
+            rom[address++] = byte;
+        }
+
+        const u16 loop = static_cast<u16>(address);
+        for (u64 i = 0; i < BENCH_REPEATS; i++)
+        {
+            for (const u8 byte : instruction.bytes)
+            {
+                rom[address++] = byte;
+            }
+        }
+        rom[address++] = 0xC3U;
+        rom[address++] = loop & 0xFFU;
+        rom[address++] = loop >> 8U;
+
+        auto pSystem = std::make_shared<GBcc::System>();
+        pSystem->LoadRom(rom.data(), rom.size());
+        pSystem->RunCycles(64U);
+
+        const u64 passCycles = BENCH_REPEATS * instruction.cycles + BENCH_JUMP_CYCLES;
+        const u64 passCount = BENCH_REPEATS * instruction.count + 1U;
+
+        return {
+            group + "/" + instruction.name,
+            "instruction",
+            [pSystem, passCycles, passCount]()
+            {
+                const u64 cycles = pSystem->RunCycles(BENCH_PASSES * passCycles);
+                return cycles * passCount / passCycles;
+            }
+        };
+    }
+
+    void AddDispatchCases(std::vector<BenchCase>& cases)
+    {
+        const std::vector<Instruction> instructions = {
+            { "nop",            { 0x00U },                      1U, 4U },
+            { "ld_r_r",         { 0x41U },                      1U, 4U },
+            { "ld_r_d8",        { 0x06U, 0x12U },               1U, 8U },
+            { "ld_r_(hl)",      { 0x7EU },                      1U, 8U },
+            { "ld_(hl)_r",      { 0x77U },                      1U, 8U },
+            { "ldh_a_(a8)",     { 0xF0U, 0x80U },               1U, 12U },
+            { "inc_rr",         { 0x03U },                      1U, 8U },
+            { "push_pop",       { 0xC5U, 0xC1U },               2U, 28U },
+            { "jr",             { 0x18U, 0x00U },               1U, 12U },
+            { "call_ret",       { 0xCDU, 0x00U, 0x00U },        2U, 40U },
+            { "cb_bit",         { 0xCBU, 0x40U },               1U, 8U }
+        };
+
+        for (const auto& instruction : instructions)
+        {
+            cases.push_back(MakeInstructionCase("dispatch", instruction));
+        }
+    }
+
+    // Flag computation is private to the CPU, so it is timed through the
+    // instructions that do it
+    void AddAluCases(std::vector<BenchCase>& cases)
+    {
+        const std::vector<Instruction> instructions = {
+            { "add",            { 0x80U },                      1U, 4U },
+            { "adc",            { 0x88U },                      1U, 4U },
+            { "sub",            { 0x90U },                      1U, 4U },
+            { "sbc",            { 0x98U },                      1U, 4U },
+            { "and",            { 0xA0U },                      1U, 4U },
+            { "xor",            { 0xA8U },                      1U, 4U },
+            { "or",             { 0xB0U },                      1U, 4U },
+            { "cp",             { 0xB8U },                      1U, 4U },
+            { "inc",            { 0x04U },                      1U, 4U },
+            { "dec",            { 0x05U },                      1U, 4U },
+            { "daa",            { 0x27U },                      1U, 4U },
+            { "add_hl_rr",      { 0x09U },                      1U, 8U },
+            { "cb_rl",          { 0xCBU, 0x11U },               1U, 8U },
+            { "cb_swap",        { 0xCBU, 0x37U },               1U, 8U }
+        };
+
+        for (const auto& instruction : instructions)
+        {
+            cases.push_back(MakeInstructionCase("alu", instruction));
+        }
+    }
+
+    void AddMemoryCases(std::vector<BenchCase>& cases)
+    {
+        struct Region
+        {
+            std::string name;
+            u16 base;
+            u16 mask;
+        };
+
+        const std::vector<Region> regions = {
+            { "rom",    0x0150U,    0x0FFFU },
+            { "vram",   0x8000U,    0x1FFFU },
+            { "eram",   0xA000U,    0x1FFFU },
+            { "wram",   0xC000U,    0x1FFFU },
+            { "echo",   0xE000U,    0x0FFFU },
+            { "oam",    0xFE00U,    0x007FU },
+            { "io",     0xFF01U,    0x0000U },
+            { "hram",   0xFF80U,    0x003FU }
+        };
+
+        auto pSystem = std::make_shared<GBcc::System>();
+
+        for (const auto& region : regions)
+        {
+            cases.push_back({
+                "memory/read_" + region.name,
+                "access",
+                [pSystem, region]()
+                {
+                    auto& memory = pSystem->GetMemory();
+                    u64 sum = 0ULL;
+                    for (u64 i = 0; i < BENCH_ACCESSES; i++)
+                    {
+                        sum += memory.ReadWord(static_cast<u16>(region.base + (i & region.mask)));
+                    }
+                    g_Sink = g_Sink + sum;
+                    return BENCH_ACCESSES;
+                }
+            });
+
+            cases.push_back({
+                "memory/write_" + region.name,
+                "access",
+                [pSystem, region]()
+                {
+                    auto& memory = pSystem->GetMemory();
+                    for (u64 i = 0; i < BENCH_ACCESSES; i++)
+                    {
+                        memory.WriteWord(static_cast<u16>(region.base + (i & region.mask)), static_cast<u8>(i));
+                    }
+                    return BENCH_ACCESSES;
+                }
+            });
+        }
+    }
+
+    void AddRegisterCases(std::vector<BenchCase>& cases)
+    {
+        struct RegisterPair
+        {
+            GBcc::ByteRegister high;
+            GBcc::ByteRegister low;
+            GBcc::SharpRegister pair;
+
+            RegisterPair() :
+                high(0x12U),
+                low(0x34U),
+                pair(high, low)
+            {
+            }
+        };
+
+        auto pRegisters = std::make_shared<RegisterPair>();
+
+        cases.push_back({
+            "register/get_pair",
+            "access",
+            [pRegisters]()
+            {
+                u64 sum = 0ULL;
+                for (u64 i = 0; i < BENCH_ACCESSES; i++)
+                {
+                    sum += pRegisters->pair.GetDoubleWord();
+                }
+                g_Sink = g_Sink + sum;
+                return BENCH_ACCESSES;
+            }
+        });
+
+        cases.push_back({
+            "register/set_pair",
+            "access",
+            [pRegisters]()
+            {
+                for (u64 i = 0; i < BENCH_ACCESSES; i++)
+                {
+                    pRegisters->pair.SetDoubleWord(static_cast<u16>(i));
+                }
+                return BENCH_ACCESSES;
+            }
+        });
+
+        cases.push_back({
+            "register/increment_pair",
+            "access",
+            [pRegisters]()
+            {
+                for (u64 i = 0; i < BENCH_ACCESSES; i++)
+                {
+                    pRegisters->pair.SetDoubleWord(pRegisters->pair.GetDoubleWord() + 1U);
+                }
+                return BENCH_ACCESSES;
+            }
+        });
+    }
+
+    // A full frame of tiles with every pixel value in use, drawn straight
+    // from arrays so only the renderer is timed
+    struct RenderTarget
+    {
+        std::array<u8, GBcc::GB_VRAM_SIZE> videoRam;
+        std::array<u8, GBcc::GB_OAM_SIZE> oam;
+        GBcc::SpriteIndex spriteIndex;
+        GBcc::RasterLog rasterLog;
+        GBcc::Renderer::Framebuffer framebuffer;
+        GBcc::Renderer renderer;
+
+        RenderTarget(const GBcc::RasterRegisters& registers) :
+            videoRam({}),
+            oam({}),
+            renderer(registers)
+        {
+            u64 seed = 0x9E3779B97F4A7C15ULL;
+            for (auto& byte : videoRam)
+            {
+                seed ^= seed << 13U;
+                seed ^= seed >> 7U;
+                seed ^= seed << 17U;
+                byte = static_cast<u8>(seed);
+            }
+
+            for (size_t i = 0; i < GBcc::GB_OAM_ENTRY_COUNT; i++)
+            {
+                oam[i * GBcc::GB_OAM_ENTRY_SIZE + GBcc::GB_OAM_Y_OFFSET] = static_cast<u8>(16U + (i * 13U) % 144U);
+                oam[i * GBcc::GB_OAM_ENTRY_SIZE + GBcc::GB_OAM_X_OFFSET] = static_cast<u8>(8U + (i * 29U) % 160U);
+                oam[i * GBcc::GB_OAM_ENTRY_SIZE + GBcc::GB_OAM_TILE_OFFSET] = static_cast<u8>(i);
+                oam[i * GBcc::GB_OAM_ENTRY_SIZE + GBcc::GB_OAM_FLAGS_OFFSET] = static_cast<u8>((i & 0x03U) << 5U);
+            }
+            spriteIndex.OnOamTransfer(oam);
+
+            renderer.SetSource({ videoRam.data(), oam.data(), &spriteIndex, &rasterLog });
+            renderer.SetTarget(&framebuffer);
+        }
+
+        void RenderFrame()
+        {
+            renderer.BeginFrame();
+            renderer.RenderLinesUntil(GBcc::GB_CYCLES_PER_FRAME);
+        }
+    };
+
+    void AddRenderCases(std::vector<BenchCase>& cases)
+    {
+        struct Layers
+        {
+            std::string name;
+            u8 lcdc;
+        };
+
+        const std::vector<Layers> layers = {
+            { "background",             0x91U },
+            { "background_window",      0xB1U },
+            { "background_sprites",     0x93U },
+            { "all",                    0xB3U }
+        };
+
+        for (const auto& layer : layers)
+        {
+            GBcc::RasterRegisters registers = {};
+            registers[GBcc::RASTER_LCDC] = layer.lcdc;
+            registers[GBcc::RASTER_SCX] = 3U;
+            registers[GBcc::RASTER_SCY] = 5U;
+            registers[GBcc::RASTER_BGP] = 0xE4U;
+            registers[GBcc::RASTER_OBP0] = 0xD2U;
+            registers[GBcc::RASTER_OBP1] = 0x1BU;
+            registers[GBcc::RASTER_WY] = 40U;
+            registers[GBcc::RASTER_WX] = 47U;
+
+            auto pTarget = std::make_shared<RenderTarget>(registers);
+
+            cases.push_back({
+                "tiles/" + layer.name,
+                "frame",
+                [pTarget]()
+                {
+                    pTarget->RenderFrame();
+                    g_Sink = g_Sink + pTarget->framebuffer[g_Sink % pTarget->framebuffer.size()];
+                    return 1ULL;
+                }
+            });
+        }
+    }
+
+    void AddTextureCases(std::vector<BenchCase>& cases)
+    {
+        struct Frames
+        {
+            GBcc::Renderer::Framebuffer shades;
+            std::array<u8, GBcc::VideoConstants::FRAMEBUFFER_SIZE> rgb;
+            GBcc::Palette palette;
+        };
+
+        auto pFrames = std::make_shared<Frames>();
+        for (size_t i = 0; i < pFrames->shades.size(); i++)
+        {
+            pFrames->shades[i] = static_cast<u8>((i * 7U + i / 160U) & 0x03U);
+        }
+
+        cases.push_back({
+            "texture/convert",
+            "frame",
+            [pFrames]()
+            {
+                pFrames->palette.Convert(pFrames->shades, pFrames->rgb);
+                g_Sink = g_Sink + pFrames->rgb[g_Sink % pFrames->rgb.size()];
+                return 1ULL;
+            }
+        });
+    }
+
+    void WriteJson(std::ostream& out, const std::vector<BenchCase>& cases, const std::vector<BenchResult>& results, const double minSeconds)
+    {
+        out << "{\n";
+        out << "  \"context\": {\n";
+        out << "    \"executable\": \"GBccBench\",\n";
+        out << "    \"min_time\": " << minSeconds << "\n";
+        out << "  },\n";
+        out << "  \"benchmarks\": [";
+
+        for (size_t i = 0; i < cases.size(); i++)
+        {
+            const auto& result = results[i];
+            const double nsPerOp = result.seconds * 1e9 / static_cast<double>(result.ops);
+
+            out << (i ? "," : "") << "\n    {"
+                << "\"name\": \"" << cases[i].name << "\", "
+                << "\"unit\": \"" << cases[i].unit << "\", "
+                << "\"iterations\": " << result.iterations << ", "
+                << "\"ops\": " << result.ops << ", "
+                << std::fixed << std::setprecision(3)
+                << "\"ns_per_op\": " << nsPerOp << ", "
+                << std::setprecision(0)
+                << "\"ops_per_second\": " << 1e9 / nsPerOp
+                << std::defaultfloat << "}";
+        }
+
+        out << "\n  ]\n}" << std::endl;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    double minSeconds = 0.2;
+    std::string filter;
+    std::string outPath;
+    bool list = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string_view argument = argv[i];
+
+        if (argument == "--min-time" && i + 1 < argc)
+        {
+            minSeconds = std::strtod(argv[++i], nullptr);
+        }
+        else if (argument == "--filter" && i + 1 < argc)
+        {
+            filter = argv[++i];
+        }
+        else if (argument == "--out" && i + 1 < argc)
+        {
+            outPath = argv[++i];
+        }
+        else if (argument == "--list")
+        {
+            list = true;
+        }
+        else
+        {
+            std::cerr << "Usage: GBccBench [--filter TEXT] [--min-time SECONDS] [--out FILE] [--list]" << std::endl;
+            exit(-1);
+        }
+    }
+
+    std::vector<BenchCase> allCases;
+    AddDispatchCases(allCases);
+    AddAluCases(allCases);
+    AddMemoryCases(allCases);
+    AddRegisterCases(allCases);
+    AddRenderCases(allCases);
+    AddTextureCases(allCases);
+
+    std::vector<BenchCase> cases;
+    for (auto& benchCase : allCases)
+    {
+        if (benchCase.name.find(filter) != std::string::npos)
+        {
+            cases.push_back(std::move(benchCase));
+        }
+    }
+
+    if (list)
+    {
+        for (const auto& benchCase : cases)
+        {
+            std::cout << benchCase.name << std::endl;
+        }
+        return 0;
+    }
+
+    std::vector<BenchResult> results;
+    for (const auto& benchCase : cases)
+    {
+        results.push_back(Measure(benchCase, minSeconds));
+    }
+
+    if (outPath.empty())
+    {
+        WriteJson(std::cout, cases, results, minSeconds);
+        return 0;
+    }
+
+    std::ofstream file(outPath);
+    if (!file)
+    {
+        std::cerr << "Could not open " << outPath << std::endl;
+        exit(-1);
+    }
+    WriteJson(file, cases, results, minSeconds);
+
+    return 0;
+}
@@ -0,0 +1,61 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "Emulator/ConformanceRunner.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+int main(int argc, char** argv)
+{
+    GBcc::u64 cycles = GBcc::GB_CONFORMANCE_CYCLE_BUDGET;
+    std::string romPath;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string_view argument = argv[i];
+
+        if (argument == "--cycles" && i + 1 < argc)
+        {
+            cycles = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else
+        {
+            romPath = argument;
+        }
+    }
+
+    if (romPath.empty())
+    {
+        std::cerr << "Usage: GBccConformance [--cycles N] <test ROM>" << std::endl;
+        exit(-1);
+    }
+
+    const GBcc::ConformanceReport report = GBcc::ConformanceRunner::Run(romPath, cycles);
+
+    std::cout << romPath << ": " << GBcc::ConformanceRunner::GetResultName(report.result) 
+        << " after " << report.cycles << " cycles" << std::endl;
+
+    if (report.result != GBcc::ConformanceResult::PASSED && !report.serialOutput.empty())
+    {
+        std::cout << report.serialOutput << std::endl;
+    }
+
+    return report.result == GBcc::ConformanceResult::PASSED ? 0 : 1;
+}
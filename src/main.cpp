@@ -16,10 +16,246 @@
 * along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "Emulator/Emulator.hpp"
+#include "Emulator/BenchmarkRunner.hpp"
+#include "Utility.hpp"
 
-int main(void)
+#include <chrono>
+#include <iomanip>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <iostream>
+#include <cstdlib>
+
+namespace {
+    struct Options
+    {
+        std::string romPath = GBcc::GB_DEFAULT_ROM_PATH;
+        bool pipelinedRendering = false;
+        bool skipUnchangedFrames = false;
+        std::optional<double> speed;
+        double rewindSeconds = 0.0;
+        GBcc::u32 runAheadFrames = 0U;
+        bool uncapped = false;
+        std::optional<GBcc::SyncMode> syncMode;
+        std::string recordPath;
+        std::string replayPath;
+        std::string execLogPath;
+        bool bench = false;
+        GBcc::u64 benchFrames = 3600U;
+    };
+
+    // Replays a movie as fast as possible without a window and prints a hash
+    // of the last frame, two runs of the same movie must print the same hash
+    int Replay(const Options& options)
+    {
+        GBcc::Movie movie;
+        if (!movie.Load(options.replayPath))
+        {
+            std::cerr << "Could not read movie " << options.replayPath << std::endl;
+            exit(-1);
+        }
+
+        GBcc::System system;
+        if (!system.LoadRom(options.romPath))
+        {
+            std::cerr << "Could not open ROM " << options.romPath << std::endl;
+            exit(-1);
+        }
+        system.SetPipelinedRendering(options.pipelinedRendering);
+        system.SetExecLog(options.execLogPath);
+
+        if (!system.StartReplay(movie))
+        {
+            std::cerr << "Movie " << options.replayPath << " was not recorded on " << options.romPath << std::endl;
+            exit(-1);
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        while (!system.ReplayFinished())
+        {
+            system.RunFrame();
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        const auto& framebuffer = system.GetFramebuffer();
+        std::cout << movie.GetFrameCount() << " frames in " << seconds << " s (" 
+            << movie.GetFrameCount() / seconds << " fps), frame hash " 
+            << std::hex << GBcc::HashBytes(framebuffer.data(), framebuffer.size()) << std::endl;
+        return 0;
+    }
+
+    // Runs the whole system headless as fast as it goes, optionally driven
+    // by a movie, and reports throughput and the spread of frame times
+    int Bench(const Options& options)
+    {
+        GBcc::System system;
+        if (!system.LoadRom(options.romPath))
+        {
+            std::cerr << "Could not open ROM " << options.romPath << std::endl;
+            exit(-1);
+        }
+        system.SetPipelinedRendering(options.pipelinedRendering);
+        system.GetAPU().SetOutputEnabled(true);
+
+        GBcc::Movie movie;
+        if (!options.replayPath.empty())
+        {
+            if (!movie.Load(options.replayPath))
+            {
+                std::cerr << "Could not read movie " << options.replayPath << std::endl;
+                exit(-1);
+            }
+            if (!system.StartReplay(movie))
+            {
+                std::cerr << "Movie " << options.replayPath << " was not recorded on " << options.romPath << std::endl;
+                exit(-1);
+            }
+        }
+
+        const GBcc::BenchmarkReport report = GBcc::BenchmarkRunner::Run(system, options.benchFrames);
+        const double realTime = report.GetFramesPerSecond() / GBcc::VideoConstants::GAMEBOY_REFRESH_RATE;
+
+        std::cout << options.romPath << ": " << report.frames << " frames, " 
+            << report.cycles << " cycles, " << report.instructions << " instructions in " 
+            << std::fixed << std::setprecision(3) << report.seconds << " s" << std::endl;
+        std::cout << "  " << std::setprecision(1) << report.GetFramesPerSecond() << " frames/s (" 
+            << std::setprecision(2) << realTime << "x real time), " 
+            << report.GetInstructionsPerSecond() / 1e6 << " MIPS" << std::endl;
+        std::cout << "  ns/frame mean " << std::setprecision(0) << report.GetMeanFrameNs() 
+            << ", min " << report.GetFrameNsPercentile(0.0) 
+            << ", p50 " << report.GetFrameNsPercentile(50.0) 
+            << ", p90 " << report.GetFrameNsPercentile(90.0) 
+            << ", p99 " << report.GetFrameNsPercentile(99.0) 
+            << ", p99.9 " << report.GetFrameNsPercentile(99.9) 
+            << ", max " << report.GetFrameNsPercentile(100.0) << std::endl;
+        return 0;
+    }
+}
+
+int main(int argc, char** argv)
 {
+    Options options;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string_view argument = argv[i];
+
+        if (argument == "--pipelined-ppu")
+        {
+            options.pipelinedRendering = true;
+        }
+        else if (argument == "--skip-unchanged-frames")
+        {
+            options.skipUnchangedFrames = true;
+        }
+        else if (argument == "--speed" && i + 1 < argc)
+        {
+            options.speed = std::strtod(argv[++i], nullptr);
+        }
+        else if (argument == "--rewind" && i + 1 < argc)
+        {
+            options.rewindSeconds = std::strtod(argv[++i], nullptr);
+        }
+        else if (argument == "--run-ahead" && i + 1 < argc)
+        {
+            options.runAheadFrames = static_cast<GBcc::u32>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (argument == "--uncapped")
+        {
+            options.uncapped = true;
+        }
+        else if (argument == "--rom" && i + 1 < argc)
+        {
+            options.romPath = argv[++i];
+        }
+        else if (argument == "--record" && i + 1 < argc)
+        {
+            options.recordPath = argv[++i];
+        }
+        else if (argument == "--replay" && i + 1 < argc)
+        {
+            options.replayPath = argv[++i];
+        }
+        else if (argument == "--bench" && i + 1 < argc)
+        {
+            options.bench = true;
+            options.romPath = argv[++i];
+        }
+        else if (argument == "--frames" && i + 1 < argc)
+        {
+            options.benchFrames = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (argument == "--execlog" && i + 1 < argc)
+        {
+            options.execLogPath = argv[++i];
+        }
+        else if (argument == "--sync" && i + 1 < argc)
+        {
+            const std::string_view mode = argv[++i];
+
+            if (mode == "vsync")
+            {
+                options.syncMode = GBcc::SyncMode::VSYNC;
+            }
+            else if (mode == "timer")
+            {
+                options.syncMode = GBcc::SyncMode::TIMER;
+            }
+            else if (mode == "audio")
+            {
+                // Emulator::SetSyncMode() supports it for a host that plays
+                // its audio stream, this front end has no audio output yet
+                std::cerr << "Audio sync needs an audio output, which this build does not have. Use vsync or timer." << std::endl;
+                exit(-1);
+            }
+            else
+            {
+                std::cerr << "Unknown sync mode " << mode << ", expected vsync or timer." << std::endl;
+                exit(-1);
+            }
+        }
+    }
+
+    if (options.bench)
+    {
+        return Bench(options);
+    }
+
+    if (!options.replayPath.empty())
+    {
+        return Replay(options);
+    }
+
     GBcc::Emulator GBcc;
+    if (!GBcc.LoadRom(options.romPath))
+    {
+        std::cerr << "Could not open ROM " << options.romPath << std::endl;
+        exit(-1);
+    }
+
+    GBcc.SetPipelinedRendering(options.pipelinedRendering);
+    GBcc.SetSkipUnchangedFrames(options.skipUnchangedFrames);
+    if (options.speed)
+    {
+        GBcc.SetSpeedMultiplier(*options.speed);
+    }
+    if (options.uncapped)
+    {
+        GBcc.SetUncapped(true);
+    }
+    if (options.syncMode)
+    {
+        GBcc.SetSyncMode(*options.syncMode);
+    }
+    GBcc.SetRunAheadFrames(options.runAheadFrames);
+    if (!options.recordPath.empty())
+    {
+        GBcc.StartRecording(options.recordPath);
+    }
+    GBcc.SetRewindSeconds(options.rewindSeconds);
+    GBcc.SetExecLog(options.execLogPath);
+
     GBcc.Run();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,500 @@
+/*
+* GBcc: Game Boy (DMG) Emulator
+* Copyright (C) 2025 Daniel Frias
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "Emulator/BenchmarkRunner.hpp"
+#include "Core/Cartridge.hpp"
+#include "Core/Movie.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+    using GBcc::u8;
+    using GBcc::u64;
+
+    constexpr size_t PERF_PROGRAM_START = 0x0150U;
+    // Vectors are 8 bytes apart, handlers live past them and are jumped to
+    constexpr size_t PERF_HANDLER_START = 0x0068U;
+    constexpr size_t PERF_HANDLER_STRIDE = 0x0020U;
+
+    struct Options
+    {
+        std::string baselinePath;
+        std::string romDir;
+        std::string caseName;
+        u64 frames = 1200U;
+        u64 repeat = 5U;
+        double tolerance = 10.0;
+        bool update = false;
+    };
+
+    // Built-in workloads, so the gate has a corpus even without test ROMs
+    struct Workload
+    {
+        std::string name;
+        std::vector<u8> program;
+        // Interrupt vector and handler
+        std::map<size_t, std::vector<u8>> handlers;
+        bool movie;
+    };
+
+    // Appends a relative jump back to target, an offset into the program
+    void JumpBack(std::vector<u8>& program, const u8 opcode, const size_t target)
+    {
+        program.push_back(opcode);
+        program.push_back(static_cast<u8>(target - (program.size() + 1U)));
+    }
+
+    // Tile data, maps and OAM from a pattern, then the LCD on with every
+    // layer and interrupts enabled
+    std::vector<u8> SetupVideo(const u8 interrupts, const u8 stat)
+    {
+        // Reserved up front so the appends below never reallocate
+        std::vector<u8> program;
+        program.reserve(64U);
+        program.insert(program.end(), {
+            0xAFU, 0xE0U, 0x40U,                // LCDC = 0
+            0x21U, 0x00U, 0x80U                 // ld hl, 0x8000
+        });
+
+        const size_t fill = program.size();
+        program.insert(program.end(), {
+            0x7DU, 0xACU, 0x22U,                // ld a, l; xor h; ld (hl+), a
+            0x7CU, 0xFEU, 0xA0U                 // ld a, h; cp 0xA0
+        });
+        JumpBack(program, 0x20U, fill);
+
+        program.insert(program.end(), { 0x21U, 0x00U, 0xFEU });
+        const size_t oam = program.size();
+        program.insert(program.end(), {
+            0x7DU, 0x07U, 0x85U, 0x22U,         // ld a, l; rlca; add a, l; ld (hl+), a
+            0x7DU, 0xFEU, 0xA0U                 // ld a, l; cp 0xA0
+        });
+        JumpBack(program, 0x20U, oam);
+
+        program.insert(program.end(), {
+            0x3EU, 0x40U, 0xE0U, 0x4AU,         // WY
+            0x3EU, 0x57U, 0xE0U, 0x4BU,         // WX
+            0x3EU, 0xE4U, 0xE0U, 0x47U,         // BGP
+            0xE0U, 0x48U,                       // OBP0
+            0x3EU, stat, 0xE0U, 0x41U,          // STAT
+            0x3EU, 0xF3U, 0xE0U, 0x40U,         // LCDC, all layers
+            0x3EU, interrupts, 0xE0U, 0xFFU,    // IE
+            0xAFU, 0xE0U, 0x0FU                 // IF = 0
+        });
+        return program;
+    }
+
+    // Scrolls one pixel per frame so every frame is new
+    const std::vector<u8> SCROLL_HANDLER = {
+        0xF5U, 0xF0U, 0x43U, 0x3CU, 0xE0U, 0x43U, 0xE0U, 0x42U, 0xF1U, 0xD9U
+    };
+
+    // Waits for interrupts forever
+    void AppendIdle(std::vector<u8>& program)
+    {
+        program.push_back(0xFBU);
+        const size_t idle = program.size();
+        program.push_back(0x76U);
+        JumpBack(program, 0x18U, idle);
+    }
+
+    std::vector<Workload> GetWorkloads()
+    {
+        std::vector<Workload> workloads;
+
+        // Mixed ALU and WRAM stores, the interpreter flat out
+        {
+            std::vector<u8> program = { 0x21U, 0x00U, 0xC0U };
+            const size_t loop = program.size();
+            program.insert(program.end(), {
+                0x04U, 0x80U, 0xA9U, 0x22U,     // inc b; add a, b; xor c; ld (hl+), a
+                0x4FU, 0xCBU, 0x11U,            // ld c, a; rl c
+                0x7CU, 0xFEU, 0xD0U             // ld a, h; cp 0xD0
+            });
+            JumpBack(program, 0x20U, loop);
+            program.insert(program.end(), { 0x21U, 0x00U, 0xC0U });
+            JumpBack(program, 0x18U, loop);
+            workloads.push_back({ "cpu", program, {}, false });
+        }
+
+        // Halted between VBlanks, the renderer does most of the work
+        {
+            std::vector<u8> program = SetupVideo(0x01U, 0x00U);
+            AppendIdle(program);
+            workloads.push_back({ "render", program, { { 0x40U, SCROLL_HANDLER } }, false });
+        }
+
+        // A STAT interrupt per line writing SCX, the raster log path. The
+        // frame counter is kept in HRAM.
+        {
+            std::vector<u8> program = SetupVideo(0x03U, 0x08U);
+            AppendIdle(program);
+            const std::vector<u8> vblank = {
+                0xF5U, 0xF0U, 0x80U, 0x3CU, 0xE0U, 0x80U, 0xE0U, 0x42U, 0xF1U, 0xD9U
+            };
+            const std::vector<u8> hblank = {
+                0xF5U, 0xC5U, 0xF0U, 0x80U, 0x47U,  // push af; push bc; ld b, (counter)
+                0xF0U, 0x44U, 0x80U, 0xE0U, 0x43U,  // SCX = LY + counter
+                0xC1U, 0xF1U, 0xD9U
+            };
+            workloads.push_back({ "raster", program, { { 0x40U, vblank }, { 0x48U, hblank } }, false });
+        }
+
+        // All four channels playing while the CPU idles
+        {
+            std::vector<u8> program = {
+                0x3EU, 0x80U, 0xE0U, 0x26U,     // NR52
+                0x3EU, 0x77U, 0xE0U, 0x24U,     // NR50
+                0x3EU, 0xFFU, 0xE0U, 0x25U,     // NR51
+                0x3EU, 0x80U, 0xE0U, 0x11U,     // NR11
+                0x3EU, 0xF0U, 0xE0U, 0x12U,     // NR12
+                0x3EU, 0x87U, 0xE0U, 0x14U,     // NR14
+                0x3EU, 0x40U, 0xE0U, 0x16U,     // NR21
+                0x3EU, 0xF0U, 0xE0U, 0x17U,     // NR22
+                0x3EU, 0x86U, 0xE0U, 0x19U,     // NR24
+                0x3EU, 0x80U, 0xE0U, 0x1AU,     // NR30
+                0x3EU, 0x20U, 0xE0U, 0x1CU,     // NR32
+                0x3EU, 0x85U, 0xE0U, 0x1EU,     // NR34
+                0x3EU, 0xF0U, 0xE0U, 0x21U,     // NR42
+                0x3EU, 0x55U, 0xE0U, 0x22U,     // NR43
+                0x3EU, 0x80U, 0xE0U, 0x23U,     // NR44
+                0x3EU, 0x01U, 0xE0U, 0xFFU,     // IE
+                0xAFU, 0xE0U, 0x0FU
+            };
+            AppendIdle(program);
+            workloads.push_back({ "audio", program, { { 0x40U, SCROLL_HANDLER } }, false });
+        }
+
+        // Polls the joypad flat out and scrolls by it, driven by a movie
+        {
+            std::vector<u8> program = SetupVideo(0x00U, 0x00U);
+            program.insert(program.end(), { 0x21U, 0x00U, 0xC0U });
+            const size_t loop = program.size();
+            program.insert(program.end(), {
+                0x3EU, 0x20U, 0xE0U, 0x00U,     // select the d-pad
+                0xF0U, 0x00U, 0xF0U, 0x00U,
+                0x2FU, 0xE6U, 0x0FU, 0x47U,     // cpl; and 0x0F; ld b, a
+                0x3EU, 0x10U, 0xE0U, 0x00U,     // select the buttons
+                0xF0U, 0x00U, 0x2FU, 0xE6U, 0x0FU,
+                0xCBU, 0x37U, 0xB0U,            // swap a; or b
+                0xE0U, 0x42U, 0x22U,            // SCY; ld (hl+), a
+                0x7CU, 0xFEU, 0xD0U             // ld a, h; cp 0xD0
+            });
+            JumpBack(program, 0x20U, loop);
+            program.insert(program.end(), { 0x21U, 0x00U, 0xC0U });
+            JumpBack(program, 0x18U, loop);
+            workloads.push_back({ "movie", program, {}, true });
+        }
+
+        return workloads;
+    }
+
+    std::shared_ptr<const GBcc::Cartridge> BuildCartridge(const Workload& workload)
+    {
+        std::vector<u8> rom(GBcc::GB_ROM_SIZE, 0x00U);
+        const std::vector<u8> entry = { 0x00U, 0xC3U, PERF_PROGRAM_START & 0xFFU, PERF_PROGRAM_START >> 8U };
+
+        std::copy(entry.begin(), entry.end(), rom.begin() + 0x0100U);
+        std::copy(workload.program.begin(), workload.program.end(), rom.begin() + PERF_PROGRAM_START);
+        size_t handlerAddress = PERF_HANDLER_START;
+        for (const auto& [vector, handler] : workload.handlers)
+        {
+            rom[vector] = 0xC3U;
+            rom[vector + 1U] = handlerAddress & 0xFFU;
+            rom[vector + 2U] = handlerAddress >> 8U;
+            std::copy(handler.begin(), handler.end(), rom.begin() + handlerAddress);
+            handlerAddress += PERF_HANDLER_STRIDE;
+        }
+
+        return GBcc::Cartridge::FromBytes(rom.data(), rom.size());
+    }
+
+    // The same input sequence on every run
+    GBcc::Movie BuildMovie(const u64 romHash, const u64 frames)
+    {
+        GBcc::Movie movie;
+        movie.Begin(romHash, nullptr, 0U);
+
+        u64 seed = 0x2545F4914F6CDD1DULL;
+        for (u64 i = 0; i < frames; i++)
+        {
+            seed ^= seed << 13U;
+            seed ^= seed >> 7U;
+            seed ^= seed << 17U;
+            // Hold each input for a few frames like a player would
+            movie.RecordFrame(static_cast<u8>(seed >> ((i / 8U) % 56U)));
+        }
+        return movie;
+    }
+
+    struct PerfCase
+    {
+        std::shared_ptr<const GBcc::Cartridge> pCartridge;
+        std::unique_ptr<GBcc::Movie> pMovie;
+    };
+
+    // Anything that is not a built-in workload is a ROM under the ROM
+    // directory, replaying a movie with the same name and .gbcm if there is one
+    bool LoadCase(const Options& options, const std::string& name, PerfCase& perfCase)
+    {
+        for (const auto& workload : GetWorkloads())
+        {
+            if (workload.name != name)
+            {
+                continue;
+            }
+
+            perfCase.pCartridge = BuildCartridge(workload);
+            if (workload.movie)
+            {
+                perfCase.pMovie = std::make_unique<GBcc::Movie>(BuildMovie(perfCase.pCartridge->GetHash(), options.frames));
+            }
+            return true;
+        }
+
+        const std::filesystem::path romPath = std::filesystem::path(options.romDir) / name;
+        perfCase.pCartridge = GBcc::Cartridge::FromFile(romPath.string());
+        if (!perfCase.pCartridge)
+        {
+            std::cerr << "Could not read ROM " << romPath.string() << std::endl;
+            return false;
+        }
+
+        std::filesystem::path moviePath = romPath;
+        moviePath.replace_extension(".gbcm");
+        if (std::filesystem::exists(moviePath))
+        {
+            perfCase.pMovie = std::make_unique<GBcc::Movie>();
+            if (!perfCase.pMovie->Load(moviePath.string()))
+            {
+                std::cerr << "Could not read movie " << moviePath.string() << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Best of several runs from power-on, a slow run is noise from the host
+    // far more often than from the emulator
+    bool Measure(const Options& options, const std::string& name, double& framesPerSecond)
+    {
+        PerfCase perfCase;
+        if (!LoadCase(options, name, perfCase))
+        {
+            return false;
+        }
+
+        framesPerSecond = 0.0;
+        for (u64 i = 0; i < options.repeat; i++)
+        {
+            // Sound is synthesized as in the front end, the baseline
+            // includes it
+            auto pSystem = std::make_unique<GBcc::System>();
+            pSystem->LoadCartridge(perfCase.pCartridge);
+            pSystem->GetAPU().SetOutputEnabled(true);
+
+            if (perfCase.pMovie && !pSystem->StartReplay(*perfCase.pMovie))
+            {
+                std::cerr << "Movie for " << name << " was not recorded on its ROM" << std::endl;
+                return false;
+            }
+
+            const GBcc::BenchmarkReport report = GBcc::BenchmarkRunner::Run(*pSystem, options.frames);
+            framesPerSecond = std::max(framesPerSecond, report.GetFramesPerSecond());
+        }
+        return true;
+    }
+
+    // Case name and frames/s per line, # starts a comment
+    std::vector<std::pair<std::string, double>> ReadBaseline(const std::string& path)
+    {
+        std::vector<std::pair<std::string, double>> baseline;
+        std::ifstream file(path);
+        std::string line;
+
+        while (std::getline(file, line))
+        {
+            std::istringstream fields(line);
+            std::string name;
+            double framesPerSecond = 0.0;
+
+            if (!(fields >> name) || name[0] == '#')
+            {
+                continue;
+            }
+            if (!(fields >> framesPerSecond))
+            {
+                std::cerr << "Malformed baseline line: " << line << std::endl;
+                exit(-1);
+            }
+            baseline.emplace_back(name, framesPerSecond);
+        }
+        return baseline;
+    }
+
+    int Update(const Options& options)
+    {
+        // Keeps the ROM cases already in the baseline, and adds any new
+        // built-in workload
+        std::vector<std::string> names;
+        for (const auto& [name, framesPerSecond] : ReadBaseline(options.baselinePath))
+        {
+            names.push_back(name);
+        }
+        for (const auto& workload : GetWorkloads())
+        {
+            if (std::find(names.begin(), names.end(), workload.name) == names.end())
+            {
+                names.push_back(workload.name);
+            }
+        }
+
+        std::ostringstream contents;
+        contents << "# Frames/s per perf case, compared by GBccPerf and ctest -L perf.\n";
+        contents << "# Regenerate on the machine that runs the gate with\n";
+        contents << "#   GBccPerf --baseline <this file> --update\n";
+
+        for (const auto& name : names)
+        {
+            double framesPerSecond = 0.0;
+            if (!Measure(options, name, framesPerSecond))
+            {
+                return 1;
+            }
+
+            std::cout << name << ": " << std::fixed << std::setprecision(1) << framesPerSecond << " frames/s" << std::endl;
+            contents << std::left << std::setw(32) << name << " " 
+                << std::fixed << std::setprecision(1) << framesPerSecond << "\n";
+        }
+
+        std::ofstream file(options.baselinePath);
+        if (!file)
+        {
+            std::cerr << "Could not write " << options.baselinePath << std::endl;
+            exit(-1);
+        }
+        file << contents.str();
+        return 0;
+    }
+
+    int Check(const Options& options)
+    {
+        const auto baseline = ReadBaseline(options.baselinePath);
+        if (baseline.empty())
+        {
+            std::cerr << "No cases in baseline " << options.baselinePath << std::endl;
+            return 1;
+        }
+
+        bool checked = false;
+        int failed = 0;
+
+        for (const auto& [name, expected] : baseline)
+        {
+            if (!options.caseName.empty() && name != options.caseName)
+            {
+                continue;
+            }
+            checked = true;
+
+            double framesPerSecond = 0.0;
+            if (!Measure(options, name, framesPerSecond))
+            {
+                failed++;
+                continue;
+            }
+
+            const double change = (framesPerSecond / expected - 1.0) * 100.0;
+            const bool slower = change < -options.tolerance;
+            failed += slower;
+
+            std::cout << name << ": " << std::fixed << std::setprecision(1) << framesPerSecond 
+                << " frames/s, baseline " << expected << " (" << std::showpos << change << std::noshowpos 
+                << "%, limit -" << options.tolerance << "%) " << (slower ? "SLOWER" : "ok") << std::endl;
+        }
+
+        if (!checked)
+        {
+            std::cerr << "No baseline for " << options.caseName << std::endl;
+            return 1;
+        }
+        return failed ? 1 : 0;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string_view argument = argv[i];
+
+        if (argument == "--baseline" && i + 1 < argc)
+        {
+            options.baselinePath = argv[++i];
+        }
+        else if (argument == "--rom-dir" && i + 1 < argc)
+        {
+            options.romDir = argv[++i];
+        }
+        else if (argument == "--case" && i + 1 < argc)
+        {
+            options.caseName = argv[++i];
+        }
+        else if (argument == "--frames" && i + 1 < argc)
+        {
+            options.frames = std::max(1ULL, std::strtoull(argv[++i], nullptr, 10));
+        }
+        else if (argument == "--repeat" && i + 1 < argc)
+        {
+            options.repeat = std::max(1ULL, std::strtoull(argv[++i], nullptr, 10));
+        }
+        else if (argument == "--tolerance" && i + 1 < argc)
+        {
+            options.tolerance = std::strtod(argv[++i], nullptr);
+        }
+        else if (argument == "--update")
+        {
+            options.update = true;
+        }
+        else
+        {
+            options.baselinePath.clear();
+            break;
+        }
+    }
+
+    if (options.baselinePath.empty())
+    {
+        std::cerr << "Usage: GBccPerf --baseline FILE [--case NAME] [--rom-dir DIR] [--frames N] [--repeat N] [--tolerance PERCENT] [--update]" << std::endl;
+        exit(-1);
+    }
+
+    return options.update ? Update(options) : Check(options);
+}
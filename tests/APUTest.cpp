@@ -0,0 +1,69 @@
+#include "Audio/APU.hpp"
+#include "Core/Scheduler.hpp"
+#include "Types.hpp"
+
+#include "TestFunctions.hpp"
+
+#include <vector>
+
+using GBcc::i16;
+using GBcc::u64;
+
+int main(int argc, char** argv)
+{
+    u64 clock = 0;
+    GBcc::Scheduler scheduler(clock);
+    GBcc::APU apu(scheduler, 48000U);
+    apu.SetOutputEnabled(true);
+
+    std::vector<i16> samples(2U * 8192U);
+
+    // Nothing playing yet
+    clock += 70224U;
+    const size_t silent = apu.ReadSamples(samples.data(), 8192U);
+    ExpectTrue(silent >= 803U && silent <= 804U);
+    for (size_t i = 0; i < silent * 2U; i++)
+    {
+        ExpectTrue(samples[i] == 0);
+    }
+
+    // Channel 2 at about 1 kHz, 50% duty, full volume on both sides
+    apu.WriteRegister(GBcc::GB_REG_NR21, 0x80U);
+    apu.WriteRegister(GBcc::GB_REG_NR22, 0xF0U);
+    apu.WriteRegister(GBcc::GB_REG_NR23, 1917U & 0xFFU);
+    apu.WriteRegister(GBcc::GB_REG_NR24, GBcc::GB_NRX4_TRIGGER | (1917U >> 8U));
+    Expect(GBcc::u8(0xF2U), apu.ReadRegister(GBcc::GB_REG_NR52));
+
+    // A tenth of a second read in two parts
+    clock += GBcc::GB_CPU_CLOCK_HZ / 20U;
+    size_t count = apu.ReadSamples(samples.data(), 8192U);
+    clock += GBcc::GB_CPU_CLOCK_HZ / 20U;
+    count += apu.ReadSamples(samples.data() + count * 2U, 8192U - count);
+    ExpectTrue(count >= 4799U && count <= 4801U);
+
+    // Left and right carry the same signal, crossing zero twice per period
+    size_t crossings = 0;
+    for (size_t i = 1; i < count; i++)
+    {
+        ExpectTrue(samples[i * 2U] == samples[i * 2U + 1U]);
+        crossings += (samples[(i - 1U) * 2U] < 0) != (samples[i * 2U] < 0);
+    }
+    ExpectTrue(crossings >= 190U && crossings <= 210U);
+
+    // Length counter on, 64 - 63 = 1 step of the 256 Hz clock
+    apu.WriteRegister(GBcc::GB_REG_NR21, 0x80U | 63U);
+    apu.WriteRegister(GBcc::GB_REG_NR24, GBcc::GB_NRX4_TRIGGER | GBcc::GB_NRX4_LENGTH_ENABLE | (1917U >> 8U));
+    clock += 2U * GBcc::GB_FRAME_SEQUENCER_PERIOD;
+    Expect(GBcc::u8(0xF0U), apu.ReadRegister(GBcc::GB_REG_NR52));
+
+    // Without output the channels still run but no samples are kept
+    apu.SetOutputEnabled(false);
+    apu.WriteRegister(GBcc::GB_REG_NR24, GBcc::GB_NRX4_TRIGGER | (1917U >> 8U));
+    clock += GBcc::GB_CPU_CLOCK_HZ / 20U;
+    apu.EndFrame();
+    Expect(size_t(0), apu.SamplesAvailable());
+    Expect(size_t(0), apu.ReadSamples(samples.data(), 8192U));
+    Expect(GBcc::u8(0xF2U), apu.ReadRegister(GBcc::GB_REG_NR52));
+
+    return 0;
+}
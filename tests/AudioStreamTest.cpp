@@ -0,0 +1,207 @@
+#include "Audio/AudioStream.hpp"
+#include "Audio/AudioRing.hpp"
+#include "Audio/APU.hpp"
+#include "Core/Scheduler.hpp"
+#include "Types.hpp"
+
+#include "TestFunctions.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using GBcc::i16;
+using GBcc::u64;
+
+// Frames are numbered so the consumer can check nothing was lost or reordered
+static void RingOrderTest()
+{
+    constexpr size_t totalFrames = 1U << 17U;
+    static GBcc::AudioRing<1024U> ring;
+
+    std::thread consumer([]()
+    {
+        std::array<i16, 2U * 300U> frames;
+        size_t expected = 0;
+
+        while (expected < totalFrames)
+        {
+            const size_t read = ring.Read(frames.data(), 300U);
+            if (read == 0U)
+            {
+                std::this_thread::yield();
+            }
+
+            for (size_t i = 0; i < read; i++, expected++)
+            {
+                ExpectTrue(frames[i * 2U] == static_cast<i16>(expected));
+                ExpectTrue(frames[i * 2U + 1U] == static_cast<i16>(~expected));
+            }
+        }
+    });
+
+    std::array<i16, 2U * 700U> frames;
+    size_t next = 0;
+
+    while (next < totalFrames)
+    {
+        const size_t count = std::min<size_t>(1U + next % 700U, totalFrames - next);
+        for (size_t i = 0; i < count; i++)
+        {
+            frames[i * 2U] = static_cast<i16>(next + i);
+            frames[i * 2U + 1U] = static_cast<i16>(~(next + i));
+        }
+
+        size_t written = 0;
+        while (written < count)
+        {
+            const size_t chunk = ring.Write(frames.data() + written * 2U, count - written);
+            if (chunk == 0U)
+            {
+                std::this_thread::yield();
+            }
+            written += chunk;
+        }
+        next += count;
+    }
+
+    consumer.join();
+}
+
+// The host plays 0.1% faster than the emulator produces at a fixed ratio.
+// The consumer thread is fed in lockstep with emulated frames so the run is
+// deterministic and takes no wall time.
+static void RateControlTest()
+{
+    u64 clock = 0;
+    GBcc::Scheduler scheduler(clock);
+    GBcc::APU apu(scheduler, 48000U);
+    apu.SetOutputEnabled(true);
+    static GBcc::AudioStream stream;
+
+    constexpr u64 hostFramesPerFrameMilli = static_cast<u64>(48000.0 * 1.001 * 70224.0 / 4194304.0 * 1000.0);
+    constexpr size_t block = 256U;
+
+    std::atomic<u64> owedMilli = 0;
+    std::atomic<bool> done = false;
+
+    // Prime to the target fill before the host starts pulling
+    while (stream.GetFill() < GBcc::AudioStream::RING_FRAMES / 2U)
+    {
+        clock += 70224U;
+        stream.Produce(apu);
+    }
+
+    std::thread consumer([&]()
+    {
+        std::array<i16, 2U * block> out;
+
+        while (!done.load(std::memory_order_acquire))
+        {
+            if (owedMilli.load(std::memory_order_acquire) >= block * 1000U)
+            {
+                stream.Consume(out.data(), block);
+                owedMilli.fetch_sub(block * 1000U, std::memory_order_release);
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    // A minute of emulated time
+    for (size_t frame = 0; frame < 3600U; frame++)
+    {
+        clock += 70224U;
+        stream.Produce(apu);
+
+        owedMilli.fetch_add(hostFramesPerFrameMilli, std::memory_order_release);
+        while (owedMilli.load(std::memory_order_acquire) >= block * 1000U)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    done.store(true, std::memory_order_release);
+    consumer.join();
+
+    Expect(u64(0), stream.GetUnderruns());
+    Expect(u64(0), stream.GetDroppedFrames());
+    ExpectTrue(stream.GetRatio() > 1.0 && stream.GetRatio() <= 1.005);
+    ExpectTrue(stream.GetFill() > GBcc::AudioStream::RING_FRAMES / 4U);
+    ExpectTrue(stream.GetFill() < GBcc::AudioStream::RING_FRAMES * 3U / 4U);
+}
+
+// The slowest speed with the controller at its highest ratio still fits a
+// whole chunk, so no input is dropped
+static void SlowestRatioTest()
+{
+    using GBcc::AudioStream;
+
+    constexpr size_t chunks = 64U;
+    constexpr double inputPerOutput = AudioStream::MIN_SPEED / (1.0 + AudioStream::MAX_RATE_DEVIATION);
+
+    GBcc::Resampler resampler(AudioStream::CHUNK_FRAMES);
+    resampler.SetRatio(inputPerOutput);
+
+    std::vector<i16> in(AudioStream::CHUNK_FRAMES * 2U, 1000);
+    std::vector<i16> out(AudioStream::RESAMPLED_FRAMES * 2U);
+    size_t produced = 0;
+
+    for (size_t i = 0; i < chunks; i++)
+    {
+        const size_t frames = resampler.Process(in.data(), AudioStream::CHUNK_FRAMES, out.data(), AudioStream::RESAMPLED_FRAMES);
+        ExpectTrue(frames < AudioStream::RESAMPLED_FRAMES);
+        produced += frames;
+    }
+
+    const double expected = chunks * AudioStream::CHUNK_FRAMES / inputPerOutput;
+    ExpectTrue(produced > expected - 8.0 && produced < expected + 8.0);
+}
+
+// Audio sync waits for the host to play the ring down to the target fill,
+// and gives up when nothing plays it
+static void WaitForSpaceTest()
+{
+    u64 clock = 0;
+    GBcc::Scheduler scheduler(clock);
+    GBcc::APU apu(scheduler, 48000U);
+    apu.SetOutputEnabled(true);
+    static GBcc::AudioStream stream;
+
+    constexpr size_t target = static_cast<size_t>(GBcc::AudioStream::RING_FRAMES * GBcc::AudioStream::TARGET_FILL);
+    ExpectTrue(stream.WaitForSpace(std::chrono::milliseconds(0)));
+
+    while (stream.GetFill() <= target + 1024U)
+    {
+        clock += 70224U;
+        stream.Produce(apu);
+    }
+    ExpectFalse(stream.WaitForSpace(std::chrono::milliseconds(5)));
+
+    std::thread host([]()
+    {
+        std::array<i16, 2U * 256U> out;
+        for (size_t i = 0; i < 8U; i++)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            stream.Consume(out.data(), 256U);
+        }
+    });
+
+    ExpectTrue(stream.WaitForSpace(std::chrono::seconds(10)));
+    ExpectTrue(stream.GetFill() <= target);
+    host.join();
+}
+
+int main(int argc, char** argv)
+{
+    RingOrderTest();
+    RateControlTest();
+    SlowestRatioTest();
+    WaitForSpaceTest();
+    return 0;
+}
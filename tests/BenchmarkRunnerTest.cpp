@@ -0,0 +1,53 @@
+#include "Emulator/BenchmarkRunner.hpp"
+#include "Core/System.hpp"
+#include "Types.hpp"
+
+#include "TestFunctions.hpp"
+
+#include <algorithm>
+#include <vector>
+
+using GBcc::u8;
+using GBcc::u64;
+using GBcc::BenchmarkReport;
+using GBcc::BenchmarkRunner;
+
+int main(int argc, char** argv)
+{
+    // NOP; JR -3, two instructions per 16 cycles
+    std::vector<u8> rom(32U * 1024U, 0x00U);
+    const std::vector<u8> program = {0x00U, 0xC3U, 0x50U, 0x01U};
+    std::copy(program.begin(), program.end(), rom.begin() + 0x100U);
+    rom[0x150U] = 0x00U;
+    rom[0x151U] = 0x18U;
+    rom[0x152U] = 0xFDU;
+
+    GBcc::System system;
+    ExpectTrue(system.LoadRom(rom.data(), rom.size()));
+    system.RunFrame();
+
+    const BenchmarkReport report = BenchmarkRunner::Run(system, 30U);
+    Expect(static_cast<u64>(30U), report.frames);
+    Expect(static_cast<u64>(30U), static_cast<u64>(report.frameNs.size()));
+    ExpectTrue(std::is_sorted(report.frameNs.begin(), report.frameNs.end()));
+    ExpectTrue(report.cycles >= 29ULL * 70'224ULL && report.cycles <= 31ULL * 70'224ULL);
+    ExpectTrue(report.instructions >= report.cycles / 8ULL - 1ULL && report.instructions <= report.cycles / 8ULL + 1ULL);
+    ExpectTrue(report.seconds > 0.0);
+    ExpectTrue(report.GetFramesPerSecond() > 0.0);
+
+    BenchmarkReport fixed;
+    fixed.frames = 4U;
+    fixed.seconds = 2.0;
+    fixed.instructions = 100U;
+    fixed.frameNs = {10U, 20U, 30U, 40U};
+    Expect(2.0, fixed.GetFramesPerSecond());
+    Expect(50.0, fixed.GetInstructionsPerSecond());
+    Expect(5e8, fixed.GetMeanFrameNs());
+    Expect(static_cast<u64>(10U), fixed.GetFrameNsPercentile(0.0));
+    Expect(static_cast<u64>(20U), fixed.GetFrameNsPercentile(50.0));
+    Expect(static_cast<u64>(40U), fixed.GetFrameNsPercentile(90.0));
+    Expect(static_cast<u64>(40U), fixed.GetFrameNsPercentile(100.0));
+
+    Expect(static_cast<u64>(0U), BenchmarkReport().GetFrameNsPercentile(50.0));
+    return 0;
+}
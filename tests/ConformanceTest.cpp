@@ -0,0 +1,75 @@
+#include "Emulator/ConformanceRunner.hpp"
+#include "Core/System.hpp"
+#include "Types.hpp"
+
+#include "TestFunctions.hpp"
+
+#include <string>
+#include <vector>
+
+using GBcc::u8;
+using GBcc::u64;
+using GBcc::ConformanceResult;
+using GBcc::ConformanceRunner;
+
+static constexpr u64 SHORT_BUDGET = 10ULL * 70'224ULL;
+
+// Runs the program at 0x150, then spins on JR -2
+static GBcc::ConformanceReport Run(std::vector<u8> program, const u64 budget = SHORT_BUDGET)
+{
+    std::vector<u8> rom(32U * 1024U, 0x00U);
+    const std::vector<u8> entry = {0x00U, 0xC3U, 0x50U, 0x01U};
+    program.insert(program.end(), {0x18U, 0xFEU});
+
+    std::copy(entry.begin(), entry.end(), rom.begin() + 0x100U);
+    std::copy(program.begin(), program.end(), rom.begin() + 0x150U);
+
+    GBcc::System system;
+    ExpectTrue(system.LoadRom(rom.data(), rom.size()));
+    return ConformanceRunner::Run(system, budget);
+}
+
+static std::vector<u8> Print(const std::string& text)
+{
+    std::vector<u8> program;
+    for (const char c : text)
+    {
+        program.insert(program.end(), {0x3EU, static_cast<u8>(c), 0xE0U, 0x01U, 0x3EU, 0x81U, 0xE0U, 0x02U});
+    }
+    return program;
+}
+
+static std::vector<u8> LoadRegisters(const std::vector<u8>& values)
+{
+    // LD B..L, n with H and L last, then LD B,B
+    const std::vector<u8> opcodes = {0x06U, 0x0EU, 0x16U, 0x1EU, 0x26U, 0x2EU};
+    std::vector<u8> program;
+    for (size_t i = 0; i < opcodes.size(); i++)
+    {
+        program.insert(program.end(), {opcodes[i], values[i]});
+    }
+    program.push_back(0x40U);
+    return program;
+}
+
+int main(int argc, char** argv)
+{
+    GBcc::ConformanceReport report = Run(Print("01-special\n\nPassed\n"));
+    Expect(ConformanceResult::PASSED, report.result);
+    Expect(std::string("01-special\n\nPassed\n"), report.serialOutput);
+    ExpectTrue(report.cycles < SHORT_BUDGET);
+
+    Expect(ConformanceResult::FAILED, Run(Print("\nFailed #3\n")).result);
+
+    Expect(ConformanceResult::PASSED, Run(LoadRegisters({3U, 5U, 8U, 13U, 21U, 34U})).result);
+    Expect(ConformanceResult::FAILED, Run(LoadRegisters({0x42U, 0x42U, 0x42U, 0x42U, 0x42U, 0x42U})).result);
+    Expect(ConformanceResult::PASSED, Run(Print("\x03\x05\x08\x0D\x15\x22")).result);
+
+    // Nothing reported, the whole budget is used
+    report = Run(Print("running"));
+    Expect(ConformanceResult::TIMEOUT, report.result);
+    ExpectTrue(report.cycles >= SHORT_BUDGET);
+
+    Expect(ConformanceResult::ERROR, ConformanceRunner::Run("does-not-exist.gb").result);
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include "gbcc.h"
+
+#include "TestFunctions.hpp"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Sends "OK" over serial, then counts in B forever
+static std::vector<uint8_t> MakeRom()
+{
+    std::vector<uint8_t> rom(32U * 1024U, 0x00U);
+    const uint8_t entry[] = {0x00U, 0xC3U, 0x50U, 0x01U};
+    const uint8_t program[] = {
+        0x3EU, 'O', 0xE0U, 0x01U, 0x3EU, 0x81U, 0xE0U, 0x02U,
+        0x3EU, 'K', 0xE0U, 0x01U, 0x3EU, 0x81U, 0xE0U, 0x02U,
+        0x04U, 0x18U, 0xFDU
+    };
+
+    std::memcpy(rom.data() + 0x100U, entry, sizeof(entry));
+    std::memcpy(rom.data() + 0x150U, program, sizeof(program));
+    return rom;
+}
+
+static std::vector<uint8_t> SaveState(const gbcc_instance* instance)
+{
+    std::vector<uint8_t> state(gbcc_get_state_size(instance));
+    Expect(state.size(), gbcc_save_state(instance, state.data(), state.size()));
+    return state;
+}
+
+int main(int argc, char** argv)
+{
+    const std::vector<uint8_t> rom = MakeRom();
+    gbcc_instance* a = gbcc_create();
+    gbcc_instance* b = gbcc_create();
+
+    ExpectTrue(a && b);
+    Expect(-1, gbcc_load_rom(a, rom.data(), 0U));
+    Expect(-1, gbcc_load_rom(a, rom.data(), 64U * 1024U));
+    Expect(0, gbcc_load_rom(a, rom.data(), rom.size()));
+    Expect(0, gbcc_load_rom(b, rom.data(), rom.size()));
+
+    // Serial output belongs to the instance that sent it
+    gbcc_run_frames(a, 2U);
+    size_t size = 0U;
+    const char* serial = gbcc_get_serial_output(a, &size);
+    Expect(std::string("OK"), std::string(serial, size));
+    gbcc_get_serial_output(b, &size);
+    Expect(size_t(0U), size);
+    gbcc_clear_serial_output(a);
+    gbcc_get_serial_output(a, &size);
+    Expect(size_t(0U), size);
+
+    // Cycle budgets stop at the next instruction boundary
+    const uint64_t cycles = gbcc_get_cycles(a);
+    const uint64_t ran = gbcc_run_cycles(a, 1000U);
+    ExpectTrue(ran >= 1000U && ran < 1024U);
+    Expect(cycles + ran, gbcc_get_cycles(a));
+
+    // A state moved to another instance continues identically
+    gbcc_set_input(a, GBCC_BUTTON_START | GBCC_BUTTON_A);
+    const std::vector<uint8_t> state = SaveState(a);
+    Expect(0, gbcc_load_state(b, state.data(), state.size()));
+    gbcc_run_frames(a, 10U);
+    gbcc_run_frames(b, 10U);
+    Expect(SaveState(a), SaveState(b));
+    Expect(0, std::memcmp(gbcc_get_framebuffer(a), gbcc_get_framebuffer(b), GBCC_SCREEN_WIDTH * GBCC_SCREEN_HEIGHT));
+
+    // Bad buffers are refused
+    std::vector<uint8_t> small(16U);
+    Expect(size_t(0U), gbcc_save_state(a, small.data(), small.size()));
+    Expect(-1, gbcc_load_state(a, small.data(), small.size()));
+
+    // A shared ROM runs like a copied one and outlives the instance it came
+    // from
+    gbcc_instance* c = gbcc_create();
+    gbcc_instance* d = gbcc_create();
+    gbcc_share_rom(c, a);
+    gbcc_destroy(a);
+    Expect(0, gbcc_load_rom(d, rom.data(), rom.size()));
+    gbcc_run_frames(c, 2U);
+    gbcc_run_frames(d, 2U);
+    Expect(SaveState(c), SaveState(d));
+    gbcc_get_serial_output(c, &size);
+    Expect(size_t(2U), size);
+
+    gbcc_destroy(b);
+    gbcc_destroy(c);
+    gbcc_destroy(d);
+    return 0;
+}
@@ -0,0 +1,48 @@
+#include "Core/InterruptController.hpp"
+#include "Types.hpp"
+
+#include "TestFunctions.hpp"
+
+using GBcc::u8;
+using GBcc::u16;
+
+int main(int argc, char** argv)
+{
+    GBcc::InterruptController interrupts;
+    interrupts.WriteFlags(0x00U);
+
+    // A line is only pending once it is also enabled
+    interrupts.Request(GBcc::GB_INTERRUPT_TIMER);
+    ExpectFalse(interrupts.NeedsService());
+    interrupts.WriteEnable(GBcc::GB_INTERRUPT_TIMER | GBcc::GB_INTERRUPT_VBLANK);
+    ExpectTrue(interrupts.NeedsService());
+    Expect(u8(GBcc::GB_INTERRUPT_TIMER), interrupts.GetPending());
+
+    // EI enables IME after one more instruction
+    interrupts.EnableMaster(true);
+    ExpectFalse(interrupts.MasterEnabled());
+    interrupts.StepEnableDelay();
+    ExpectFalse(interrupts.MasterEnabled());
+    interrupts.StepEnableDelay();
+    ExpectTrue(interrupts.MasterEnabled());
+
+    // VBlank wins over the timer, acknowledging clears IME and the IF bit
+    interrupts.Request(GBcc::GB_INTERRUPT_VBLANK);
+    Expect(u16(0x0040U), interrupts.Acknowledge());
+    ExpectFalse(interrupts.MasterEnabled());
+    Expect(u8(GBcc::GB_INTERRUPT_TIMER), interrupts.GetPending());
+
+    interrupts.EnableMaster(false);
+    Expect(u16(0x0050U), interrupts.Acknowledge());
+    ExpectFalse(interrupts.NeedsService());
+    Expect(u8(0xE0U), interrupts.ReadFlags());
+
+    // DI cancels an EI that has not taken effect yet
+    interrupts.EnableMaster(true);
+    interrupts.DisableMaster();
+    interrupts.StepEnableDelay();
+    interrupts.StepEnableDelay();
+    ExpectFalse(interrupts.MasterEnabled());
+
+    return 0;
+}
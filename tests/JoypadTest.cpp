@@ -0,0 +1,43 @@
+#include "Core/Joypad.hpp"
+#include "Core/InterruptController.hpp"
+#include "Types.hpp"
+
+#include "TestFunctions.hpp"
+
+using GBcc::u8;
+
+int main(int argc, char** argv)
+{
+    GBcc::InterruptController interrupts;
+    interrupts.WriteFlags(0x00U);
+    GBcc::Joypad joypad(interrupts);
+
+    // Nothing pressed reads all lines high
+    joypad.WriteRegister(GBcc::GB_P1_SELECT_BUTTONS);
+    Expect(u8(0xEFU), joypad.ReadRegister());
+
+    // Only the selected group shows up
+    joypad.SetButtons(GBcc::JOYPAD_LEFT | GBcc::JOYPAD_START);
+    Expect(u8(0xEDU), joypad.ReadRegister());
+    joypad.WriteRegister(GBcc::GB_P1_SELECT_DPAD);
+    Expect(u8(0xD7U), joypad.ReadRegister());
+    joypad.WriteRegister(GBcc::GB_P1_SELECT_MASK);
+    Expect(u8(0xFFU), joypad.ReadRegister());
+
+    // A line going low requests the interrupt, releasing does not
+    joypad.WriteRegister(GBcc::GB_P1_SELECT_BUTTONS);
+    interrupts.WriteFlags(0x00U);
+    joypad.SetButtons(0x00U);
+    Expect(u8(0x00U), u8(interrupts.ReadFlags() & GBcc::GB_INTERRUPT_JOYPAD));
+    joypad.SetButtons(GBcc::JOYPAD_DOWN);
+    Expect(u8(GBcc::GB_INTERRUPT_JOYPAD), u8(interrupts.ReadFlags() & GBcc::GB_INTERRUPT_JOYPAD));
+
+    // Selecting a group with a pressed button pulls its line down too
+    interrupts.WriteFlags(0x00U);
+    joypad.WriteRegister(GBcc::GB_P1_SELECT_MASK);
+    joypad.WriteRegister(GBcc::GB_P1_SELECT_BUTTONS);
+    Expect(u8(GBcc::GB_INTERRUPT_JOYPAD), u8(interrupts.ReadFlags() & GBcc::GB_INTERRUPT_JOYPAD));
+    Expect(u8(GBcc::JOYPAD_DOWN), joypad.GetButtons());
+
+    return 0;
+}
@@ -0,0 +1,328 @@
+#include "Core/Lockstep.hpp"
+#include "Core/System.hpp"
+#include "Types.hpp"
+
+#include "TestFunctions.hpp"
+
+#include <memory>
+#include <vector>
+
+using GBcc::u8;
+using GBcc::u16;
+using GBcc::u32;
+
+static constexpr size_t LANES = 37U;
+static constexpr size_t FRAMES = 40U;
+static constexpr size_t SAME_INPUT_FRAMES = 8U;
+static constexpr size_t OPCODE_LANES = 8U;
+
+class RomBuilder
+{
+    private:
+    std::vector<u8> m_Rom = std::vector<u8>(32U * 1024U, 0x00U);
+    u16 m_At = 0x0000U;
+    u32 m_Seed = 0x2545F491U;
+
+    public:
+    void Seek(const u16 address) { m_At = address; }
+    u16 Here() const { return m_At; }
+    void Emit(const std::vector<u8>& bytes)
+    {
+        for (const u8 byte : bytes)
+        {
+            m_Rom[m_At++] = byte;
+        }
+    }
+    u32 Next(const u32 range)
+    {
+        m_Seed = m_Seed * 1664525U + 1013904223U;
+        return (m_Seed >> 8U) % range;
+    }
+    const std::vector<u8>& GetRom() const { return m_Rom; }
+};
+
+// Any register but H, which keeps (HL) inside WRAM
+static u8 Destination(RomBuilder& rom)
+{
+    const u8 reg = rom.Next(6U);
+    return reg >= 4U ? reg + 1U + (reg == 5U) : reg;
+}
+
+static u8 Source(RomBuilder& rom)
+{
+    const u8 reg = rom.Next(7U);
+    return reg == 6U ? 7U : reg;
+}
+
+static void EmitRandomInstruction(RomBuilder& rom)
+{
+    const u8 alu = rom.Next(8U);
+
+    switch (rom.Next(20U))
+    {
+        // Register only
+        case 0: rom.Emit({static_cast<u8>(0x40U | (Destination(rom) << 3U) | Source(rom))}); break;
+        case 1: rom.Emit({static_cast<u8>(0x80U | (alu << 3U) | Source(rom))}); break;
+        case 2: rom.Emit({static_cast<u8>(0xC6U | (alu << 3U)), static_cast<u8>(rom.Next(256U))}); break;
+        case 3: rom.Emit({static_cast<u8>(0x04U | (Destination(rom) << 3U) | rom.Next(2U))}); break;
+        case 4: rom.Emit({static_cast<u8>(0x06U | (Destination(rom) << 3U)), static_cast<u8>(rom.Next(256U))}); break;
+        case 5: rom.Emit({static_cast<u8>(0x07U | (rom.Next(8U) << 3U))}); break;
+        case 6: rom.Emit({static_cast<u8>(0x03U | (rom.Next(2U) << 4U) | (rom.Next(2U) << 3U))}); break;
+        case 7: rom.Emit({static_cast<u8>(0x01U | (rom.Next(2U) << 4U)), static_cast<u8>(rom.Next(256U)), static_cast<u8>(rom.Next(256U))}); break;
+        case 8: rom.Emit({static_cast<u8>(0x09U | (rom.Next(4U) << 4U)), 0x26U, 0xC0U}); break;
+        // Branches over a two byte load, taken or not
+        case 9: rom.Emit({static_cast<u8>(0x20U | (rom.Next(4U) << 3U)), 0x02U, 0x06U, 0x11U}); break;
+        case 10:
+        {
+            const u16 target = rom.Here() + 5U;
+            rom.Emit({static_cast<u8>(0xC2U | (rom.Next(4U) << 3U)), static_cast<u8>(target), static_cast<u8>(target >> 8U), 0x0EU, 0x22U});
+        }
+            break;
+        // Memory in WRAM, HRAM and ROM
+        case 11: rom.Emit({static_cast<u8>(0x70U | Source(rom))}); break;
+        case 12: rom.Emit({static_cast<u8>(0x46U | (Destination(rom) << 3U))}); break;
+        case 13: rom.Emit({static_cast<u8>(0x86U | (alu << 3U))}); break;
+        case 14: rom.Emit({static_cast<u8>(0x34U | rom.Next(2U)), static_cast<u8>(0x22U | (rom.Next(4U) << 3U)), 0x26U, 0xC0U}); break;
+        case 15: rom.Emit({static_cast<u8>(0xE0U | (rom.Next(2U) << 4U)), static_cast<u8>(0x80U + rom.Next(0x7FU))}); break;
+        case 16: rom.Emit({static_cast<u8>(0xC5U | (rom.Next(4U) << 4U)), static_cast<u8>(0xC1U | (rom.Next(2U) << 4U))}); break;
+        case 17: rom.Emit({0xEAU, static_cast<u8>(rom.Next(256U)), static_cast<u8>(0xC0U + rom.Next(0x20U)), 0xFAU, static_cast<u8>(rom.Next(256U)), static_cast<u8>(rom.Next(0x80U))}); break;
+        case 18: rom.Emit({static_cast<u8>(rom.Next(2U) ? 0xCDU : 0xC4U | (rom.Next(4U) << 3U)), 0x00U, 0x10U}); break;
+        default: rom.Emit({static_cast<u8>(0xC7U | ((1U + rom.Next(2U)) << 3U))}); break;
+    }
+}
+
+// Random code in a loop that reads the joypad and takes a timer interrupt,
+// so lanes split apart once their input does
+static std::vector<u8> MakeRom()
+{
+    RomBuilder rom;
+
+    // RST 08 and 10, then the timer handler counting into WRAM
+    rom.Seek(0x0008U);
+    rom.Emit({0x04U, 0xC9U});
+    rom.Seek(0x0010U);
+    rom.Emit({0x1DU, 0xC9U});
+    rom.Seek(0x0050U);
+    rom.Emit({0xF5U, 0xFAU, 0x00U, 0xDEU, 0x3CU, 0xEAU, 0x00U, 0xDEU, 0xF1U, 0xD9U});
+
+    rom.Seek(0x0100U);
+    rom.Emit({0x00U, 0xC3U, 0x50U, 0x01U});
+    rom.Seek(0x0150U);
+    rom.Emit({
+        0x31U, 0xF0U, 0xDFU,
+        0x3EU, 0x05U, 0xE0U, 0x07U,
+        0x3EU, 0x04U, 0xE0U, 0xFFU,
+        0xFBU
+    });
+
+    const u16 loop = rom.Here();
+    rom.Emit({0x26U, 0xC0U, 0x3EU, 0x20U, 0xE0U, 0x00U, 0xF0U, 0x00U, 0x81U, 0x4FU, 0xE6U, 0x01U, 0x28U, 0x02U, 0x16U, 0x99U});
+    while (rom.Here() < 0x0F00U)
+    {
+        EmitRandomInstruction(rom);
+
+        // Log F to WRAM, the only place H and N end up
+        if (rom.Next(3U) == 0U)
+        {
+            rom.Emit({0xF5U, 0xD1U, 0x73U, 0x23U});
+        }
+    }
+    rom.Emit({0xC3U, static_cast<u8>(loop), static_cast<u8>(loop >> 8U)});
+
+    // The subroutine returns early on some flags
+    rom.Seek(0x1000U);
+    rom.Emit({0x3CU, 0xC8U, 0x87U, 0xD8U, 0x2FU, 0x37U, 0x3FU, 0xC9U});
+
+    return rom.GetRom();
+}
+
+static u8 Buttons(const size_t frame, const size_t lane)
+{
+    return frame < SAME_INPUT_FRAMES ? 0x00U : static_cast<u8>((frame * 7U + lane * 13U) >> 2U);
+}
+
+static std::vector<u8> SaveState(const GBcc::System& system)
+{
+    std::vector<u8> state(system.GetStateSize());
+    Expect(state.size(), system.SaveState(state.data(), state.size()));
+    return state;
+}
+
+// Operand bytes of a register-only instruction
+static size_t OperandSize(const u8 opcode)
+{
+    const u8 x = opcode >> 6U;
+    const u8 z = opcode & 7U;
+
+    if (x == 0U)
+    {
+        if (z == 1U)
+        {
+            return (opcode & 0x08U) ? 0U : 2U;
+        }
+        return (z == 6U || (z == 0U && opcode != 0x00U)) ? 1U : 0U;
+    }
+    if (x == 3U)
+    {
+        return z == 6U ? 1U : (z == 2U || z == 3U) ? 2U : 0U;
+    }
+    return 0U;
+}
+
+// One opcode over and over with random operands. Branches land on the next
+// instruction whether taken or not, so only their timing tells. JP HL gets
+// its target loaded first.
+static std::vector<u8> MakeOpcodeRom(const u8 opcode)
+{
+    RomBuilder rom;
+
+    rom.Seek(0x0100U);
+    rom.Emit({0x00U, 0xC3U, 0x50U, 0x01U});
+    rom.Seek(0x0150U);
+
+    const size_t operands = OperandSize(opcode);
+    while (rom.Here() < 0x7F00U)
+    {
+        const u16 next = rom.Here() + 1U + operands;
+        if ((opcode & 0xC7U) == 0x00U && opcode != 0x00U)
+        {
+            rom.Emit({opcode, 0x00U});
+        }
+        else if ((opcode & 0xC6U) == 0xC2U)
+        {
+            rom.Emit({opcode, static_cast<u8>(next), static_cast<u8>(next >> 8U)});
+        }
+        else if (opcode == 0xE9U)
+        {
+            rom.Emit({0x21U, static_cast<u8>(next + 3U), static_cast<u8>((next + 3U) >> 8U), opcode});
+        }
+        else
+        {
+            rom.Emit({opcode});
+            for (size_t i = 0; i < operands; i++)
+            {
+                rom.Emit({static_cast<u8>(rom.Next(256U))});
+            }
+        }
+    }
+    rom.Emit({0xC3U, 0x50U, 0x01U});
+
+    return rom.GetRom();
+}
+
+static GBcc::SharpRegisterFile RandomRegisters(RomBuilder& random, const GBcc::SharpRegisterFile& start)
+{
+    GBcc::SharpRegisterFile registers = start;
+    registers.a = random.Next(256U);
+    registers.f = random.Next(16U) << 4U;
+    registers.b = random.Next(256U);
+    registers.c = random.Next(256U);
+    registers.d = random.Next(256U);
+    registers.e = random.Next(256U);
+    registers.h = random.Next(256U);
+    registers.l = random.Next(256U);
+    registers.sp = random.Next(0x10000U);
+    return registers;
+}
+
+// Every register-only opcode gives what Sharp gives, from random registers
+static void TestRegisterOpcodes()
+{
+    RomBuilder random;
+    size_t tested = 0U;
+
+    for (size_t opcode = 0; opcode < 256U; opcode++)
+    {
+        if (!GBcc::Lockstep::IsRegisterOpcode(static_cast<u8>(opcode)))
+        {
+            continue;
+        }
+        tested++;
+
+        const std::vector<u8> rom = MakeOpcodeRom(static_cast<u8>(opcode));
+        GBcc::Lockstep lockstep(OPCODE_LANES);
+        ExpectTrue(lockstep.LoadRom(rom.data(), rom.size()));
+
+        std::vector<std::unique_ptr<GBcc::System>> references;
+        for (size_t lane = 0; lane < OPCODE_LANES; lane++)
+        {
+            GBcc::System& system = lockstep.GetLane(lane);
+            const GBcc::SharpRegisterFile registers = RandomRegisters(random, system.GetRegisterFile());
+            system.SetRegisterFile(registers);
+
+            references.push_back(std::make_unique<GBcc::System>());
+            ExpectTrue(references.back()->LoadRom(rom.data(), rom.size()));
+            references.back()->SetRegisterFile(registers);
+        }
+
+        lockstep.RunFrame();
+        ExpectTrue(lockstep.GetStats().fallback == 0U);
+
+        for (size_t lane = 0; lane < OPCODE_LANES; lane++)
+        {
+            references[lane]->RunFrame();
+            ExpectTrue(SaveState(*references[lane]) == SaveState(lockstep.GetLane(lane)));
+        }
+    }
+
+    ExpectTrue(tested > 0U);
+}
+
+static void RunLockstep(GBcc::Lockstep& lockstep, const std::vector<u8>& rom)
+{
+    ExpectTrue(lockstep.LoadRom(rom.data(), rom.size()));
+
+    for (size_t frame = 0; frame < FRAMES; frame++)
+    {
+        for (size_t lane = 0; lane < LANES; lane++)
+        {
+            lockstep.GetLane(lane).SetJoypad(Buttons(frame, lane));
+        }
+        lockstep.RunFrame();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::vector<u8> rom = MakeRom();
+
+    GBcc::Lockstep lockstep(LANES);
+    Expect(LANES, lockstep.GetLaneCount());
+    RunLockstep(lockstep, rom);
+
+    // Every lane ends exactly where a machine of its own does
+    for (size_t lane = 0; lane < LANES; lane++)
+    {
+        GBcc::System reference;
+        ExpectTrue(reference.LoadRom(rom.data(), rom.size()));
+
+        for (size_t frame = 0; frame < FRAMES; frame++)
+        {
+            reference.SetJoypad(Buttons(frame, lane));
+            reference.RunFrame();
+        }
+
+        ExpectTrue(SaveState(reference) == SaveState(lockstep.GetLane(lane)));
+    }
+
+    // All three ways of running an instruction were taken
+    const GBcc::LockstepStats& stats = lockstep.GetStats();
+    ExpectTrue(stats.uniform > 0U);
+    ExpectTrue(stats.grouped > 0U);
+    ExpectTrue(stats.fallback > 0U);
+
+    // The baseline loops agree with the widest ones
+    GBcc::Lockstep baseline(LANES);
+    baseline.SetPath(GBcc::LockstepPath::BASELINE);
+    Expect(GBcc::LockstepPath::BASELINE, baseline.GetPath());
+    RunLockstep(baseline, rom);
+
+    for (size_t lane = 0; lane < LANES; lane++)
+    {
+        ExpectTrue(SaveState(baseline.GetLane(lane)) == SaveState(lockstep.GetLane(lane)));
+    }
+
+    TestRegisterOpcodes();
+
+    return 0;
+}
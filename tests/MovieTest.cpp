@@ -0,0 +1,90 @@
+#include "Core/Movie.hpp"
+#include "Types.hpp"
+
+#include "TestFunctions.hpp"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using GBcc::u8;
+using GBcc::u64;
+
+static const std::string MOVIE_PATH = "MovieTest.gbcm";
+
+// Long holds, single frame taps and runs over the u16 limit survive the file
+static void RoundTripTest()
+{
+    const std::vector<u8> state = {0x01U, 0x02U, 0x03U, 0x04U, 0x05U};
+    GBcc::Movie movie;
+    movie.Begin(0x0123456789ABCDEFULL, state.data(), state.size());
+
+    std::vector<u8> inputs;
+    for (size_t frame = 0; frame < 70000U; frame++)
+    {
+        inputs.push_back(frame < 66000U ? 0x00U : static_cast<u8>(frame / 3U));
+    }
+    inputs.push_back(0x80U);
+
+    for (const u8 buttons : inputs)
+    {
+        movie.RecordFrame(buttons);
+    }
+    ExpectTrue(movie.Save(MOVIE_PATH));
+
+    GBcc::Movie loaded;
+    ExpectTrue(loaded.Load(MOVIE_PATH));
+    std::remove(MOVIE_PATH.c_str());
+
+    Expect(u64(0x0123456789ABCDEFULL), loaded.GetRomHash());
+    ExpectFalse(loaded.StartsAtPowerOn());
+    Expect(state, loaded.GetStartState());
+    Expect(inputs.size(), loaded.GetFrameCount());
+
+    for (size_t frame = 0; frame < inputs.size(); frame++)
+    {
+        Expect(inputs[frame], loaded.GetInput(frame));
+    }
+}
+
+// Anything that is not a movie is rejected
+static void InvalidFileTest()
+{
+    GBcc::Movie movie;
+    ExpectFalse(movie.Load("MovieTest.missing"));
+
+    std::FILE* file = std::fopen(MOVIE_PATH.c_str(), "wb");
+    std::fputs("not a movie", file);
+    std::fclose(file);
+
+    ExpectFalse(movie.Load(MOVIE_PATH));
+
+    // Sizes larger than the file are rejected before they are allocated
+    const auto writeHeader = [](const GBcc::u32 stateSize, const GBcc::u32 frames)
+    {
+        std::FILE* file = std::fopen(MOVIE_PATH.c_str(), "wb");
+        const GBcc::u64 romHash = 0ULL;
+        std::fwrite(&GBcc::GB_MOVIE_MAGIC, sizeof(GBcc::GB_MOVIE_MAGIC), 1U, file);
+        std::fwrite(&GBcc::GB_MOVIE_VERSION, sizeof(GBcc::GB_MOVIE_VERSION), 1U, file);
+        std::fwrite(&romHash, sizeof(romHash), 1U, file);
+        std::fwrite(&stateSize, sizeof(stateSize), 1U, file);
+        std::fwrite(&frames, sizeof(frames), 1U, file);
+        std::fclose(file);
+    };
+
+    writeHeader(UINT32_MAX, 0U);
+    ExpectFalse(movie.Load(MOVIE_PATH));
+    writeHeader(0U, UINT32_MAX);
+    ExpectFalse(movie.Load(MOVIE_PATH));
+    writeHeader(0U, 0U);
+    ExpectTrue(movie.Load(MOVIE_PATH));
+
+    std::remove(MOVIE_PATH.c_str());
+}
+
+int main(int argc, char** argv)
+{
+    RoundTripTest();
+    InvalidFileTest();
+    return 0;
+}
@@ -0,0 +1,125 @@
+#include "Core/Observation.hpp"
+#include "Core/System.hpp"
+#include "Types.hpp"
+
+#include "TestFunctions.hpp"
+
+#include <cstring>
+#include <vector>
+
+using GBcc::u8;
+using GBcc::ObservationEncoder;
+using GBcc::ObservationFormat;
+using GBcc::ObservationPath;
+
+static std::vector<u8> Encode(const ObservationPath path, const ObservationFormat format, const GBcc::PPU::Framebuffer& frame)
+{
+    ObservationEncoder encoder;
+    encoder.SetPath(path);
+    std::vector<u8> out(ObservationEncoder::GetSize(format));
+    ExpectTrue(encoder.Encode(format, frame, out));
+    return out;
+}
+
+// Every path gives the same bytes, and the scalar one the expected values
+static void EncoderTest()
+{
+    GBcc::PPU::Framebuffer frame;
+    for (size_t i = 0; i < frame.size(); i++)
+    {
+        frame[i] = static_cast<u8>((i * 7U + i / 160U) & 3U);
+    }
+
+    for (const ObservationFormat format : {ObservationFormat::GRAYSCALE, ObservationFormat::GRAYSCALE_HALF})
+    {
+        const std::vector<u8> scalar = Encode(ObservationPath::SCALAR, format, frame);
+        Expect(scalar, Encode(ObservationPath::SSE2, format, frame));
+        Expect(scalar, Encode(ObservationPath::AVX2, format, frame));
+    }
+
+    const std::vector<u8> gray = Encode(ObservationPath::SCALAR, ObservationFormat::GRAYSCALE, frame);
+    Expect(size_t(160U * 144U), gray.size());
+    Expect(u8(0xFFU), gray[0]);
+    Expect(u8(0xFFU - 85U * frame[161]), gray[161]);
+
+    // Rows then columns, each rounded up
+    const std::vector<u8> half = Encode(ObservationPath::SCALAR, ObservationFormat::GRAYSCALE_HALF, frame);
+    Expect(size_t(80U * 72U), half.size());
+    auto gray2 = [&gray](const size_t x, const size_t y) { return static_cast<unsigned>(gray[y * 160U + x]); };
+    const unsigned left = (gray2(2U, 2U) + gray2(2U, 3U) + 1U) >> 1U;
+    const unsigned right = (gray2(3U, 2U) + gray2(3U, 3U) + 1U) >> 1U;
+    Expect(u8((left + right + 1U) >> 1U), half[80U + 1U]);
+
+    ObservationEncoder encoder;
+    std::vector<u8> small(100U);
+    ExpectFalse(encoder.Encode(ObservationFormat::GRAYSCALE, frame, small));
+    ExpectFalse(encoder.Encode(ObservationFormat::NONE, frame, small));
+}
+
+// Counts in WRAM at C000 every frame the A button is held
+static std::vector<u8> MakeRom()
+{
+    std::vector<u8> rom(32U * 1024U, 0x00U);
+    const u8 entry[] = {0x00U, 0xC3U, 0x50U, 0x01U};
+    const u8 program[] = {
+        0x3EU, 0x10U, 0xE0U, 0x00U,
+        0xF0U, 0x44U, 0xFEU, 0x90U, 0x20U, 0xFAU,
+        0xF0U, 0x00U, 0xE6U, 0x01U, 0x20U, 0x04U,
+        0x21U, 0x00U, 0xC0U, 0x34U,
+        0xF0U, 0x44U, 0xFEU, 0x90U, 0x28U, 0xFAU,
+        0x18U, 0xE4U
+    };
+
+    std::memcpy(rom.data() + 0x100U, entry, sizeof(entry));
+    std::memcpy(rom.data() + 0x150U, program, sizeof(program));
+    return rom;
+}
+
+static float CounterReward(const GBcc::System& system, void* pUser)
+{
+    (*static_cast<int*>(pUser))++;
+    return static_cast<float>(system.GetMemoryView(0xC000U, 1U)[0]);
+}
+
+static void StepTest()
+{
+    const std::vector<u8> rom = MakeRom();
+    GBcc::System system;
+    ExpectTrue(system.LoadRom(rom.data(), rom.size()));
+
+    std::vector<u8> observation(ObservationEncoder::GetSize(ObservationFormat::GRAYSCALE_HALF));
+    std::vector<u8> tooSmall(observation.size() - 1U);
+    ExpectFalse(system.SetObservation(ObservationFormat::GRAYSCALE_HALF, tooSmall));
+    ExpectTrue(system.SetObservation(ObservationFormat::GRAYSCALE_HALF, observation));
+
+    int calls = 0;
+    system.SetRewardFunction(CounterReward, &calls);
+
+    GBcc::EnvStep step = system.StepEnvironment(GBcc::JOYPAD_A, 4U);
+    Expect(1, calls);
+    ExpectTrue(step.reward >= 3.0f && step.reward <= 4.0f);
+
+    // Views, not copies
+    Expect(static_cast<const void*>(system.GetFramebuffer().data()), static_cast<const void*>(step.framebuffer.data()));
+    Expect(static_cast<const void*>(observation.data()), static_cast<const void*>(step.observation.data()));
+    Expect(observation.size(), step.observation.size());
+    Expect(size_t(0x2000U), step.workRam.size());
+    Expect(size_t(0x7FU), step.highRam.size());
+    Expect(step.workRam[0], static_cast<u8>(step.reward));
+
+    const float held = step.reward;
+    step = system.StepEnvironment(0x00U, 4U);
+    Expect(held, step.reward);
+
+    // Views never cross out of a region
+    Expect(size_t(0U), system.GetMemoryView(0xDFFFU, 2U).size());
+    Expect(size_t(0U), system.GetMemoryView(0x8000U, 1U).size());
+    Expect(size_t(0x7FU), system.GetMemoryView(0xFF80U, 0x7FU).size());
+}
+
+int main(int argc, char** argv)
+{
+    EncoderTest();
+    StepTest();
+    return 0;
+}
@@ -0,0 +1,107 @@
+#include "Core/System.hpp"
+#include "Types.hpp"
+
+#include "TestFunctions.hpp"
+
+#include <algorithm>
+#include <vector>
+
+using GBcc::u8;
+
+static constexpr size_t WIDTH = 160U;
+
+static void JumpBack(std::vector<u8>& code, const u8 opcode, const size_t target)
+{
+    code.push_back(opcode);
+    code.push_back(static_cast<u8>(target - (code.size() + 1U)));
+}
+
+// The first VBlank handler fills tile 0 with color 1, tile 1 with color 3,
+// DMAs one sprite using tile 1 to the top left corner and turns sprites on.
+// None of it may show before the next frame.
+static std::vector<u8> BuildRom()
+{
+    std::vector<u8> rom(32U * 1024U, 0x00U);
+    const std::vector<u8> entry = {0x00U, 0xC3U, 0x50U, 0x01U};
+    const std::vector<u8> main = {
+        0x3EU, 0xE4U, 0xE0U, 0x47U,
+        0x3EU, 0xE4U, 0xE0U, 0x48U,
+        0x3EU, 0x01U, 0xE0U, 0xFFU,
+        0xAFU, 0xE0U, 0x0FU,
+        0xFBU, 0x76U, 0x18U, 0xFDU
+    };
+
+    std::vector<u8> handler = {
+        0xF0U, 0x80U, 0xB7U, 0xC0U,         // ret nz once done
+        0x3CU, 0xE0U, 0x80U,
+        0x21U, 0x00U, 0x80U, 0x0EU, 0x08U
+    };
+    size_t loop = handler.size();
+    handler.insert(handler.end(), {0x3EU, 0xFFU, 0x22U, 0xAFU, 0x22U, 0x0DU});
+    JumpBack(handler, 0x20U, loop);
+
+    handler.insert(handler.end(), {0x0EU, 0x10U, 0x3EU, 0xFFU});
+    loop = handler.size();
+    handler.insert(handler.end(), {0x22U, 0x0DU});
+    JumpBack(handler, 0x20U, loop);
+
+    handler.insert(handler.end(), {
+        0x21U, 0x00U, 0xC0U,
+        0x36U, 0x10U, 0x23U, 0x36U, 0x08U, 0x23U, 0x36U, 0x01U,
+        0x3EU, 0xC0U, 0xE0U, 0x46U,
+        0x3EU, 0x93U, 0xE0U, 0x40U,
+        0xD9U
+    });
+
+    std::copy(entry.begin(), entry.end(), rom.begin() + 0x100U);
+    std::copy(main.begin(), main.end(), rom.begin() + 0x150U);
+    rom[0x40U] = 0xC3U;
+    rom[0x41U] = 0x00U;
+    rom[0x42U] = 0x02U;
+    std::copy(handler.begin(), handler.end(), rom.begin() + 0x200U);
+    return rom;
+}
+
+int main(int argc, char** argv)
+{
+    const std::vector<u8> rom = BuildRom();
+
+    for (const bool pipelined : {false, true})
+    {
+        GBcc::System system;
+        ExpectTrue(system.LoadRom(rom.data(), rom.size()));
+        system.SetPipelinedRendering(pipelined);
+
+        // The frame is finished when VBlank starts
+        system.RunFrame();
+        const auto& framebuffer = system.GetFramebuffer();
+        ExpectTrue(std::all_of(framebuffer.begin(), framebuffer.end(), [](const u8 shade) { return shade == 0U; }));
+
+        system.RunFrame();
+        if (pipelined)
+        {
+            // Waits for the worker's last frame
+            system.SetPipelinedRendering(false);
+        }
+        else
+        {
+            ExpectTrue(system.FrameChanged());
+        }
+
+        Expect(u8(3U), framebuffer[0]);
+        Expect(u8(3U), framebuffer[7U * WIDTH + 7U]);
+        Expect(u8(1U), framebuffer[8U]);
+        Expect(u8(1U), framebuffer[8U * WIDTH]);
+        Expect(u8(1U), framebuffer[143U * WIDTH + 159U]);
+    }
+
+    // Nothing changes after that
+    GBcc::System system;
+    ExpectTrue(system.LoadRom(rom.data(), rom.size()));
+    system.RunFrame();
+    system.RunFrame();
+    system.RunFrame();
+    ExpectFalse(system.FrameChanged());
+    Expect(u8(3U), system.GetFramebuffer()[0]);
+    return 0;
+}
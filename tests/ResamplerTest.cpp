@@ -0,0 +1,118 @@
+#include "Audio/Resampler.hpp"
+#include "Types.hpp"
+
+#include "TestFunctions.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+using GBcc::i16;
+using GBcc::Resampler;
+using GBcc::ResamplerPath;
+
+static std::vector<i16> MakeSine(const size_t frames, const double period, const double amplitude)
+{
+    std::vector<i16> samples(frames * 2U);
+
+    for (size_t i = 0; i < frames; i++)
+    {
+        const double phase = 2.0 * 3.14159265358979 * static_cast<double>(i) / period;
+        samples[i * 2U] = static_cast<i16>(std::lround(amplitude * std::sin(phase)));
+        samples[i * 2U + 1U] = static_cast<i16>(std::lround(amplitude * std::cos(phase)));
+    }
+
+    return samples;
+}
+
+// Feeds the input in uneven blocks, as AudioStream would
+static std::vector<i16> Run(Resampler& resampler, const std::vector<i16>& in, const double ratio)
+{
+    const size_t frames = in.size() / 2U;
+    std::vector<i16> out((static_cast<size_t>(frames / ratio) + 16U) * 2U);
+    size_t consumed = 0;
+    size_t produced = 0;
+
+    resampler.SetRatio(ratio);
+
+    while (consumed < frames)
+    {
+        const size_t block = std::min<size_t>(1U + (consumed * 7U) % 500U, frames - consumed);
+        produced += resampler.Process(in.data() + consumed * 2U, block, out.data() + produced * 2U, out.size() / 2U - produced);
+        consumed += block;
+    }
+
+    out.resize(produced * 2U);
+    return out;
+}
+
+// At a ratio of one every output frame lands on an input frame, two late
+static void IdentityTest()
+{
+    const std::vector<i16> in = MakeSine(4000U, 37.0, 20000.0);
+    Resampler resampler(1024U);
+    const std::vector<i16> out = Run(resampler, in, 1.0);
+
+    ExpectTrue(out.size() >= in.size() - 8U);
+    for (size_t i = 4U; i < out.size(); i++)
+    {
+        Expect(in[i - 4U], out[i]);
+    }
+}
+
+static void RatioTest()
+{
+    const std::vector<i16> in = MakeSine(44100U, 44100.0 / 1000.0, 16000.0);
+    Resampler resampler(1024U);
+    const std::vector<i16> out = Run(resampler, in, 44100.0 / 48000.0);
+    const size_t frames = out.size() / 2U;
+
+    ExpectTrue(frames >= 47995U && frames <= 48005U);
+
+    // A 1kHz tone keeps its level, and crosses zero twice per period
+    i16 peak = 0;
+    size_t crossings = 0;
+    for (size_t i = 1U; i < frames; i++)
+    {
+        peak = std::max(peak, out[i * 2U]);
+        crossings += (out[i * 2U - 2U] < 0) != (out[i * 2U] < 0);
+    }
+
+    ExpectTrue(std::abs(peak - 16000) < 160);
+    ExpectTrue(crossings >= 1998U && crossings <= 2001U);
+}
+
+// Every SIMD path must match the scalar one up to rounding of the sums
+static void PathTest()
+{
+    const std::vector<i16> in = MakeSine(20000U, 11.3, 32767.0);
+    const double ratios[] = { 0.25, 44100.0 / 48000.0, 1.0013, 48000.0 / 44100.0, 16.0 };
+
+    for (const double ratio : ratios)
+    {
+        Resampler scalar(1024U);
+        scalar.SetPath(ResamplerPath::SCALAR);
+        const std::vector<i16> expected = Run(scalar, in, ratio);
+
+        for (const ResamplerPath path : { ResamplerPath::SSE, ResamplerPath::AVX })
+        {
+            Resampler resampler(1024U);
+            resampler.SetPath(path);
+            const std::vector<i16> out = Run(resampler, in, ratio);
+
+            Expect(expected.size(), out.size());
+            for (size_t i = 0; i < out.size(); i++)
+            {
+                ExpectTrue(std::abs(expected[i] - out[i]) <= 1);
+            }
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    IdentityTest();
+    RatioTest();
+    PathTest();
+    return 0;
+}
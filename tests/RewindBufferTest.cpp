@@ -0,0 +1,154 @@
+#include "Emulator/RewindBuffer.hpp"
+#include "Types.hpp"
+
+#include "TestFunctions.hpp"
+
+#include <algorithm>
+#include <vector>
+
+using GBcc::u8;
+using GBcc::u32;
+
+constexpr size_t STATE_SIZE = 40000U;
+
+// A few scattered bytes change per frame, like WRAM and VRAM in a game
+static std::vector<u8> MakeState(const u32 frame)
+{
+    std::vector<u8> state(STATE_SIZE, 0x00U);
+    u32 seed = 12345U;
+
+    for (size_t i = 0; i < STATE_SIZE; i += 7U)
+    {
+        seed = seed * 1103515245U + 12345U;
+        state[i] = static_cast<u8>(seed >> 16U);
+    }
+
+    for (u32 i = 0; i < 64U; i++)
+    {
+        state[(frame * 131U + i * 613U) % STATE_SIZE] ^= static_cast<u8>(frame + i);
+    }
+
+    state[0] = static_cast<u8>(frame);
+    state[1] = static_cast<u8>(frame >> 8U);
+    return state;
+}
+
+// Popping returns every pushed state, newest first, across keyframes
+static void RoundTripTest()
+{
+    GBcc::RewindBuffer rewind(STATE_SIZE, 16U << 20U, 1000U, 10U);
+    std::vector<u8> state(STATE_SIZE);
+
+    for (u32 frame = 0; frame < 95U; frame++)
+    {
+        rewind.Push(MakeState(frame).data());
+    }
+
+    Expect(size_t(95), rewind.Size());
+
+    // Deltas are a fraction of a state
+    ExpectTrue(rewind.MemoryUsed() < 10U * STATE_SIZE + 95U * STATE_SIZE / 20U);
+
+    for (u32 frame = 95U; frame-- > 40U;)
+    {
+        ExpectTrue(rewind.Pop(state.data()));
+        Expect(MakeState(frame), state);
+    }
+
+    // Recording again after rewinding continues from the popped state
+    for (u32 frame = 200U; frame < 230U; frame++)
+    {
+        rewind.Push(MakeState(frame).data());
+    }
+    for (u32 frame = 230U; frame-- > 200U;)
+    {
+        ExpectTrue(rewind.Pop(state.data()));
+        Expect(MakeState(frame), state);
+    }
+    for (u32 frame = 40U; frame-- > 0U;)
+    {
+        ExpectTrue(rewind.Pop(state.data()));
+        Expect(MakeState(frame), state);
+    }
+
+    ExpectFalse(rewind.Pop(state.data()));
+    Expect(size_t(0), rewind.MemoryUsed());
+}
+
+// A full buffer drops whole keyframe groups from the old end and keeps the
+// newest history intact
+static void CapTest()
+{
+    GBcc::RewindBuffer rewind(STATE_SIZE, 512U << 10U, 1000U, 8U);
+    std::vector<u8> state(STATE_SIZE);
+
+    for (u32 frame = 0; frame < 2000U; frame++)
+    {
+        rewind.Push(MakeState(frame).data());
+        ExpectTrue(rewind.MemoryUsed() <= (512U << 10U));
+    }
+
+    const size_t kept = rewind.Size();
+    ExpectTrue(kept >= 16U && kept < 2000U);
+
+    for (u32 frame = 2000U; frame-- > 2000U - kept;)
+    {
+        ExpectTrue(rewind.Pop(state.data()));
+        Expect(MakeState(frame), state);
+    }
+
+    ExpectFalse(rewind.Pop(state.data()));
+}
+
+// More snapshots than descriptors behaves the same as running out of bytes
+static void SnapshotLimitTest()
+{
+    GBcc::RewindBuffer rewind(STATE_SIZE, 16U << 20U, 50U, 10U);
+    std::vector<u8> state(STATE_SIZE);
+
+    for (u32 frame = 0; frame < 500U; frame++)
+    {
+        rewind.Push(MakeState(frame).data());
+        ExpectTrue(rewind.Size() <= 50U);
+    }
+
+    const size_t kept = rewind.Size();
+    ExpectTrue(kept >= 40U);
+
+    for (u32 frame = 500U; frame-- > 500U - kept;)
+    {
+        ExpectTrue(rewind.Pop(state.data()));
+        Expect(MakeState(frame), state);
+    }
+}
+
+// Fewer descriptors than the keyframe interval must still drop old groups
+// instead of clearing the whole history
+static void ShortRingTest()
+{
+    GBcc::RewindBuffer rewind(STATE_SIZE, 16U << 20U, 8U, 60U);
+    std::vector<u8> state(STATE_SIZE);
+
+    for (u32 frame = 0; frame < 100U; frame++)
+    {
+        rewind.Push(MakeState(frame).data());
+        ExpectTrue(rewind.Size() >= std::min<size_t>(frame + 1U, 4U));
+        ExpectTrue(rewind.Size() <= 8U);
+    }
+
+    const size_t kept = rewind.Size();
+    for (u32 frame = 100U; frame-- > 100U - kept;)
+    {
+        ExpectTrue(rewind.Pop(state.data()));
+        Expect(MakeState(frame), state);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    RoundTripTest();
+    CapTest();
+    SnapshotLimitTest();
+    ShortRingTest();
+    return 0;
+}
@@ -0,0 +1,193 @@
+#include "Core/SaveState.hpp"
+#include "Core/System.hpp"
+#include "Core/Timer.hpp"
+#include "Core/Scheduler.hpp"
+#include "Core/InterruptController.hpp"
+#include "Audio/APU.hpp"
+#include "Audio/AudioConstants.hpp"
+#include "Types.hpp"
+
+#include "TestFunctions.hpp"
+
+#include <array>
+#include <vector>
+
+using GBcc::u8;
+using GBcc::u16;
+using GBcc::u64;
+
+struct Machine
+{
+    u64 clock = 0;
+    GBcc::Scheduler scheduler{ clock };
+    GBcc::InterruptController interrupts;
+    GBcc::Timer timer{ scheduler, interrupts };
+    GBcc::APU apu{ scheduler };
+
+    size_t Save(u8* buffer, const size_t size) const
+    {
+        GBcc::StateWriter writer(buffer, size);
+        writer.Write(clock);
+        scheduler.SaveState(writer);
+        interrupts.SaveState(writer);
+        timer.SaveState(writer);
+        apu.SaveState(writer);
+        return writer.Overflowed() ? 0U : writer.Size();
+    }
+
+    void Load(const u8* buffer, const size_t size)
+    {
+        GBcc::StateReader reader(buffer, size);
+        clock = reader.Read<u64>();
+        scheduler.LoadState(reader);
+        interrupts.LoadState(reader);
+        timer.LoadState(reader);
+        apu.LoadState(reader);
+        ExpectFalse(reader.Overflowed());
+    }
+
+    // Runs the timer and its scheduled overflows, and polls NR52 so length
+    // counters are caught up
+    void Run(const u64 cycles)
+    {
+        const u64 end = clock + cycles;
+        GBcc::SchedulerEvent event;
+        u64 timestamp;
+
+        while (clock < end)
+        {
+            clock = std::min(end, scheduler.NextDeadline());
+            while (scheduler.PopDue(event, timestamp))
+            {
+                timer.HandleOverflowEvent();
+            }
+        }
+    }
+
+    std::array<u8, 4> Observe()
+    {
+        return {
+            timer.ReadRegister(GBcc::GB_REG_TIMA),
+            timer.ReadRegister(GBcc::GB_REG_DIV),
+            interrupts.ReadFlags(),
+            apu.ReadRegister(GBcc::GB_REG_NR52)
+        };
+    }
+};
+
+// Counting and overflow of the writer, the reader never reads past the end
+static void WriterTest()
+{
+    GBcc::StateWriter counter(nullptr, 0U);
+    counter.Write(u8(1));
+    counter.Write(u16(2));
+    counter.WriteZeros(5U);
+    Expect(size_t(8), counter.Size());
+    ExpectTrue(counter.Overflowed());
+
+    std::array<u8, 3> buffer = { 0xAA, 0xAA, 0xAA };
+    GBcc::StateWriter writer(buffer.data(), buffer.size());
+    writer.Write(u16(0x1234));
+    writer.Write(u16(0x5678));
+    ExpectTrue(writer.Overflowed());
+    Expect(u8(0xAA), buffer[2]);
+
+    GBcc::StateReader reader(buffer.data(), buffer.size());
+    Expect(u16(0x1234), reader.Read<u16>());
+    Expect(u16(0), reader.Read<u16>());
+    ExpectTrue(reader.Overflowed());
+}
+
+// A machine loaded from a state must follow exactly the path it took after
+// the state was saved
+static void RoundTripTest()
+{
+    static Machine machine;
+    machine.interrupts.WriteEnable(GBcc::GB_INTERRUPT_TIMER);
+    machine.timer.WriteRegister(GBcc::GB_REG_TMA, 0xC0U);
+    machine.timer.WriteRegister(GBcc::GB_REG_TAC, 0x05U);
+    machine.apu.WriteRegister(GBcc::GB_REG_NR21, 0x3CU);
+    machine.apu.WriteRegister(GBcc::GB_REG_NR22, 0xF0U);
+    machine.apu.WriteRegister(GBcc::GB_REG_NR24, 0xC7U);
+    machine.Run(12345U);
+
+    std::vector<u8> state(4096U);
+    const size_t size = machine.Save(state.data(), state.size());
+    ExpectTrue(size > 0U);
+    Expect(size_t(0), machine.Save(state.data(), size - 1U));
+
+    std::vector<std::array<u8, 4>> expected;
+    for (size_t i = 0; i < 64U; i++)
+    {
+        machine.Run(777U);
+        expected.push_back(machine.Observe());
+    }
+
+    std::vector<u8> after(size);
+    machine.Save(after.data(), after.size());
+
+    machine.Load(state.data(), size);
+    for (size_t i = 0; i < 64U; i++)
+    {
+        machine.Run(777U);
+        Expect(expected[i], machine.Observe());
+    }
+
+    // Same history, same bytes
+    std::vector<u8> again(size);
+    machine.Save(again.data(), again.size());
+    Expect(after, again);
+}
+
+// A state that fails validation anywhere must leave the whole machine as it
+// was, including the components that come before the bad field
+static void CorruptStateTest()
+{
+    static GBcc::System system;
+    const std::vector<u8> rom(32U * 1024U, 0x00U);
+    ExpectTrue(system.LoadRom(rom.data(), rom.size()));
+    system.RunFrame();
+
+    std::vector<u8> state(system.GetStateSize());
+    Expect(state.size(), system.SaveState(state.data(), state.size()));
+
+    // Header, then the CPU registers, SP, PC and cycle count
+    const size_t scheduler = 10U + 20U;
+    // The PPU ends with the raster log of 6 byte entries, renderer registers and lines, the
+    // framebuffer, two flags and the frame hash
+    const size_t logSize = state.size() - sizeof(u64) - 2U - std::tuple_size_v<GBcc::PPU::Framebuffer> - 
+        (GBcc::RASTER_REGISTER_COUNT + 2U) - GBcc::GB_RASTER_LOG_CAPACITY * 6U - sizeof(u16);
+
+    const auto expectRejected = [&](const size_t offset, const u8 value)
+    {
+        std::vector<u8> corrupt = state;
+        corrupt[offset] = value;
+
+        // Move on first so a partial load would show in the saved bytes
+        system.RunFrame();
+        std::vector<u8> before(state.size());
+        system.SaveState(before.data(), before.size());
+
+        ExpectFalse(system.LoadState(corrupt.data(), corrupt.size()));
+
+        std::vector<u8> after(state.size());
+        system.SaveState(after.data(), after.size());
+        Expect(before, after);
+    };
+
+    expectRejected(0U, 0x00U);
+    expectRejected(scheduler, 0xFFU);
+    expectRejected(scheduler + 1U + sizeof(u64), 0xFFU);
+    expectRejected(logSize + 1U, 0xFFU);
+
+    ExpectFalse(system.LoadState(state.data(), state.size() - 1U));
+    ExpectTrue(system.LoadState(state.data(), state.size()));
+}
+
+int main(int argc, char** argv)
+{
+    WriterTest();
+    RoundTripTest();
+    CorruptStateTest();
+    return 0;
+}
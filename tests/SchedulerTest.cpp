@@ -0,0 +1,52 @@
+#include "Core/Scheduler.hpp"
+#include "Types.hpp"
+
+#include "TestFunctions.hpp"
+
+using GBcc::u64;
+using GBcc::Scheduler;
+using GBcc::SchedulerEvent;
+
+int main(int argc, char** argv)
+{
+    u64 clock = 0;
+    Scheduler scheduler(clock);
+
+    Expect(UINT64_MAX, scheduler.NextDeadline());
+
+    scheduler.Schedule(SchedulerEvent::FRAME_END, 500U);
+    scheduler.Schedule(SchedulerEvent::PPU_MODE, 80U);
+    Expect(u64(80), scheduler.NextDeadline());
+
+    SchedulerEvent event;
+    u64 timestamp;
+
+    // Nothing is due before its timestamp
+    clock = 79U;
+    ExpectFalse(scheduler.PopDue(event, timestamp));
+
+    clock = 90U;
+    ExpectTrue(scheduler.PopDue(event, timestamp));
+    ExpectTrue(event == SchedulerEvent::PPU_MODE);
+    Expect(u64(80), timestamp);
+    ExpectFalse(scheduler.PopDue(event, timestamp));
+    Expect(u64(500), scheduler.NextDeadline());
+
+    // Rescheduling moves the existing entry instead of adding another
+    scheduler.Schedule(SchedulerEvent::PPU_MODE, 600U);
+    scheduler.Schedule(SchedulerEvent::PPU_MODE, 100U);
+    Expect(u64(100), scheduler.NextDeadline());
+    scheduler.Schedule(SchedulerEvent::PPU_MODE, 700U);
+    Expect(u64(500), scheduler.NextDeadline());
+
+    scheduler.Deschedule(SchedulerEvent::FRAME_END);
+    ExpectFalse(scheduler.IsScheduled(SchedulerEvent::FRAME_END));
+    Expect(u64(700), scheduler.NextDeadline());
+
+    clock = 1000U;
+    ExpectTrue(scheduler.PopDue(event, timestamp));
+    ExpectTrue(event == SchedulerEvent::PPU_MODE);
+    Expect(UINT64_MAX, scheduler.NextDeadline());
+
+    return 0;
+}
@@ -0,0 +1,62 @@
+#include "Core/PPU/SpriteIndex.hpp"
+#include "Types.hpp"
+
+#include "TestFunctions.hpp"
+
+#include <array>
+
+using GBcc::u8;
+
+int main(int argc, char** argv)
+{
+    GBcc::SpriteIndex index;
+    std::array<u8, GBcc::GB_OAM_SIZE> oam = { 0 };
+
+    // Eleven sprites on line 0, in descending X order
+    for (u8 entry = 0; entry < 11; entry++)
+    {
+        oam[entry * 4U + 0U] = 16U;
+        oam[entry * 4U + 1U] = 100U - entry;
+    }
+
+    index.OnOamTransfer(oam);
+
+    const auto& line = index.GetLine(0);
+    Expect(u8(10), line.count);
+    Expect(u8(9), line.entries[0]);
+    Expect(u8(0), line.entries[9]);
+
+    Expect(u8(10), index.GetLine(7).count);
+    Expect(u8(0), index.GetLine(8).count);
+
+    // Equal X keeps OAM order
+    index.OnOamWrite(4U * 3U + 1U, 50U);
+    index.OnOamWrite(4U * 5U + 1U, 50U);
+    const auto& tiedLine = index.GetLine(0);
+    Expect(u8(3), tiedLine.entries[0]);
+    Expect(u8(5), tiedLine.entries[1]);
+
+    index.SetSpriteHeight(16U);
+    Expect(u8(10), index.GetLine(15).count);
+    Expect(u8(0), index.GetLine(16).count);
+
+    // Moving a sprite off screen drops it from its lines
+    index.OnOamWrite(4U * 3U + 0U, 0U);
+    Expect(u8(5), index.GetLine(0).entries[0]);
+
+    // A transfer only rebuilds when a position differs, either way the lines
+    // follow the new OAM
+    index.SetSpriteHeight(8U);
+    index.OnOamTransfer(oam);
+    Expect(u8(10), index.GetLine(0).count);
+    Expect(u8(9), index.GetLine(0).entries[0]);
+
+    oam[9U * 4U + 0U] = 40U;
+    oam[12U * 4U + 0U] = 40U;
+    index.OnOamTransfer(oam);
+    Expect(u8(10), index.GetLine(0).count);
+    Expect(u8(10), index.GetLine(0).entries[0]);
+    Expect(u8(2), index.GetLine(24).count);
+
+    return 0;
+}
@@ -0,0 +1,101 @@
+#include "Emulator/ThreadPool.hpp"
+#include "Types.hpp"
+
+#include "TestFunctions.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+using GBcc::u32;
+
+// Every index runs exactly once, whatever the thread count
+static void CoverageTest()
+{
+    for (const size_t threads : {1U, 2U, 3U, 8U})
+    {
+        GBcc::ThreadPool pool(threads);
+        Expect(threads, pool.GetThreadCount());
+
+        for (const size_t count : {0U, 1U, 5U, 1000U})
+        {
+            std::vector<std::atomic<u32>> runs(count);
+            pool.ParallelFor(count, [&runs](const size_t i) { runs[i]++; });
+
+            for (const auto& run : runs)
+            {
+                Expect(u32(1U), run.load());
+            }
+        }
+    }
+}
+
+// One worker stuck on a slow task does not hold up the rest of its block
+static void StealTest()
+{
+    GBcc::ThreadPool pool(4U);
+    std::mutex mutex;
+    std::set<std::thread::id> threadsSeen;
+    std::vector<std::thread::id> ranOn(64U);
+
+    pool.ParallelFor(64U, [&](const size_t i)
+    {
+        if (i == 0U)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        }
+
+        std::lock_guard lock(mutex);
+        ranOn[i] = std::this_thread::get_id();
+        threadsSeen.insert(ranOn[i]);
+    });
+
+    // Block 0 is tasks 0 to 15, someone else picked up the ones after task 0
+    size_t stolen = 0U;
+    for (size_t i = 1; i < 16U; i++)
+    {
+        stolen += ranOn[i] != ranOn[0];
+    }
+    ExpectTrue(stolen > 0U);
+    ExpectTrue(threadsSeen.size() > 1U);
+}
+
+// Calls reuse the same workers, and back to back calls of different sizes
+// never run a task of one call on the other
+static void ReuseTest()
+{
+    GBcc::ThreadPool pool(4U);
+    std::mutex mutex;
+    std::set<std::thread::id> threadsSeen;
+
+    for (size_t call = 0; call < 200U; call++)
+    {
+        const size_t count = call % 7U;
+        std::vector<std::atomic<u32>> runs(count);
+
+        pool.ParallelFor(count, [&](const size_t i)
+        {
+            runs[i]++;
+            std::lock_guard lock(mutex);
+            threadsSeen.insert(std::this_thread::get_id());
+        });
+
+        for (const auto& run : runs)
+        {
+            Expect(u32(1U), run.load());
+        }
+    }
+
+    ExpectTrue(threadsSeen.size() <= 4U);
+}
+
+int main(int argc, char** argv)
+{
+    CoverageTest();
+    StealTest();
+    ReuseTest();
+    return 0;
+}
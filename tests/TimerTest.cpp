@@ -0,0 +1,56 @@
+#include "Core/Timer.hpp"
+#include "Core/Scheduler.hpp"
+#include "Core/InterruptController.hpp"
+#include "Types.hpp"
+
+#include "TestFunctions.hpp"
+
+using GBcc::u8;
+using GBcc::u64;
+
+int main(int argc, char** argv)
+{
+    u64 clock = 0;
+    GBcc::Scheduler scheduler(clock);
+    GBcc::InterruptController interrupts;
+    GBcc::Timer timer(scheduler, interrupts);
+
+    interrupts.WriteFlags(0x00U);
+
+    Expect(u8(0xAB), timer.ReadRegister(GBcc::GB_REG_DIV));
+    clock = 0x34U;
+    Expect(u8(0xAC), timer.ReadRegister(GBcc::GB_REG_DIV));
+
+    // 262144 Hz: one increment every 16 cycles from a cleared counter
+    timer.WriteRegister(GBcc::GB_REG_DIV, 0x00U);
+    timer.WriteRegister(GBcc::GB_REG_TAC, 0x05U);
+    clock += 16U * 10U;
+    Expect(u8(10), timer.ReadRegister(GBcc::GB_REG_TIMA));
+
+    // Overflow reloads TMA, requests the interrupt and is scheduled exactly
+    timer.WriteRegister(GBcc::GB_REG_TMA, 0xF0U);
+    timer.WriteRegister(GBcc::GB_REG_TIMA, 0xFEU);
+    Expect(clock + 32U, scheduler.NextDeadline());
+    clock += 32U;
+    timer.HandleOverflowEvent();
+    Expect(u8(0xF0), timer.ReadRegister(GBcc::GB_REG_TIMA));
+    Expect(u8(GBcc::GB_INTERRUPT_TIMER), u8(interrupts.ReadFlags() & 0x1FU));
+    Expect(clock + 16U * 16U, scheduler.NextDeadline());
+
+    // Resetting DIV while bit 3 is high is a falling edge
+    timer.WriteRegister(GBcc::GB_REG_TIMA, 0x00U);
+    clock += 8U;
+    timer.WriteRegister(GBcc::GB_REG_DIV, 0x00U);
+    Expect(u8(1), timer.ReadRegister(GBcc::GB_REG_TIMA));
+
+    // Disabling the timer while the selected bit is high is one as well
+    clock += 8U;
+    timer.WriteRegister(GBcc::GB_REG_TAC, 0x01U);
+    Expect(u8(2), timer.ReadRegister(GBcc::GB_REG_TIMA));
+    ExpectFalse(scheduler.IsScheduled(GBcc::SchedulerEvent::TIMER_OVERFLOW));
+
+    clock += 1000U;
+    Expect(u8(2), timer.ReadRegister(GBcc::GB_REG_TIMA));
+
+    return 0;
+}